@@ -0,0 +1,390 @@
+#!/usr/bin/env python
+
+# ----------------------------------------------------------------------
+#   Driver for the LIGGGHTS(R)-PUBLIC benchmark suite
+#
+#   run      runs the benchmark cases for all combinations of the given
+#            parameters and rank counts, writes timings to a JSON file
+#   compare  compares two JSON files and flags performance regressions
+#   drift    compares the final thermo output of two JSON files, e.g. of
+#            a double and a single precision contact history build
+#   list     lists the available cases and their parameters
+#
+#   See the README file in this directory.
+# -------------------------------------------------------------------------
+
+import sys,os,re,json,time,math,socket,argparse,itertools,subprocess
+
+BENCHDIR = os.path.dirname(os.path.abspath(__file__))
+TOPDIR = os.path.dirname(BENCHDIR)
+
+# ----------------------------------------------------------------------
+# mesh generators, write ASCII STL files so that mesh resolution can be
+# varied without shipping meshes for every resolution
+
+def write_stl(fname,tris):
+  f = open(fname,"w")
+  f.write("solid bench\n")
+  for t in tris:
+    a = [t[1][i]-t[0][i] for i in range(3)]
+    b = [t[2][i]-t[0][i] for i in range(3)]
+    n = [a[1]*b[2]-a[2]*b[1],a[2]*b[0]-a[0]*b[2],a[0]*b[1]-a[1]*b[0]]
+    l = math.sqrt(n[0]*n[0]+n[1]*n[1]+n[2]*n[2])
+    f.write("  facet normal %g %g %g\n    outer loop\n" % tuple([c/l for c in n]))
+    for p in t: f.write("      vertex %.10g %.10g %.10g\n" % tuple(p))
+    f.write("    endloop\n  endfacet\n")
+  f.write("endsolid bench\n")
+  f.close()
+
+# rectangle (0 0 0) to (lx ly 0), nx x ny cells of two triangles each
+
+def mesh_plane(fname,lx,ly,nx,ny):
+  tris = []
+  for i in range(nx):
+    for j in range(ny):
+      x0,x1 = lx*i/nx,lx*(i+1)/nx
+      y0,y1 = ly*j/ny,ly*(j+1)/ny
+      tris.append(((x0,y0,0.),(x1,y0,0.),(x1,y1,0.)))
+      tris.append(((x0,y0,0.),(x1,y1,0.),(x0,y1,0.)))
+  write_stl(fname,tris)
+  return len(tris)
+
+# cylinder shell of radius 1 around the y-axis from y = 0 to y = 1,
+# nseg segments around the circumference and nlen along the axis
+
+def mesh_drum(fname,nseg,nlen):
+  tris = []
+  for i in range(nseg):
+    p0,p1 = 2.*math.pi*i/nseg,2.*math.pi*(i+1)/nseg
+    for j in range(nlen):
+      y0,y1 = float(j)/nlen,float(j+1)/nlen
+      a = (math.cos(p0),y0,math.sin(p0))
+      b = (math.cos(p1),y0,math.sin(p1))
+      c = (math.cos(p1),y1,math.sin(p1))
+      d = (math.cos(p0),y1,math.sin(p0))
+      tris.append((a,b,c))
+      tris.append((a,c,d))
+  write_stl(fname,tris)
+  return len(tris)
+
+def setup_chute(p,workdir):
+  L,W,res = float(p["L"]),float(p["W"]),int(p["res"])
+  fname = os.path.join(workdir,"chute_%d.stl" % res)
+  mesh_plane(fname,L,W,max(1,int(round(res*L/W))),res)
+  return {"meshfile": fname}
+
+def setup_drum(p,workdir):
+  res = int(p["res"])
+  fname = os.path.join(workdir,"drum_%d.stl" % res)
+  mesh_drum(fname,res,max(1,res//4))
+  return {"meshfile": fname}
+
+def setup_face(p,workdir):
+  fname = os.path.join(workdir,"face.stl")
+  mesh_plane(fname,1.,1.,1,1)
+  return {"meshfile": fname}
+
+def setup_multisphere(p,workdir):
+  fname = os.path.join(TOPDIR,"examples","LIGGGHTS","Tutorials_public",
+                       "multisphere_stone_restitution","data","stone1.multisphere")
+  return {"template": fname}
+
+# ----------------------------------------------------------------------
+# benchmark cases
+# params = default value(s) of the parameters passed to the input script
+# setup = optional function returning additional input script variables,
+#         it may use driver-only parameters such as mesh resolution
+# default = case is run if no cases are selected explicitly
+
+CASES = {
+  "packing":       {"input": "in.packing",
+                    "params": {"N": ["20000"], "ratio": ["1.6"]},
+                    "default": True},
+  "chute":         {"input": "in.chute",
+                    "params": {"N": ["10000"], "ratio": ["1.6"], "res": ["20"],
+                               "L": ["0.4"], "W": ["0.1"]},
+                    "setup": setup_chute, "driver_params": ["res"],
+                    "default": True},
+  "drum":          {"input": "in.drum",
+                    "params": {"N": ["10000"], "res": ["64"]},
+                    "setup": setup_drum, "driver_params": ["res"],
+                    "default": True},
+  "heat":          {"input": "in.heat",
+                    "params": {"N": ["20000"]},
+                    "default": True},
+  "multisphere":   {"input": "in.multisphere",
+                    "params": {"N": ["500"]},
+                    "setup": setup_multisphere,
+                    "default": True},
+  "sph":           {"input": "in.sph",
+                    "params": {"N": ["20000"], "kernel": ["cubicspline"]},
+                    "default": True},
+  "insert_stream": {"input": "in.insert_stream",
+                    "params": {"rate": ["100000"]},
+                    "setup": setup_face,
+                    "default": True},
+  "subcycle":      {"input": "in.subcycle",
+                    "params": {"N": ["1500"], "nsub": ["40"], "sub": ["1"]},
+                    "default": True},
+  "superquadric":  {"input": "in.superquadric",
+                    "params": {"N": ["5000"], "blockiness": ["4."], "aspect": ["2."]},
+                    "default": False},
+}
+
+# ----------------------------------------------------------------------
+# parse the timing summary of the last run in a log file
+
+def parse_log(fname):
+  lines = open(fname).read().splitlines()
+  iloop = -1
+  for i,line in enumerate(lines):
+    if line.startswith("Loop time of"): iloop = i
+  if iloop < 0: return None
+
+  m = re.match(r"Loop time of (\S+) on (\d+) procs.* for (\d+) steps with (\d+) atoms",
+               lines[iloop])
+  if not m: return None
+  res = {"loop_time": float(m.group(1)), "procs": int(m.group(2)),
+         "steps": int(m.group(3)), "atoms": int(m.group(4)),
+         "timer": {}, "timer_percent": {}}
+
+  timer = re.compile(r"^\s*(.*\S)\s+time \(%\) = (\S+) \((\S+)\)")
+  for line in lines[iloop+1:]:
+    if line.startswith("Nlocal:"): break
+    m = timer.match(line)
+    if m:
+      res["timer"][m.group(1)] = float(m.group(2))
+      res["timer_percent"][m.group(1)] = float(m.group(3))
+
+  # final thermo output of the run, the last numeric line before the loop time
+
+  res["thermo"] = {}
+  for i in range(iloop-1,-1,-1):
+    if lines[i].split()[:1] == ["Step"]:
+      cols = lines[i].split()
+      for line in lines[i+1:iloop]:
+        vals = line.split()
+        if len(vals) != len(cols): continue
+        try: res["thermo"] = dict(zip(cols,[float(v) for v in vals]))
+        except ValueError: pass
+      break
+
+  t = res["loop_time"]
+  if t > 0.:
+    res["timesteps_per_s"] = res["steps"]/t
+    res["particle_steps_per_s"] = res["steps"]*float(res["atoms"])/t
+  else:
+    res["timesteps_per_s"] = res["particle_steps_per_s"] = 0.
+  return res
+
+# ----------------------------------------------------------------------
+
+def result_key(case,params,np):
+  return "%s %s np=%d" % (case," ".join(["%s=%s" % (k,params[k])
+                                         for k in sorted(params)]),np)
+
+def git_commit():
+  try:
+    out = subprocess.check_output(["git","-C",TOPDIR,"rev-parse","HEAD"],
+                                  stderr=subprocess.STDOUT)
+    return out.decode().strip()
+  except Exception:
+    return None
+
+def run(args):
+  selected = args.cases.split(",") if args.cases else \
+             [c for c in sorted(CASES) if CASES[c]["default"]]
+  for c in selected:
+    if c not in CASES: sys.exit("Unknown case %s, see 'run_bench.py list'" % c)
+
+  overrides = {}
+  for s in args.set or []:
+    if "=" not in s: sys.exit("Illegal --set %s, use name=value1,value2,..." % s)
+    name,values = s.split("=",1)
+    overrides[name] = values.split(",")
+
+  nps = [int(n) for n in args.np.split(",")]
+  lmp = os.path.abspath(args.lmp)
+  workdir = os.path.abspath(args.workdir)
+  if not os.path.isdir(workdir): os.makedirs(workdir)
+
+  data = {"meta": {"date": time.strftime("%Y-%m-%d %H:%M:%S"),
+                   "host": socket.gethostname(), "lmp": lmp,
+                   "commit": git_commit(), "nwarm": args.nwarm,
+                   "nsteps": args.nsteps, "repeat": args.repeat},
+          "results": []}
+
+  for case in selected:
+    c = CASES[case]
+    names = sorted(c["params"])
+    grid = [overrides.get(n,c["params"][n]) for n in names]
+
+    for values in itertools.product(*grid):
+      params = dict(zip(names,values))
+      variables = dict((k,v) for k,v in params.items()
+                       if k not in c.get("driver_params",[]))
+      if "setup" in c: variables.update(c["setup"](params,workdir))
+      variables["nwarm"] = str(args.nwarm)
+      variables["nsteps"] = str(args.nsteps)
+
+      for np in nps:
+        key = result_key(case,params,np)
+        best = None
+        times = []
+        for irep in range(args.repeat):
+          log = os.path.join(workdir,"log.%s.%d" % (re.sub(r"[ =]","_",key),irep))
+          cmd = (args.mpirun % {"np": np}).split() if np > 1 or args.mpirun_always \
+                else []
+          cmd += [lmp,"-in",os.path.join(BENCHDIR,c["input"]),
+                  "-log",log,"-echo","none"]
+          for k in sorted(variables): cmd += ["-var",k,variables[k]]
+          sys.stdout.write("%s (%d/%d) ... " % (key,irep+1,args.repeat))
+          sys.stdout.flush()
+          screen = open(log+".screen","w")
+          status = subprocess.call(cmd,cwd=workdir,stdout=screen,stderr=subprocess.STDOUT)
+          screen.close()
+          res = parse_log(log) if os.path.isfile(log) else None
+          if status or res is None:
+            print("failed, see %s.screen" % log)
+            continue
+          print("%.3f s, %.4g timesteps/s" % (res["loop_time"],res["timesteps_per_s"]))
+          times.append(res["loop_time"])
+          if best is None or res["loop_time"] < best["loop_time"]: best = res
+
+        if best is None: continue
+        best.update({"key": key, "case": case, "params": params, "np": np,
+                     "loop_times": times})
+        data["results"].append(best)
+
+  f = open(args.out,"w")
+  json.dump(data,f,indent=2,sort_keys=True)
+  f.close()
+  print("Wrote %d results to %s" % (len(data["results"]),args.out))
+
+# ----------------------------------------------------------------------
+
+def compare(args):
+  base = json.load(open(args.base))
+  new = json.load(open(args.new))
+  bres = dict((r["key"],r) for r in base["results"])
+
+  nreg = 0
+  print("%-50s %14s %14s %8s" % ("case","base [ts/s]","new [ts/s]","change"))
+  for r in new["results"]:
+    b = bres.get(r["key"])
+    if b is None:
+      print("%-50s %14s %14.4g %8s" % (r["key"],"-",r["timesteps_per_s"],"new"))
+      continue
+    change = r["timesteps_per_s"]/b["timesteps_per_s"]-1. \
+             if b["timesteps_per_s"] > 0. else 0.
+    flag = ""
+    if change < -args.tolerance:
+      flag = "  REGRESSION"
+      nreg += 1
+    print("%-50s %14.4g %14.4g %+7.1f%%%s" % (r["key"],b["timesteps_per_s"],
+                                             r["timesteps_per_s"],100.*change,flag))
+
+    # show which part of the time step got slower
+
+    if flag or args.verbose:
+      steps = float(r["steps"])
+      bsteps = float(b["steps"])
+      for t in sorted(set(r["timer"]) | set(b["timer"])):
+        tb = b["timer"].get(t,0.)/bsteps
+        tn = r["timer"].get(t,0.)/steps
+        if tb > 0.: print("    %-20s %12.4g %12.4g s/step %+7.1f%%" % (t,tb,tn,100.*(tn/tb-1.)))
+        else: print("    %-20s %12.4g %12.4g s/step" % (t,tb,tn))
+
+  for k in sorted(bres):
+    if k not in [r["key"] for r in new["results"]]:
+      print("%-50s missing in %s" % (k,args.new))
+
+  if nreg:
+    print("%d regression(s) beyond %.1f%%" % (nreg,100.*args.tolerance))
+    sys.exit(1)
+  print("No regressions beyond %.1f%%" % (100.*args.tolerance))
+
+# ----------------------------------------------------------------------
+
+def drift(args):
+  base = json.load(open(args.base))
+  new = json.load(open(args.new))
+  bres = dict((r["key"],r) for r in base["results"])
+
+  nflag = 0
+  print("%-50s %-8s %14s %14s %10s" % ("case","column","base","new","rel. diff"))
+  for r in new["results"]:
+    b = bres.get(r["key"])
+    if b is None or "thermo" not in b or "thermo" not in r: continue
+    for col in sorted(set(b["thermo"]) & set(r["thermo"])):
+      if col == "Step": continue
+      vb,vn = b["thermo"][col],r["thermo"][col]
+      diff = abs(vn-vb)/abs(vb) if vb != 0. else abs(vn)
+      flag = ""
+      if diff > args.tolerance:
+        flag = "  DRIFT"
+        nflag += 1
+      print("%-50s %-8s %14.8g %14.8g %10.3g%s" % (r["key"],col,vb,vn,diff,flag))
+
+  if nflag:
+    print("%d value(s) drifted beyond %g" % (nflag,args.tolerance))
+    sys.exit(1)
+  print("No drift beyond %g" % args.tolerance)
+
+# ----------------------------------------------------------------------
+
+def list_cases(args):
+  for case in sorted(CASES):
+    c = CASES[case]
+    params = ", ".join(["%s=%s" % (k,",".join(v)) for k,v in sorted(c["params"].items())])
+    print("%-15s %-18s %s%s" % (case,c["input"],params,
+                                "" if c["default"] else "  (not run by default)"))
+
+# ----------------------------------------------------------------------
+
+def main():
+  parser = argparse.ArgumentParser(description="LIGGGHTS benchmark suite")
+  sub = parser.add_subparsers(dest="command")
+
+  p = sub.add_parser("run",help="run benchmarks and write timings to JSON")
+  p.add_argument("--lmp",default=os.path.join(TOPDIR,"src","lmp_auto"),
+                 help="LIGGGHTS executable")
+  p.add_argument("--cases",help="comma-separated list of cases, default all default cases")
+  p.add_argument("--set",action="append",metavar="NAME=V1,V2,...",
+                 help="parameter values to scan, may be given multiple times")
+  p.add_argument("--np",default="1",help="comma-separated list of MPI rank counts")
+  p.add_argument("--mpirun",default="mpirun -np %(np)d",
+                 help="MPI launcher, %%(np)d is replaced by the rank count")
+  p.add_argument("--mpirun-always",action="store_true",
+                 help="use the MPI launcher also for runs on 1 rank")
+  p.add_argument("--nwarm",type=int,default=1000,help="untimed steps before the timed run")
+  p.add_argument("--nsteps",type=int,default=5000,help="steps of the timed run")
+  p.add_argument("--repeat",type=int,default=1,help="repetitions, the fastest one is kept")
+  p.add_argument("--workdir",default="bench_work",help="directory for logs and meshes")
+  p.add_argument("--out",default="bench.json",help="JSON output file")
+
+  p = sub.add_parser("compare",help="compare two JSON files")
+  p.add_argument("base")
+  p.add_argument("new")
+  p.add_argument("--tolerance",type=float,default=0.05,
+                 help="relative slow-down in timesteps/s flagged as regression")
+  p.add_argument("-v","--verbose",action="store_true",
+                 help="show timer breakdown for all cases")
+
+  p = sub.add_parser("drift",help="compare final thermo output of two JSON files")
+  p.add_argument("base")
+  p.add_argument("new")
+  p.add_argument("--tolerance",type=float,default=0.01,
+                 help="relative difference of a thermo value flagged as drift")
+
+  sub.add_parser("list",help="list cases and default parameters")
+
+  args = parser.parse_args()
+  if args.command == "run": run(args)
+  elif args.command == "compare": compare(args)
+  elif args.command == "drift": drift(args)
+  elif args.command == "list": list_cases(args)
+  else: parser.print_help()
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,83 @@
+#!/bin/sh
+# test of fix couple/cfd ... shm against the stand-in solver shm_solver.c
+#
+# usage: ./run_test.sh [nprocs]
+#
+# environment: LMP     LIGGGHTS executable (default ../../../../src/lmp_auto)
+#              MPIRUN  MPI launcher (default mpirun)
+#              CC      C compiler for the solver (default cc)
+#
+# runs the coupling with POSIX shared memory and with a memory mapped
+# file in a subdirectory, and compares the dragforce LIGGGHTS received
+# to the one the solver sent after every coupling step
+
+cd "$(dirname "$0")" || exit 1
+
+NP=${1:-2}
+LMP=${LMP:-../../../../src/lmp_auto}
+MPIRUN=${MPIRUN:-mpirun}
+CC=${CC:-cc}
+
+$CC -O2 -I../../../../src -o shm_solver shm_solver.c -lpthread -lrt || exit 1
+
+status=0
+
+run_case()
+{
+    mode=$1
+    name=$2
+    file=no
+    solverarg=
+    if [ "$mode" = file ]; then
+        file=yes
+        solverarg=file
+    fi
+
+    ./shm_solver $name $NP $solverarg > log.solver.$mode 2>&1 &
+    solver=$!
+    $MPIRUN -np $NP $LMP -in in.couple_cfd_shm -log log.liggghts.$mode \
+        -var name $name -var file $file > /dev/null 2>&1
+    lmpstatus=$?
+    wait $solver
+    solverstatus=$?
+
+    if [ $lmpstatus -ne 0 ] || [ $solverstatus -ne 0 ]; then
+        echo "$mode: FAILED (liggghts exit $lmpstatus, solver exit $solverstatus)"
+        status=1
+        return
+    fi
+
+    # thermo lines "step atoms c_df" vs. solver lines of the same step
+
+    awk '
+        FNR == 1 { nfile++ }
+        nfile == 1 && $1 == "solver:" && $2 == "step" { sent[$3] = $7; atoms[$3] = $5; next }
+        nfile == 2 && NF == 3 && $1 ~ /^[0-9]+$/ && ($1 in sent) {
+            d = $3 - sent[$1]; if (d < 0) d = -d
+            s = sent[$1]; if (s < 0) s = -s
+            if ($2 != atoms[$1] || d > 1e-9*s + 1e-20) {
+                printf("step %s: liggghts %s atoms dragforce %s, solver %s atoms dragforce %s\n",
+                       $1,$2,$3,atoms[$1],sent[$1])
+                bad++
+            }
+            checked++
+        }
+        END {
+            if (checked == 0) { print "no coupling steps found"; exit 1 }
+            printf("%d coupling steps compared\n",checked)
+            exit bad > 0
+        }' log.solver.$mode log.liggghts.$mode
+    if [ $? -eq 0 ]; then
+        echo "$mode: PASSED"
+    else
+        echo "$mode: FAILED"
+        status=1
+    fi
+}
+
+mkdir -p segments
+run_case shm shmtest$$
+run_case file "$(pwd)/segments/shmtest$$"
+rmdir segments 2>/dev/null
+
+exit $status
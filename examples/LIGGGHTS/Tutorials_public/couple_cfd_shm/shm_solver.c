@@ -0,0 +1,211 @@
+/* ----------------------------------------------------------------------
+   stand-in for a CFD solver coupled via fix couple/cfd ... shm
+
+   usage: shm_solver name nprocs [file]
+
+   attaches to the segments of all nprocs LIGGGHTS processes and answers
+   every coupling step with dragforce records keyed by particle ID:
+     - records are written in reverse order of the push data
+     - in coupling step c, particles with (id+c) % 3 == 0 get no record
+       and keep the value of the previous step
+     - the z component is 1e-9*id*c, x and y are 0
+   all other pull properties are set to 0 for the particles with record
+
+   after every step, the sum of the z components that LIGGGHTS must hold
+   is printed as "solver: step <step> atoms <n> dragforce <sum>", which
+   run_test.sh compares to the thermo output of c_df
+------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <semaphore.h>
+#include "cfd_datacoupling_shm_layout.h"
+
+#define WAIT_ATTACH 60.    // seconds to wait for LIGGGHTS to create a segment
+
+typedef struct Rank {
+  int fd;
+  sem_t *push,*pull;
+} Rank;
+
+static void die(const char *msg, const char *name)
+{
+  fprintf(stderr,"shm_solver: %s %s: %s\n",msg,name,strerror(errno));
+  exit(1);
+}
+
+static void sleep_ms(int ms)
+{
+  struct timespec ts;
+  ts.tv_sec = ms/1000;
+  ts.tv_nsec = (ms%1000)*1000000L;
+  nanosleep(&ts,NULL);
+}
+
+/* same naming rule as CfdDatacouplingShm::sem_names() */
+
+static void attach(Rank *r, const char *name, int rank, int use_file)
+{
+  char seg[PATH_MAX],key[PATH_MAX],sem[PATH_MAX+8];
+  int i;
+
+  snprintf(seg,sizeof(seg),"%s%s.%d",use_file ? "" : "/",name,rank);
+
+  for(i = 0; i < 100*WAIT_ATTACH; i++)
+  {
+    r->fd = use_file ? open(seg,O_RDWR) : shm_open(seg,O_RDWR,0);
+    if(r->fd >= 0) break;
+    sleep_ms(10);
+  }
+  if(r->fd < 0) die("could not open segment",seg);
+
+  if(use_file)
+  {
+    char *c;
+    if(!realpath(seg,key)) die("could not resolve",seg);
+    for(c = key; *c; c++)
+      if(*c == '/') *c = '_';
+  }
+  else strcpy(key,seg+1);
+
+  r->push = r->pull = SEM_FAILED;
+  for(i = 0; i < 100*WAIT_ATTACH && (r->push == SEM_FAILED || r->pull == SEM_FAILED); i++)
+  {
+    if(r->push == SEM_FAILED)
+    {
+      snprintf(sem,sizeof(sem),"/%s.push",key);
+      r->push = sem_open(sem,0);
+    }
+    if(r->pull == SEM_FAILED)
+    {
+      snprintf(sem,sizeof(sem),"/%s.pull",key);
+      r->pull = sem_open(sem,0);
+    }
+    if(r->push == SEM_FAILED || r->pull == SEM_FAILED) sleep_ms(10);
+  }
+  if(r->push == SEM_FAILED || r->pull == SEM_FAILED) die("could not open semaphores of",seg);
+}
+
+int main(int narg, char **arg)
+{
+  Rank *ranks;
+  double *fz = NULL;          // dragforce z component LIGGGHTS holds per ID
+  int nfz = 0,nprocs,use_file,iproc,c;
+
+  if(narg < 3)
+  {
+    fprintf(stderr,"usage: shm_solver name nprocs [file]\n");
+    return 1;
+  }
+  nprocs = atoi(arg[2]);
+  use_file = narg > 3 && strcmp(arg[3],"file") == 0;
+
+  ranks = (Rank*) calloc(nprocs,sizeof(Rank));
+  for(iproc = 0; iproc < nprocs; iproc++)
+    attach(&ranks[iproc],arg[1],iproc,use_file);
+
+  for(c = 1; ; c++)
+  {
+    long long ntimestep = -1;
+    double sum = 0.;
+    int natoms = 0,ndone = 0;
+
+    for(iproc = 0; iproc < nprocs; iproc++)
+    {
+      Rank *r = &ranks[iproc];
+      CfdShmHeader *h;
+      struct stat st;
+      char *seg;
+      int *push_id,*pull_id;
+      int ifield,k,n,npull;
+
+      while(sem_wait(r->push) != 0)
+        if(errno != EINTR) die("waiting for","push");
+
+      // the segment may have been re-laid out, map it anew every step
+
+      if(fstat(r->fd,&st) != 0) die("could not stat","segment");
+      seg = (char*) mmap(NULL,st.st_size,PROT_READ | PROT_WRITE,MAP_SHARED,r->fd,0);
+      if(seg == MAP_FAILED) die("could not map","segment");
+      h = (CfdShmHeader*) seg;
+
+      if(h->magic != CFD_SHM_MAGIC || h->version != CFD_SHM_VERSION || h->size > st.st_size)
+      {
+        fprintf(stderr,"shm_solver: invalid segment header\n");
+        return 1;
+      }
+      if(h->done)
+      {
+        munmap(seg,st.st_size);
+        ndone++;
+        continue;
+      }
+
+      ntimestep = h->ntimestep;
+      n = h->npush;
+      push_id = (int*) (seg + h->offset_push_id);
+      pull_id = (int*) (seg + h->offset_pull_id);
+
+      npull = 0;
+      for(k = n-1; k >= 0; k--)
+      {
+        const int id = push_id[k];
+
+        if(id >= nfz)
+        {
+          const int nnew = 2*id+1;
+          fz = (double*) realloc(fz,nnew*sizeof(double));
+          memset(fz+nfz,0,(nnew-nfz)*sizeof(double));
+          nfz = nnew;
+        }
+
+        if((id+c) % 3)
+        {
+          fz[id] = 1e-9*id*c;
+          pull_id[npull] = id;
+          for(ifield = 0; ifield < h->nfields; ifield++)
+          {
+            CfdShmField *f = &h->fields[ifield];
+            double *data = (double*) (seg + f->offset);
+            int j;
+
+            if(f->direction != CFD_SHM_PULL || !f->peratom) continue;
+            for(j = 0; j < f->len2; j++)
+              data[npull*f->len2+j] = 0.;
+            if(strcmp(f->name,"dragforce") == 0)
+              data[npull*f->len2+2] = fz[id];
+          }
+          npull++;
+        }
+        sum += fz[id];
+      }
+      natoms += n;
+      h->npull = npull;
+
+      munmap(seg,st.st_size);
+      sem_post(r->pull);
+    }
+
+    if(ndone == nprocs) break;
+    if(ndone)
+    {
+      fprintf(stderr,"shm_solver: only %d of %d processes finished\n",ndone,nprocs);
+      return 1;
+    }
+    printf("solver: step %lld atoms %d dragforce %.12e\n",ntimestep,natoms,sum);
+    fflush(stdout);
+  }
+
+  printf("solver: done after %d coupling steps\n",c-1);
+  free(fz);
+  free(ranks);
+  return 0;
+}
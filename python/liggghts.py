@@ -16,6 +16,14 @@
 import sys,traceback,types
 from ctypes import *
 
+# NumPy is optional, it is only needed for the zero-copy local data access
+
+try:
+  import numpy
+  from numpy.ctypeslib import as_array
+except ImportError:
+  numpy = None
+
 class liggghts:
   def __init__(self,name="",cmdargs=None):
     
@@ -187,3 +195,77 @@ class liggghts:
     if self.pyVersion[0] == 3:
       name = name.encode()
     self.lib.lammps_scatter_atoms(self.lmp,name,type,count,data)
+
+  # return number of atoms owned by this proc
+
+  def get_nlocal(self):
+    return self.lib.lammps_get_nlocal(self.lmp)
+
+  # return NumPy view of per-atom or per-element data owned by this proc
+  # no data is copied, the view is invalid after the next run or
+  # re-neighboring, shape is (nrow,) for scalars, else (nrow,ncol)
+
+  def _local_view(self,func,*args):
+    if numpy is None:
+      raise ImportError("NumPy is required for local data access")
+    type = c_int()
+    nrow = c_int()
+    ncol = c_int()
+    func.restype = c_void_p
+    ptr = func(self.lmp,*(args + (byref(type),byref(nrow),byref(ncol))))
+    if type.value == 0: ctype = c_int
+    else: ctype = c_double
+    if ncol.value == 1: shape = (nrow.value,)
+    else: shape = (nrow.value,ncol.value)
+    # no owned atoms/elements gives an empty array, missing data gives None
+    if not ptr:
+      if ncol.value == 0 or nrow.value > 0: return None
+      return numpy.empty(shape,dtype=ctype)
+    return as_array(cast(ptr,POINTER(ctype)),shape=shape)
+
+  def _encode(self,*args):
+    if self.pyVersion[0] == 3: return tuple(a.encode() for a in args)
+    return args
+
+  # per-atom property, e.g. x, v, radius, see lammps_extract_atom_local()
+
+  def extract_atom_local(self,name):
+    return self._local_view(self.lib.lammps_extract_atom_local,
+                            *self._encode(name))
+
+  # per-atom data of a fix, e.g. fix property/atom
+
+  def extract_fix_local(self,f_id):
+    return self._local_view(self.lib.lammps_extract_fix_local,
+                            *self._encode(f_id))
+
+  # per-element data of a fix mesh, name = node or an element property
+
+  def extract_mesh_local(self,f_id,name):
+    return self._local_view(self.lib.lammps_extract_mesh_local,
+                            *self._encode(f_id,name))
+
+  # return vector of atom properties ordered by atom ID on proc 0 only
+  # returns None on all other procs
+  # result is a NumPy array of shape (natoms,count) if NumPy is available
+
+  def gather_atoms_root(self,name,type,count):
+    if self.pyVersion[0] == 3:
+      name = name.encode()
+    self.lib.lammps_extract_global.restype = POINTER(c_int)
+    me = self.lib.lammps_extract_global(self.lmp,"me".encode())[0]
+    natoms = self.lib.lammps_get_natoms(self.lmp)
+    if type == 0: ctype = c_int
+    elif type == 1: ctype = c_double
+    else: return None
+    if me != 0:
+      self.lib.lammps_gather_atoms_root(self.lmp,name,type,count,None)
+      return None
+    if numpy is not None:
+      data = numpy.zeros((natoms,count),dtype=ctype)
+      self.lib.lammps_gather_atoms_root(self.lmp,name,type,count,
+                                        data.ctypes.data_as(c_void_p))
+      return data
+    data = ((count*natoms)*ctype)()
+    self.lib.lammps_gather_atoms_root(self.lmp,name,type,count,data)
+    return data
@@ -120,6 +120,10 @@ namespace LAMMPS_NS
 
         virtual class CustomValueTracker& prop() = 0;
 
+        // read-only access to the contiguous node storage
+        inline const double* nodeData()
+        { return &(nodePtr()[0][0][0]); }
+
         /*
         virtual ContainerBase* container(double type,int lenVec) = 0;
         virtual ContainerBase* container(int type,int lenVec) = 0;
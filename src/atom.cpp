@@ -1747,6 +1747,10 @@ void *Atom::extract(const char *name,int &len)
   if (strcmp(name,"pressure") == 0) return (void *) p;  
   if (strcmp(name,"volume") == 0) return (void *) volume;
   if (strcmp(name,"area") == 0) return (void *) area;
+  if (strcmp(name,"molecule") == 0) return (void *) molecule;
+  if (strcmp(name,"q") == 0) return (void *) q;
+  if (strcmp(name,"vfrac") == 0) return (void *) vfrac;
+  if (strcmp(name,"s0") == 0) return (void *) s0;
 
   len = 2;
   if (strcmp(name,"blockiness") == 0) return (void *) blockiness; 
@@ -1755,16 +1759,11 @@ void *Atom::extract(const char *name,int &len)
   if (strcmp(name,"x") == 0) return (void *) x;
   if (strcmp(name,"v") == 0) return (void *) v;
   if (strcmp(name,"f") == 0) return (void *) f;
-  if (strcmp(name,"molecule") == 0) return (void *) molecule;
-  if (strcmp(name,"q") == 0) return (void *) q;
   if (strcmp(name,"mu") == 0) return (void *) mu;
   if (strcmp(name,"omega") == 0) return (void *) omega;
   if (strcmp(name,"amgmom") == 0) return (void *) angmom;
+  if (strcmp(name,"angmom") == 0) return (void *) angmom;
   if (strcmp(name,"torque") == 0) return (void *) torque;
-  if (strcmp(name,"radius") == 0) return (void *) radius;
-  if (strcmp(name,"rmass") == 0) return (void *) rmass;
-  if (strcmp(name,"vfrac") == 0) return (void *) vfrac;
-  if (strcmp(name,"s0") == 0) return (void *) s0;
 //
   if (strcmp(name, "Lwx") == 0) return (void*) Lwx;
   if (strcmp(name, "Lwx2") == 0) return (void*) Lwx2;
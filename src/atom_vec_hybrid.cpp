@@ -157,6 +157,15 @@ void AtomVecHybrid::init()
 {
   AtomVec::init();
   for (int k = 0; k < nstyles; k++) styles[k]->init();
+
+  // sub-style comm sizes may have changed in their init()
+
+  size_forward = 3;
+  size_border = 6;
+  for (int k = 0; k < nstyles; k++) {
+    size_forward += styles[k]->size_forward - 3;
+    size_border += styles[k]->size_border - 6;
+  }
 }
 
 /* ----------------------------------------------------------------------
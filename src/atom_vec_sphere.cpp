@@ -80,8 +80,7 @@ AtomVecSphere::AtomVecSphere(LAMMPS *lmp) : AtomVec(lmp)
   comm_f_only = 0;
   size_forward = 3;
   size_reverse = 6;
-//Lwx
-  size_border = 15; //9;12;
+  size_border = 9;      // Lwx, Lwx2 are only used for owned particles
   size_velocity = 6;
   size_data_atom = 13;  //7;10;
   size_data_vel = 7;
@@ -94,6 +93,7 @@ AtomVecSphere::AtomVecSphere(LAMMPS *lmp) : AtomVec(lmp)
   atom->Lwx_flag = 1;
   atom->Lwx2_flag = 1;
 //
+  radvary = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -259,14 +259,6 @@ int AtomVecSphere::pack_comm(int n, int *list, double *buf,
         buf[m++] = radius[j];
         buf[m++] = rmass[j];
         buf[m++] = density[j]; 
-//
-        buf[m++] = Lwx[j][0];
-        buf[m++] = Lwx[j][1];
-        buf[m++] = Lwx[j][2];
-        buf[m++] = Lwx2[j][0];
-        buf[m++] = Lwx2[j][1];
-        buf[m++] = Lwx2[j][2];
-//
       }
     } else {
       if (domain->triclinic == 0) {
@@ -287,14 +279,6 @@ int AtomVecSphere::pack_comm(int n, int *list, double *buf,
         buf[m++] = radius[j];
         buf[m++] = rmass[j];
         buf[m++] = density[j]; 
-//
-        buf[m++] = Lwx[j][0];
-        buf[m++] = Lwx[j][1];
-        buf[m++] = Lwx[j][2];
-        buf[m++] = Lwx2[j][0];
-        buf[m++] = Lwx2[j][1];
-        buf[m++] = Lwx2[j][2];
-//
       }
     }
   }
@@ -389,14 +373,6 @@ int AtomVecSphere::pack_comm_vel(int n, int *list, double *buf,
         buf[m++] = radius[j];
         buf[m++] = rmass[j];
         buf[m++] = density[j]; 
-//
-        buf[m++] = Lwx[j][0];
-        buf[m++] = Lwx[j][1];
-        buf[m++] = Lwx[j][2];
-        buf[m++] = Lwx2[j][0];
-        buf[m++] = Lwx2[j][1];
-        buf[m++] = Lwx2[j][2];
-//
         buf[m++] = v[j][0];
         buf[m++] = v[j][1];
         buf[m++] = v[j][2];
@@ -424,14 +400,6 @@ int AtomVecSphere::pack_comm_vel(int n, int *list, double *buf,
           buf[m++] = radius[j];
           buf[m++] = rmass[j];
           buf[m++] = density[j]; 
-//
-          buf[m++] = Lwx[j][0];
-          buf[m++] = Lwx[j][1];
-          buf[m++] = Lwx[j][2];
-          buf[m++] = Lwx2[j][0];
-          buf[m++] = Lwx2[j][1];
-          buf[m++] = Lwx2[j][2];
-//
           buf[m++] = v[j][0];
           buf[m++] = v[j][1];
           buf[m++] = v[j][2];
@@ -452,14 +420,6 @@ int AtomVecSphere::pack_comm_vel(int n, int *list, double *buf,
           buf[m++] = radius[j];
           buf[m++] = rmass[j];
           buf[m++] = density[j]; 
-//
-          buf[m++] = Lwx[j][0];
-          buf[m++] = Lwx[j][1];
-          buf[m++] = Lwx[j][2];
-          buf[m++] = Lwx2[j][0];
-          buf[m++] = Lwx2[j][1];
-          buf[m++] = Lwx2[j][2];
-//
           if (mask[i] & deform_groupbit) {
             buf[m++] = v[j][0] + dvx;
             buf[m++] = v[j][1] + dvy;
@@ -495,14 +455,6 @@ int AtomVecSphere::pack_comm_hybrid(int n, int *list, double *buf)
     buf[m++] = radius[j];
     buf[m++] = rmass[j];
     buf[m++] = density[j];
-//
-    buf[m++] = Lwx[j][0];
-    buf[m++] = Lwx[j][1];
-    buf[m++] = Lwx[j][2];
-    buf[m++] = Lwx2[j][0];
-    buf[m++] = Lwx2[j][1];
-    buf[m++] = Lwx2[j][2];
-//
   }
   return m;
 }
@@ -532,14 +484,6 @@ void AtomVecSphere::unpack_comm(int n, int first, double *buf)
       radius[i] = buf[m++];
       rmass[i] = buf[m++];
       density[i] = buf[m++]; 
-//
-      Lwx[i][0] = buf[m++];
-      Lwx[i][1] = buf[m++];
-      Lwx[i][2] = buf[m++];
-      Lwx2[i][0] = buf[m++];
-      Lwx2[i][1] = buf[m++];
-      Lwx2[i][2] = buf[m++];
-//
     }
   }
 }
@@ -576,14 +520,6 @@ void AtomVecSphere::unpack_comm_vel(int n, int first, double *buf)
       radius[i] = buf[m++];
       rmass[i] = buf[m++];
       density[i] = buf[m++]; 
-//
-      Lwx[i][0] = buf[m++];
-      Lwx[i][1] = buf[m++];
-      Lwx[i][2] = buf[m++];
-      Lwx2[i][0] = buf[m++];
-      Lwx2[i][1] = buf[m++];
-      Lwx2[i][2] = buf[m++];
-//
       v[i][0] = buf[m++];
       v[i][1] = buf[m++];
       v[i][2] = buf[m++];
@@ -609,14 +545,6 @@ int AtomVecSphere::unpack_comm_hybrid(int n, int first, double *buf)
     radius[i] = buf[m++];
     rmass[i] = buf[m++];
     density[i] = buf[m++]; 
-//
-    Lwx[i][0] = buf[m++];
-    Lwx[i][1] = buf[m++];
-    Lwx[i][2] = buf[m++];
-    Lwx2[i][0] = buf[m++];
-    Lwx2[i][1] = buf[m++];
-    Lwx2[i][2] = buf[m++];
-//
   }
   return m;
 }
@@ -712,14 +640,6 @@ int AtomVecSphere::pack_border(int n, int *list, double *buf,
       buf[m++] = radius[j];
       buf[m++] = rmass[j];
       buf[m++] = density[j]; 
-//
-      buf[m++] = Lwx[j][0];
-      buf[m++] = Lwx[j][1];
-      buf[m++] = Lwx[j][2];
-      buf[m++] = Lwx2[j][0];
-      buf[m++] = Lwx2[j][1];
-      buf[m++] = Lwx2[j][2];
-//
     }
   } else {
     if (domain->triclinic == 0) {
@@ -742,14 +662,6 @@ int AtomVecSphere::pack_border(int n, int *list, double *buf,
       buf[m++] = radius[j];
       buf[m++] = rmass[j];
       buf[m++] = density[j]; 
-//
-      buf[m++] = Lwx[j][0];
-      buf[m++] = Lwx[j][1];
-      buf[m++] = Lwx[j][2];
-      buf[m++] = Lwx2[j][0];
-      buf[m++] = Lwx2[j][1];
-      buf[m++] = Lwx2[j][2];
-//
     }
   }
 
@@ -784,14 +696,6 @@ int AtomVecSphere::pack_border_vel(int n, int *list, double *buf,
       buf[m++] = radius[j];
       buf[m++] = rmass[j];
       buf[m++] = density[j]; 
-//
-      buf[m++] = Lwx[j][0];
-      buf[m++] = Lwx[j][1];
-      buf[m++] = Lwx[j][2];
-      buf[m++] = Lwx2[j][0];
-      buf[m++] = Lwx2[j][1];
-      buf[m++] = Lwx2[j][2];
-//
       buf[m++] = v[j][0];
       buf[m++] = v[j][1];
       buf[m++] = v[j][2];
@@ -821,14 +725,6 @@ int AtomVecSphere::pack_border_vel(int n, int *list, double *buf,
         buf[m++] = radius[j];
         buf[m++] = rmass[j];
         buf[m++] = density[j]; 
-//
-        buf[m++] = Lwx[j][0];
-        buf[m++] = Lwx[j][1];
-        buf[m++] = Lwx[j][2];
-        buf[m++] = Lwx2[j][0];
-        buf[m++] = Lwx2[j][1];
-        buf[m++] = Lwx2[j][2];
-//
         buf[m++] = v[j][0];
         buf[m++] = v[j][1];
         buf[m++] = v[j][2];
@@ -851,14 +747,6 @@ int AtomVecSphere::pack_border_vel(int n, int *list, double *buf,
         buf[m++] = radius[j];
         buf[m++] = rmass[j];
         buf[m++] = density[j]; 
-//
-        buf[m++] = Lwx[j][0];
-        buf[m++] = Lwx[j][1];
-        buf[m++] = Lwx[j][2];
-        buf[m++] = Lwx2[j][0];
-        buf[m++] = Lwx2[j][1];
-        buf[m++] = Lwx2[j][2];
-//
         if (mask[i] & deform_groupbit) {
           buf[m++] = v[j][0] + dvx;
           buf[m++] = v[j][1] + dvy;
@@ -894,14 +782,6 @@ int AtomVecSphere::pack_border_hybrid(int n, int *list, double *buf)
     buf[m++] = radius[j];
     buf[m++] = rmass[j];
     buf[m++] = density[j]; 
-//
-    buf[m++] = Lwx[j][0];
-    buf[m++] = Lwx[j][1];
-    buf[m++] = Lwx[j][2];
-    buf[m++] = Lwx2[j][0];
-    buf[m++] = Lwx2[j][1];
-    buf[m++] = Lwx2[j][2];
-//
   }
   return m;
 }
@@ -925,14 +805,6 @@ void AtomVecSphere::unpack_border(int n, int first, double *buf)
     radius[i] = buf[m++];
     rmass[i] = buf[m++];
     density[i] = buf[m++]; 
-//
-    Lwx[i][0] = buf[m++];
-    Lwx[i][1] = buf[m++];
-    Lwx[i][2] = buf[m++];
-    Lwx2[i][0] = buf[m++];
-    Lwx2[i][1] = buf[m++];
-    Lwx2[i][2] = buf[m++];
-//
   }
 
   if (atom->nextra_border)
@@ -960,14 +832,6 @@ void AtomVecSphere::unpack_border_vel(int n, int first, double *buf)
     radius[i] = buf[m++];
     rmass[i] = buf[m++];
     density[i] = buf[m++]; 
-//
-    Lwx[i][0] = buf[m++];
-    Lwx[i][1] = buf[m++];
-    Lwx[i][2] = buf[m++];
-    Lwx2[i][0] = buf[m++];
-    Lwx2[i][1] = buf[m++];
-    Lwx2[i][2] = buf[m++];
-//
     v[i][0] = buf[m++];
     v[i][1] = buf[m++];
     v[i][2] = buf[m++];
@@ -994,14 +858,6 @@ int AtomVecSphere::unpack_border_hybrid(int n, int first, double *buf)
     radius[i] = buf[m++];
     rmass[i] = buf[m++];
     density[i] = buf[m++]; 
-//
-    Lwx[i][0] = buf[m++];
-    Lwx[i][1] = buf[m++];
-    Lwx[i][2] = buf[m++];
-    Lwx2[i][0] = buf[m++];
-    Lwx2[i][1] = buf[m++];
-    Lwx2[i][2] = buf[m++];
-//
   }
   return m;
 }
@@ -0,0 +1,631 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include "atom.h"
+#include "comm.h"
+#include "update.h"
+#include "error.h"
+#include "memory.h"
+#include "fix_cfd_coupling.h"
+#include "cfd_datacoupling_shm.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <unistd.h>
+#endif
+
+// sem_timedwait() is part of the POSIX timeouts option, which macOS lacks
+
+#if defined(_POSIX_TIMEOUTS) && _POSIX_TIMEOUTS > 0 && !defined(__APPLE__)
+#include <fcntl.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <semaphore.h>
+#define CFD_SHM_SUPPORTED
+#endif
+
+using namespace LAMMPS_NS;
+
+#define CAPACITY_MIN 1024
+#define CAPACITY_GROW 1.2
+
+// align byte offsets in the segment to doubles
+
+static inline long long align8(long long n)
+{ return (n + 7) & ~7LL; }
+
+// per-atom properties stored as int in LIGGGHTS, i.e. the int vectors
+// Atom::extract() returns, fix property/atom data is always double
+// all data in the segment is double
+
+static inline bool int_atom_property(const char *name)
+{
+    return strcmp(name,"id") == 0 || strcmp(name,"type") == 0 ||
+           strcmp(name,"mask") == 0 || strcmp(name,"image") == 0 ||
+           strcmp(name,"molecule") == 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+CfdDatacouplingShm::CfdDatacouplingShm(LAMMPS *lmp, int iarg,int narg, char **arg,FixCfdCoupling *fc)  :
+  CfdDatacoupling(lmp, iarg, narg, arg,fc),
+  name_(NULL),
+  segname_(NULL),
+  semname_push_(NULL),
+  semname_pull_(NULL),
+  use_file_(false),
+  timeout_(-1.),
+  fd_(-1),
+  seg_(NULL),
+  segsize_(0),
+  header_(NULL),
+  sem_push_(NULL),
+  sem_pull_(NULL)
+{
+    iarg_ = iarg;
+    int n_arg = narg - iarg_;
+
+    if(n_arg < 1) error->all(FLERR,"Cfd shm coupling: wrong # arguments");
+
+#ifndef CFD_SHM_SUPPORTED
+    error->all(FLERR,"Fix couple/cfd with shm coupling is not supported on this platform");
+#endif
+
+    liggghts_is_active = true;
+    this->fc_ = fc;
+
+    name_ = new char[strlen(arg[iarg_])+1];
+    strcpy(name_,arg[iarg_]);
+    iarg_++;
+
+    bool hasargs = true;
+    while (iarg_ < narg && hasargs)
+    {
+        hasargs = false;
+        if(strcmp(arg[iarg_],"file") == 0)
+        {
+            if(iarg_+2 > narg) error->all(FLERR,"Cfd shm coupling: not enough arguments for 'file'");
+            if(strcmp(arg[iarg_+1],"yes") == 0) use_file_ = true;
+            else if(strcmp(arg[iarg_+1],"no") == 0) use_file_ = false;
+            else error->all(FLERR,"Cfd shm coupling: expecting 'yes' or 'no' after 'file'");
+            iarg_ += 2;
+            hasargs = true;
+        }
+        else if(strcmp(arg[iarg_],"timeout") == 0)
+        {
+            if(iarg_+2 > narg) error->all(FLERR,"Cfd shm coupling: not enough arguments for 'timeout'");
+            timeout_ = atof(arg[iarg_+1]);
+            if(timeout_ <= 0.) error->all(FLERR,"Cfd shm coupling: 'timeout' must be > 0");
+            iarg_ += 2;
+            hasargs = true;
+        }
+    }
+
+    if(!use_file_ && strchr(name_,'/'))
+        error->all(FLERR,"Cfd shm coupling: name of shared memory segment must not contain '/', use 'file yes' for a path");
+
+    // segment: /name.rank or file name.rank
+    // semaphore names are set once the segment exists, see sem_names()
+
+    char rank[16];
+    sprintf(rank,".%d",comm->me);
+
+    segname_ = new char[strlen(name_)+strlen(rank)+2];
+    sprintf(segname_,"%s%s%s",use_file_ ? "" : "/",name_,rank);
+}
+
+/* ---------------------------------------------------------------------- */
+
+CfdDatacouplingShm::~CfdDatacouplingShm()
+{
+    close_segment();
+
+    delete []name_;
+    delete []segname_;
+    delete []semname_push_;
+    delete []semname_pull_;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::post_create()
+{
+    if(!atom->tag_enable)
+        error->all(FLERR,"Fix couple/cfd with shm coupling requires particles to have IDs");
+    if(atom->map_style == 0)
+        error->all(FLERR,"Fix couple/cfd with shm coupling requires an atom map");
+
+    open_segment();
+}
+
+/* ----------------------------------------------------------------------
+   create segment with an initial layout and both semaphores
+   any leftovers of a previous run with the same name are removed
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::open_segment()
+{
+#ifdef CFD_SHM_SUPPORTED
+    if(use_file_) fd_ = open(segname_,O_RDWR | O_CREAT | O_TRUNC,0600);
+    else
+    {
+        shm_unlink(segname_);
+        fd_ = shm_open(segname_,O_RDWR | O_CREAT | O_EXCL,0600);
+    }
+    if(fd_ < 0)
+    {
+        char errmsg[512];
+        snprintf(errmsg,sizeof(errmsg),"Fix couple/cfd with shm coupling: could not create %s: %s",
+                 segname_,strerror(errno));
+        error->one(FLERR,errmsg);
+    }
+
+    sem_names();
+
+    sem_unlink(semname_push_);
+    sem_unlink(semname_pull_);
+    sem_push_ = (void*) sem_open(semname_push_,O_CREAT | O_EXCL,0600,0);
+    sem_pull_ = (void*) sem_open(semname_pull_,O_CREAT | O_EXCL,0600,0);
+    if(sem_push_ == (void*) SEM_FAILED || sem_pull_ == (void*) SEM_FAILED)
+    {
+        char errmsg[1024];
+        snprintf(errmsg,sizeof(errmsg),"Fix couple/cfd with shm coupling: could not create semaphores %s, %s: %s",
+                 semname_push_,semname_pull_,strerror(errno));
+        sem_push_ = sem_pull_ = NULL;
+        error->one(FLERR,errmsg);
+    }
+
+    layout(atom->nlocal > CAPACITY_MIN ? static_cast<int>(CAPACITY_GROW*atom->nlocal) : CAPACITY_MIN);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   semaphores: /name.rank.push and /name.rank.pull
+   with 'file yes', name.rank is the absolute path of the segment file
+   with every '/' replaced by '_', so that segments in different
+   directories never share semaphores
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::sem_names()
+{
+#ifdef CFD_SHM_SUPPORTED
+    char path[PATH_MAX];
+    const char *key = segname_+1;
+
+    if(use_file_)
+    {
+        if(!realpath(segname_,path))
+        {
+            char errmsg[512];
+            snprintf(errmsg,sizeof(errmsg),"Fix couple/cfd with shm coupling: could not resolve path of %s: %s",
+                     segname_,strerror(errno));
+            error->one(FLERR,errmsg);
+        }
+        for(char *c = path; *c; c++)
+            if(*c == '/') *c = '_';
+        key = path;
+    }
+
+    // sem_open() names are limited to NAME_MAX-4 characters
+
+    if(strlen(key)+6 > NAME_MAX-4)
+    {
+        char errmsg[512];
+        snprintf(errmsg,sizeof(errmsg),"Fix couple/cfd with shm coupling: name of segment %s too long for semaphores",
+                 segname_);
+        error->one(FLERR,errmsg);
+    }
+
+    delete []semname_push_;
+    delete []semname_pull_;
+    semname_push_ = new char[strlen(key)+7];
+    semname_pull_ = new char[strlen(key)+7];
+    sprintf(semname_push_,"/%s.push",key);
+    sprintf(semname_pull_,"/%s.pull",key);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   tell the solver that coupling ends, release and remove everything
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::close_segment()
+{
+#ifdef CFD_SHM_SUPPORTED
+    if(header_ && sem_push_)
+    {
+        header_->done = 1;
+        sem_post((sem_t*) sem_push_);
+    }
+
+    if(seg_) munmap(seg_,segsize_);
+    seg_ = NULL;
+    header_ = NULL;
+    segsize_ = 0;
+
+    if(fd_ >= 0)
+    {
+        close(fd_);
+        if(use_file_) unlink(segname_);
+        else shm_unlink(segname_);
+    }
+    fd_ = -1;
+
+    if(sem_push_)
+    {
+        sem_close((sem_t*) sem_push_);
+        sem_unlink(semname_push_);
+    }
+    if(sem_pull_)
+    {
+        sem_close((sem_t*) sem_pull_);
+        sem_unlink(semname_pull_);
+    }
+    sem_push_ = sem_pull_ = NULL;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   (re-)compute the layout for capacity per-atom records
+   the segment is grown and re-mapped if necessary
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::layout(int capacity)
+{
+#ifdef CFD_SHM_SUPPORTED
+    if(npush_+npull_ > CFD_SHM_MAXFIELDS)
+        error->all(FLERR,"Fix couple/cfd with shm coupling: too many coupled properties");
+
+    CfdShmField fields[CFD_SHM_MAXFIELDS];
+    memset(fields,0,sizeof(fields));
+
+    long long offset = align8(sizeof(CfdShmHeader));
+    const long long offset_push_id = offset;
+    offset = align8(offset + (long long)capacity*sizeof(int));
+    const long long offset_pull_id = offset;
+    offset = align8(offset + (long long)capacity*sizeof(int));
+
+    int nfields = 0;
+    for(int direction = CFD_SHM_PUSH; direction <= CFD_SHM_PULL; direction++)
+    {
+        const int n = direction == CFD_SHM_PUSH ? npush_ : npull_;
+        char **names = direction == CFD_SHM_PUSH ? pushnames_ : pullnames_;
+        char **types = direction == CFD_SHM_PUSH ? pushtypes_ : pulltypes_;
+
+        for(int i = 0; i < n; i++)
+        {
+            CfdShmField &f = fields[nfields++];
+            strncpy(f.name,names[i],CFD_SHM_NAMELEN-1);
+            strncpy(f.type,types[i],CFD_SHM_NAMELEN-1);
+            f.direction = direction;
+
+            int len1 = 0, len2 = 0;
+            if(direction == CFD_SHM_PUSH) find_push_property(names[i],types[i],len1,len2);
+            else find_pull_property(names[i],types[i],len1,len2);
+
+            if(strstr(types[i],"multisphere"))
+                error->all(FLERR,"Fix couple/cfd with shm coupling does not support multisphere properties");
+
+            if(strstr(types[i],"-atom"))
+            {
+                f.peratom = 1;
+                f.len1 = capacity;
+                f.len2 = len2 > 0 ? len2 : 1;
+            }
+            else
+            {
+                f.peratom = 0;
+                f.len1 = len1 > 0 ? len1 : 0;
+                f.len2 = strcmp(types[i],"array-global") == 0 ? (len2 > 0 ? len2 : 0) : 1;
+            }
+            f.offset = offset;
+            offset = align8(offset + (long long)f.len1*f.len2*sizeof(double));
+        }
+    }
+
+    // grow and re-map segment
+
+    if(offset > segsize_)
+    {
+        if(seg_) munmap(seg_,segsize_);
+        seg_ = NULL;
+        header_ = NULL;
+
+        if(ftruncate(fd_,offset) != 0)
+        {
+            char errmsg[512];
+            snprintf(errmsg,sizeof(errmsg),"Fix couple/cfd with shm coupling: could not resize %s: %s",
+                     segname_,strerror(errno));
+            error->one(FLERR,errmsg);
+        }
+        seg_ = mmap(NULL,offset,PROT_READ | PROT_WRITE,MAP_SHARED,fd_,0);
+        if(seg_ == MAP_FAILED)
+        {
+            seg_ = NULL;
+            char errmsg[512];
+            snprintf(errmsg,sizeof(errmsg),"Fix couple/cfd with shm coupling: could not map %s: %s",
+                     segname_,strerror(errno));
+            error->one(FLERR,errmsg);
+        }
+        segsize_ = offset;
+    }
+
+    header_ = (CfdShmHeader*) seg_;
+    header_->magic = CFD_SHM_MAGIC;
+    header_->version = CFD_SHM_VERSION;
+    header_->size = segsize_;
+    header_->capacity = capacity;
+    header_->offset_push_id = offset_push_id;
+    header_->offset_pull_id = offset_pull_id;
+    header_->nfields = nfields;
+    memcpy(header_->fields,fields,sizeof(fields));
+#else
+    (void) capacity;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   layout needs to be redone if particles do not fit or properties were
+   added after the last layout
+------------------------------------------------------------------------- */
+
+bool CfdDatacouplingShm::layout_valid()
+{
+    return header_ && atom->nlocal <= header_->capacity &&
+           header_->nfields == npush_+npull_;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int CfdDatacouplingShm::find_field(const char *name, const char *type, int direction)
+{
+    for(int i = 0; i < header_->nfields; i++)
+    {
+        CfdShmField &f = header_->fields[i];
+        if(f.direction == direction && strcmp(f.name,name) == 0 && strcmp(f.type,type) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double *CfdDatacouplingShm::field_data(int ifield)
+{
+    return (double*) ((char*)seg_ + header_->fields[ifield].offset);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int *CfdDatacouplingShm::id_data(int direction)
+{
+    return (int*) ((char*)seg_ +
+        (direction == CFD_SHM_PUSH ? header_->offset_push_id : header_->offset_pull_id));
+}
+
+/* ----------------------------------------------------------------------
+   one coupling step: publish push data, block until the solver has
+   provided the pull data, then read it
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::exchange()
+{
+#ifdef CFD_SHM_SUPPORTED
+    void *dummy = NULL;
+    const int nlocal = atom->nlocal;
+
+    if(!layout_valid())
+        layout(nlocal > CAPACITY_MIN ? static_cast<int>(CAPACITY_GROW*nlocal) : CAPACITY_MIN);
+
+    header_->ntimestep = update->ntimestep;
+    header_->npush = nlocal;
+    header_->npull = 0;
+
+    int *id = id_data(CFD_SHM_PUSH);
+    int *tag = atom->tag;
+    for(int i = 0; i < nlocal; i++)
+        id[i] = tag[i];
+
+    for(int i = 0; i < npush_; i++)
+       push(pushnames_[i],pushtypes_[i],dummy,"");
+
+    sem_post((sem_t*) sem_push_);
+    wait_pull();
+
+    if(header_->npull < 0 || header_->npull > header_->capacity)
+        error->one(FLERR,"Fix couple/cfd with shm coupling: # of pull records exceeds capacity");
+
+    for(int i = 0; i < npull_; i++)
+       pull(pullnames_[i],pulltypes_[i],dummy,"");
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::wait_pull()
+{
+#ifdef CFD_SHM_SUPPORTED
+    sem_t *sem = (sem_t*) sem_pull_;
+    int ret;
+
+    if(timeout_ <= 0.)
+    {
+        do ret = sem_wait(sem);
+        while(ret != 0 && errno == EINTR);
+    }
+    else
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME,&ts);
+        const long long nsec = ts.tv_nsec + static_cast<long long>((timeout_-static_cast<long long>(timeout_))*1e9);
+        ts.tv_sec += static_cast<time_t>(timeout_) + nsec/1000000000LL;
+        ts.tv_nsec = nsec % 1000000000LL;
+
+        do ret = sem_timedwait(sem,&ts);
+        while(ret != 0 && errno == EINTR);
+
+        if(ret != 0 && errno == ETIMEDOUT)
+            error->one(FLERR,"Fix couple/cfd with shm coupling: timeout while waiting for solver");
+    }
+    if(ret != 0)
+        error->one(FLERR,"Fix couple/cfd with shm coupling: waiting for solver failed");
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::pull(const char *name, const char *type, void *&from, const char *datatype)
+{
+    CfdDatacoupling::pull(name,type,from,datatype);
+
+    int len1 = -1, len2 = -1;
+
+    void * to = find_pull_property(name,type,len1,len2);
+    const int ifield = find_field(name,type,CFD_SHM_PULL);
+
+    if(!to || ifield < 0)
+    {
+        if(screen) fprintf(screen,"LIGGGHTS could not find property %s to write data from calling program to.\n",name);
+        lmp->error->all(FLERR,"This error is fatal");
+    }
+
+    const CfdShmField &f = header_->fields[ifield];
+    const double *data = field_data(ifield);
+
+    if(f.peratom && f.len2 != len2 && strcmp(type,"scalar-atom") != 0)
+        error->one(FLERR,"Internal error in CfdDatacouplingShm");
+
+    if(f.peratom)
+    {
+        // records are keyed by ID, records of particles not owned (any more)
+        // are skipped, particles without record keep their values
+
+        const int npull = header_->npull;
+        const int nlocal = atom->nlocal;
+        const int *id = id_data(CFD_SHM_PULL);
+        const bool isint = int_atom_property(name);
+        int *tag = atom->tag;
+
+        for(int k = 0; k < npull; k++)
+        {
+            int i = (k < nlocal && tag[k] == id[k]) ? k : atom->map(id[k]);
+            if(i < 0 || i >= nlocal) continue;
+
+            if(strcmp(type,"scalar-atom") == 0)
+            {
+                if(isint) ((int*)to)[i] = static_cast<int>(data[k]);
+                else ((double*)to)[i] = data[k];
+            }
+            else
+                for(int j = 0; j < len2; j++)
+                    ((double**)to)[i][j] = data[k*len2+j];
+        }
+    }
+    else
+    {
+        if(f.len1 != len1 || (strcmp(type,"array-global") == 0 && f.len2 != len2))
+            error->one(FLERR,"Global vector or array received has different length than the corresponding one in LIGGGHTS");
+
+        if(strcmp(type,"vector-global") == 0)
+            memcpy(to,data,len1*sizeof(double));
+        else
+            for(int i = 0; i < len1; i++)
+                memcpy(((double**)to)[i],&data[i*len2],len2*sizeof(double));
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingShm::push(const char *name, const char *type, void *&to, const char *datatype)
+{
+    CfdDatacoupling::push(name,type,to,datatype);
+
+    int len1 = -1, len2 = -1;
+
+    void * from = find_push_property(name,type,len1,len2);
+    const int ifield = find_field(name,type,CFD_SHM_PUSH);
+
+    if(!from || ifield < 0)
+    {
+        if(screen) fprintf(screen,"LIGGGHTS could not find property %s to write to calling program.\n",name);
+        lmp->error->all(FLERR,"This error is fatal");
+    }
+
+    const CfdShmField &f = header_->fields[ifield];
+    double *data = field_data(ifield);
+
+    if(f.peratom && f.len2 != len2 && strcmp(type,"scalar-atom") != 0)
+        error->one(FLERR,"Internal error in CfdDatacouplingShm");
+
+    if(f.peratom)
+    {
+        const int nlocal = atom->nlocal;
+        if(strcmp(type,"scalar-atom") == 0)
+        {
+            if(int_atom_property(name))
+                for(int i = 0; i < nlocal; i++)
+                    data[i] = static_cast<double>(((int*)from)[i]);
+            else memcpy(data,from,nlocal*sizeof(double));
+        }
+        else
+        {
+            double **v = (double**)from;
+            for(int i = 0; i < nlocal; i++)
+                for(int j = 0; j < len2; j++)
+                    data[i*len2+j] = v[i][j];
+        }
+    }
+    else
+    {
+        if(f.len1 != len1 || (strcmp(type,"array-global") == 0 && f.len2 != len2))
+            error->one(FLERR,"Internal error in CfdDatacouplingShm");
+
+        if(strcmp(type,"vector-global") == 0)
+            memcpy(data,from,len1*sizeof(double));
+        else
+            for(int i = 0; i < len1; i++)
+                memcpy(&data[i*len2],((double**)from)[i],len2*sizeof(double));
+    }
+}
@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#ifdef CFD_DATACOUPLING_CLASS
+
+   CfdDataCouplingStyle(shm,CfdDatacouplingShm)
+
+#else
+
+#ifndef LMP_CFD_DATACOUPLING_SHM_H
+#define LMP_CFD_DATACOUPLING_SHM_H
+
+#include "cfd_datacoupling.h"
+#include "cfd_datacoupling_shm_layout.h"
+
+namespace LAMMPS_NS {
+
+class CfdDatacouplingShm : public CfdDatacoupling {
+ public:
+  CfdDatacouplingShm(class LAMMPS *, int, int, char **,class FixCfdCoupling* fc);
+  ~CfdDatacouplingShm();
+
+  void pull(const char *, const char *, void *&, const char *);
+  void push(const char *, const char *, void *&, const char *);
+  virtual void post_create();
+
+  void exchange();
+
+  private:
+
+   char *name_;
+   char *segname_;
+   char *semname_push_;
+   char *semname_pull_;
+
+   bool use_file_;
+   double timeout_;
+
+   int fd_;
+   void *seg_;
+   long long segsize_;
+   CfdShmHeader *header_;
+   void *sem_push_;
+   void *sem_pull_;
+
+   void open_segment();
+   void sem_names();
+   void close_segment();
+   void layout(int capacity);
+   bool layout_valid();
+   void wait_pull();
+
+   int find_field(const char *name, const char *type, int direction);
+   double *field_data(int ifield);
+   int *id_data(int direction);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Fix couple/cfd with shm coupling is not supported on this platform
+
+Shared memory coupling requires POSIX shared memory and semaphores
+with timed waits (sem_timedwait), which e.g. Windows and macOS lack.
+
+E: Fix couple/cfd with shm coupling requires particles to have IDs
+
+Pull data is matched to particles by their ID. Use atom_modify id yes.
+
+E: Fix couple/cfd with shm coupling requires an atom map
+
+Use the atom_modify map command.
+
+E: Fix couple/cfd with shm coupling: could not create %s: %s
+
+The shared memory segment or the memory mapped file could not be
+created, the system error is given.
+
+E: Fix couple/cfd with shm coupling: could not create semaphores %s, %s: %s
+
+The named semaphores of the segment could not be created, the system
+error is given.
+
+E: Fix couple/cfd with shm coupling: could not resolve path of %s: %s
+
+The absolute path of the memory mapped file, which the semaphore names
+are built from, could not be determined.
+
+E: Fix couple/cfd with shm coupling: name of segment %s too long for semaphores
+
+The semaphore names are built from the name of the segment, or from the
+absolute path of the file with 'file yes', and must not exceed the
+system limit. Use a shorter name or path.
+
+E: Fix couple/cfd with shm coupling: could not resize %s: %s
+
+The segment could not be grown to hold the coupled properties, the
+system error is given.
+
+E: Fix couple/cfd with shm coupling: could not map %s: %s
+
+The segment could not be mapped into memory, the system error is given.
+
+E: Fix couple/cfd with shm coupling: timeout while waiting for solver
+
+The coupled program did not provide pull data within the time
+specified by the timeout keyword.
+
+*/
@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   memory layout of the shared memory segment used by
+   fix couple/cfd ... shm, see CfdDatacouplingShm
+
+   plain C header, can be included by the program coupled to LIGGGHTS
+
+   one segment and two semaphores exist per LIGGGHTS process (rank):
+     segment     /<name>.<rank>       (or file <name>.<rank> with 'file yes')
+     semaphores  /<key>.push          posted by LIGGGHTS when push data is ready
+                 /<key>.pull          posted by the solver when pull data is ready
+   key is <name>.<rank>, with 'file yes' it is the absolute path of the
+   file (realpath()) with every '/' replaced by '_', e.g. the semaphores of
+   /scratch/run1/coupling.0 are /_scratch_run1_coupling.0.push and .pull
+
+   each coupling step LIGGGHTS
+     writes the IDs of its owned particles and all push fields, posts push,
+     waits for pull and reads the pull records, which are keyed by ID
+   the solver must re-read header and field offsets after every wait on
+   push, since the segment is re-mapped and re-laid out whenever the
+   particle count exceeds capacity, size then holds the new segment size
+------------------------------------------------------------------------- */
+
+#ifndef LMP_CFD_DATACOUPLING_SHM_LAYOUT_H
+#define LMP_CFD_DATACOUPLING_SHM_LAYOUT_H
+
+#define CFD_SHM_MAGIC      0x4c474853
+#define CFD_SHM_VERSION    1
+#define CFD_SHM_MAXFIELDS  64
+#define CFD_SHM_NAMELEN    32
+
+#define CFD_SHM_PUSH 0    // LIGGGHTS -> solver
+#define CFD_SHM_PULL 1    // solver -> LIGGGHTS
+
+typedef struct CfdShmField {
+  char name[CFD_SHM_NAMELEN];
+  char type[CFD_SHM_NAMELEN];  // scalar-atom, vector-atom, vector-global, array-global
+  int direction;               // CFD_SHM_PUSH or CFD_SHM_PULL
+  int peratom;                 // 1 for per-atom, 0 for global fields
+  int len1,len2;               // global: dimensions, per-atom: len2 = values per atom
+  long long offset;            // byte offset of the double data in the segment
+} CfdShmField;
+
+typedef struct CfdShmHeader {
+  int magic,version;
+  long long size;              // size of the segment in bytes
+  long long ntimestep;
+  int capacity;                // max # of per-atom records in each direction
+  int npush;                   // # of records written by LIGGGHTS
+  int npull;                   // # of records written by the solver
+  int done;                    // set to 1 by LIGGGHTS when coupling ends
+  long long offset_push_id;    // byte offset of the int IDs of the push records
+  long long offset_pull_id;    // byte offset of the int IDs of the pull records
+  int nfields;
+  int pad;
+  CfdShmField fields[CFD_SHM_MAXFIELDS];
+} CfdShmHeader;
+
+#endif
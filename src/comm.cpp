@@ -131,6 +131,13 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   cutghostuser = 0.0;
   ghost_velocity = 0;
 
+  persistent = 0;
+  npersist = 0;
+  req_x_recv = req_fwd_recv = req_fwd_send = NULL;
+  req_rev_recv = req_rev_send = NULL;
+  persist_x = persist_f = persist_send = persist_recv = NULL;
+  persist_maxrecv = 0;
+
   // use of OpenMP threads
   // query OpenMP for number of threads/process set by user at run-time
   // if the OMP_NUM_THREADS environment variable is not set, we default
@@ -200,6 +207,7 @@ Comm::~Comm()
 
   memory->destroy(grid2proc);
 
+  free_persistent();
   free_swap();
   if (style == MULTI) {
     free_multi();
@@ -376,6 +384,10 @@ void Comm::init()
   comm_f_only = atom->avec->comm_f_only;
   if (ghost_velocity) comm_x_only = 0;
 
+  // persistent requests depend on comm_x_only and per-atom sizes
+
+  free_persistent();
+
   // set per-atom sizes for forward/reverse/border comm
   // augment by velocity and fix quantities if needed
 
@@ -774,44 +786,62 @@ void Comm::forward_comm(int dummy)
 {
   int n;
   MPI_Request request;
+  MPI_Request *rreq,*sreq;
   MPI_Status status;
   AtomVec *avec = atom->avec;
   double **x = atom->x;
   double *buf;
 
+  // use persistent requests if requested and swap pattern is unchanged
+
+  const bool persist = setup_persistent();
+
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
 
   for (int iswap = 0; iswap < nswap; iswap++) {
     if (sendproc[iswap] != me) {
+      rreq = NULL;
       if (comm_x_only) {
         if (size_forward_recv[iswap]) buf = x[firstrecv[iswap]];
         else buf = NULL;
         if (size_forward_recv[iswap])
-          MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,
-                    recvproc[iswap],0,world,&request);
+          rreq = start_recv(persist ? &req_x_recv[iswap] : NULL,
+                            buf,size_forward_recv[iswap],recvproc[iswap],
+                            &request);
         n = avec->pack_comm(sendnum[iswap],sendlist[iswap],
                             buf_send,pbc_flag[iswap],pbc[iswap]);
-        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,&status);
+        sreq = start_send(persist ? &req_fwd_send[iswap] : NULL,
+                          sendnum[iswap]*size_forward,buf_send,n,
+                          sendproc[iswap]);
+        if (rreq) MPI_Wait(rreq,&status);
+        if (sreq) MPI_Wait(sreq,&status);
       } else if (ghost_velocity) {
         if (size_forward_recv[iswap])
-          MPI_Irecv(buf_recv,size_forward_recv[iswap],MPI_DOUBLE,
-                    recvproc[iswap],0,world,&request);
+          rreq = start_recv(persist ? &req_fwd_recv[iswap] : NULL,
+                            buf_recv,size_forward_recv[iswap],
+                            recvproc[iswap],&request);
         n = avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],
                                 buf_send,pbc_flag[iswap],pbc[iswap]);
-        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,&status);
+        sreq = start_send(persist ? &req_fwd_send[iswap] : NULL,
+                          sendnum[iswap]*size_forward,buf_send,n,
+                          sendproc[iswap]);
+        if (rreq) MPI_Wait(rreq,&status);
+        if (sreq) MPI_Wait(sreq,&status);
         avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_recv);
       } else {
         if (size_forward_recv[iswap])
-          MPI_Irecv(buf_recv,size_forward_recv[iswap],MPI_DOUBLE,
-                    recvproc[iswap],0,world,&request);
+          rreq = start_recv(persist ? &req_fwd_recv[iswap] : NULL,
+                            buf_recv,size_forward_recv[iswap],
+                            recvproc[iswap],&request);
         n = avec->pack_comm(sendnum[iswap],sendlist[iswap],
                             buf_send,pbc_flag[iswap],pbc[iswap]);
-        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,&status);
+        sreq = start_send(persist ? &req_fwd_send[iswap] : NULL,
+                          sendnum[iswap]*size_forward,buf_send,n,
+                          sendproc[iswap]);
+        if (rreq) MPI_Wait(rreq,&status);
+        if (sreq) MPI_Wait(sreq,&status);
         avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_recv);
       }
 
@@ -843,35 +873,41 @@ void Comm::reverse_comm()
 {
   int n;
   MPI_Request request;
+  MPI_Request *rreq,*sreq;
   MPI_Status status;
   AtomVec *avec = atom->avec;
   double **f = atom->f;
   double *buf;
 
+  // use persistent requests if requested and swap pattern is unchanged
+
+  const bool persist = setup_persistent();
+
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_f_only set, exchange or copy directly from f, don't pack
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
     if (sendproc[iswap] != me) {
+      rreq = NULL;
+      if (size_reverse_recv[iswap])
+        rreq = start_recv(persist ? &req_rev_recv[iswap] : NULL,
+                          buf_recv,size_reverse_recv[iswap],sendproc[iswap],
+                          &request);
       if (comm_f_only) {
-        if (size_reverse_recv[iswap])
-          MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,
-                    sendproc[iswap],0,world,&request);
         if (size_reverse_send[iswap]) buf = f[firstrecv[iswap]];
         else buf = NULL;
-        if (size_reverse_send[iswap])
-          MPI_Send(buf,size_reverse_send[iswap],MPI_DOUBLE,
-                   recvproc[iswap],0,world);
-        if (size_reverse_recv[iswap]) MPI_Wait(&request,&status);
+        sreq = start_send(persist ? &req_rev_send[iswap] : NULL,
+                          size_reverse_send[iswap],buf,
+                          size_reverse_send[iswap],recvproc[iswap]);
       } else {
-        if (size_reverse_recv[iswap])
-          MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,
-                    sendproc[iswap],0,world,&request);
         n = avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
-        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,recvproc[iswap],0,world);
-        if (size_reverse_recv[iswap]) MPI_Wait(&request,&status);
+        sreq = start_send(persist ? &req_rev_send[iswap] : NULL,
+                          size_reverse_send[iswap],buf_send,n,
+                          recvproc[iswap]);
       }
+      if (rreq) MPI_Wait(rreq,&status);
+      if (sreq) MPI_Wait(sreq,&status);
       avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
 
     } else {
@@ -1037,6 +1073,10 @@ void Comm::borders()
   MPI_Status status;
   AtomVec *avec = atom->avec;
 
+  // swap pattern changes, persistent requests are rebuilt on next use
+
+  free_persistent();
+
   // do swaps over all 3 dimensions
 
   nfirst = 0;
@@ -1245,8 +1285,11 @@ void Comm::forward_comm_pair(Pair *pair)
   int iswap,n;
   double *buf;
   MPI_Request request;
+  MPI_Request *rreq;
   MPI_Status status;
 
+  const bool persist = setup_persistent();
+
   for (iswap = 0; iswap < nswap; iswap++) {
 
     // pack buffer
@@ -1258,12 +1301,14 @@ void Comm::forward_comm_pair(Pair *pair)
     // if self, set recv buffer to send buffer
 
     if (sendproc[iswap] != me) {
+      rreq = NULL;
       if (recvnum[iswap])
-        MPI_Irecv(buf_recv,n*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,
-                  world,&request);
+        rreq = start_recv(persist ? &req_fwd_recv[iswap] : NULL,
+                          buf_recv,n*recvnum[iswap],recvproc[iswap],
+                          &request);
       if (sendnum[iswap])
         MPI_Send(buf_send,n*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,world);
-      if (recvnum[iswap]) MPI_Wait(&request,&status);
+      if (rreq) MPI_Wait(rreq,&status);
       buf = buf_recv;
     } else buf = buf_send;
 
@@ -1282,8 +1327,11 @@ void Comm::reverse_comm_pair(Pair *pair)
   int iswap,n;
   double *buf;
   MPI_Request request;
+  MPI_Request *rreq;
   MPI_Status status;
 
+  const bool persist = setup_persistent();
+
   for (iswap = nswap-1; iswap >= 0; iswap--) {
 
     // pack buffer
@@ -1294,12 +1342,14 @@ void Comm::reverse_comm_pair(Pair *pair)
     // if self, set recv buffer to send buffer
 
     if (sendproc[iswap] != me) {
+      rreq = NULL;
       if (sendnum[iswap])
-        MPI_Irecv(buf_recv,n*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,
-                  world,&request);
+        rreq = start_recv(persist ? &req_rev_recv[iswap] : NULL,
+                          buf_recv,n*sendnum[iswap],sendproc[iswap],
+                          &request);
       if (recvnum[iswap])
         MPI_Send(buf_send,n*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,world);
-      if (sendnum[iswap]) MPI_Wait(&request,&status);
+      if (rreq) MPI_Wait(rreq,&status);
       buf = buf_recv;
     } else buf = buf_send;
 
@@ -1319,8 +1369,11 @@ void Comm::forward_comm_fix(Fix *fix)
   int iswap,n;
   double *buf;
   MPI_Request request;
+  MPI_Request *rreq;
   MPI_Status status;
 
+  const bool persist = setup_persistent();
+
   for (iswap = 0; iswap < nswap; iswap++) {
 
     // pack buffer
@@ -1332,12 +1385,14 @@ void Comm::forward_comm_fix(Fix *fix)
     // if self, set recv buffer to send buffer
 
     if (sendproc[iswap] != me) {
+      rreq = NULL;
       if (recvnum[iswap])
-        MPI_Irecv(buf_recv,n*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,
-                  world,&request);
+        rreq = start_recv(persist ? &req_fwd_recv[iswap] : NULL,
+                          buf_recv,n*recvnum[iswap],recvproc[iswap],
+                          &request);
       if (sendnum[iswap])
         MPI_Send(buf_send,n*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,world);
-      if (recvnum[iswap]) MPI_Wait(&request,&status);
+      if (rreq) MPI_Wait(rreq,&status);
       buf = buf_recv;
     } else buf = buf_send;
 
@@ -1357,8 +1412,11 @@ void Comm::reverse_comm_fix(Fix *fix)
   int iswap,n;
   double *buf;
   MPI_Request request;
+  MPI_Request *rreq;
   MPI_Status status;
 
+  const bool persist = setup_persistent();
+
   for (iswap = nswap-1; iswap >= 0; iswap--) {
 
     // pack buffer
@@ -1369,12 +1427,14 @@ void Comm::reverse_comm_fix(Fix *fix)
     // if self, set recv buffer to send buffer
 
     if (sendproc[iswap] != me) {
+      rreq = NULL;
       if (sendnum[iswap])
-        MPI_Irecv(buf_recv,n*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,
-                  world,&request);
+        rreq = start_recv(persist ? &req_rev_recv[iswap] : NULL,
+                          buf_recv,n*sendnum[iswap],sendproc[iswap],
+                          &request);
       if (recvnum[iswap])
         MPI_Send(buf_send,n*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,world);
-      if (sendnum[iswap]) MPI_Wait(&request,&status);
+      if (rreq) MPI_Wait(rreq,&status);
       buf = buf_recv;
     } else buf = buf_send;
 
@@ -1888,6 +1948,123 @@ void Comm::free_multi()
   memory->destroy(multihi);
 }
 
+/* ----------------------------------------------------------------------
+   set up persistent requests for the current swap pattern
+   pattern is fixed between two calls to borders(), so requests are only
+     rebuilt after borders() or when x, f or the comm buffers were realloced
+   receives into buf_recv use maxrecv as count, so they serve any
+     forward/reverse comm whose per-atom size fits into buf_recv
+   return false if persistent requests are not used
+------------------------------------------------------------------------- */
+
+bool Comm::setup_persistent()
+{
+  if (!persistent) return false;
+
+  double *x0 = (atom->x && atom->nmax) ? atom->x[0] : NULL;
+  double *f0 = (atom->f && atom->nmax) ? atom->f[0] : NULL;
+
+  if (req_x_recv && npersist == nswap && x0 == persist_x &&
+      f0 == persist_f && buf_send == persist_send &&
+      buf_recv == persist_recv && maxrecv == persist_maxrecv)
+    return true;
+
+  free_persistent();
+
+  npersist = nswap;
+  req_x_recv = new MPI_Request[nswap+1];
+  req_fwd_recv = new MPI_Request[nswap+1];
+  req_fwd_send = new MPI_Request[nswap+1];
+  req_rev_recv = new MPI_Request[nswap+1];
+  req_rev_send = new MPI_Request[nswap+1];
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    req_x_recv[iswap] = req_fwd_recv[iswap] = req_fwd_send[iswap] =
+      req_rev_recv[iswap] = req_rev_send[iswap] = MPI_REQUEST_NULL;
+    if (sendproc[iswap] == me) continue;
+
+    if (comm_x_only && size_forward_recv[iswap])
+      MPI_Recv_init(atom->x[firstrecv[iswap]],size_forward_recv[iswap],
+                    MPI_DOUBLE,recvproc[iswap],0,world,&req_x_recv[iswap]);
+    MPI_Recv_init(buf_recv,maxrecv,MPI_DOUBLE,recvproc[iswap],0,world,
+                  &req_fwd_recv[iswap]);
+    MPI_Recv_init(buf_recv,maxrecv,MPI_DOUBLE,sendproc[iswap],0,world,
+                  &req_rev_recv[iswap]);
+    if (sendnum[iswap])
+      MPI_Send_init(buf_send,sendnum[iswap]*size_forward,MPI_DOUBLE,
+                    sendproc[iswap],0,world,&req_fwd_send[iswap]);
+    if (size_reverse_send[iswap]) {
+      double *buf = comm_f_only ? atom->f[firstrecv[iswap]] : buf_send;
+      MPI_Send_init(buf,size_reverse_send[iswap],MPI_DOUBLE,
+                    recvproc[iswap],0,world,&req_rev_send[iswap]);
+    }
+  }
+
+  persist_x = x0;
+  persist_f = f0;
+  persist_send = buf_send;
+  persist_recv = buf_recv;
+  persist_maxrecv = maxrecv;
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   free persistent requests, they are rebuilt on next use
+------------------------------------------------------------------------- */
+
+void Comm::free_persistent()
+{
+  if (!req_x_recv) return;
+
+  MPI_Request *req[5] = {req_x_recv,req_fwd_recv,req_fwd_send,
+                         req_rev_recv,req_rev_send};
+  for (int k = 0; k < 5; k++) {
+    for (int iswap = 0; iswap < npersist; iswap++)
+      if (req[k][iswap] != MPI_REQUEST_NULL) MPI_Request_free(&req[k][iswap]);
+    delete [] req[k];
+  }
+
+  req_x_recv = req_fwd_recv = req_fwd_send = NULL;
+  req_rev_recv = req_rev_send = NULL;
+  npersist = 0;
+}
+
+/* ----------------------------------------------------------------------
+   post a receive of n doubles from proc
+   start persistent request preq if set up, else MPI_Irecv into request
+   return request to wait on
+------------------------------------------------------------------------- */
+
+MPI_Request *Comm::start_recv(MPI_Request *preq, double *buf, int n,
+                              int proc, MPI_Request *request)
+{
+  if (preq && *preq != MPI_REQUEST_NULL) {
+    MPI_Start(preq);
+    return preq;
+  }
+  MPI_Irecv(buf,n,MPI_DOUBLE,proc,0,world,request);
+  return request;
+}
+
+/* ----------------------------------------------------------------------
+   send n doubles to proc
+   start persistent request preq if it was set up for npreq = n values,
+     else fall back to a blocking MPI_Send
+   return request to wait on, NULL if nothing is pending
+------------------------------------------------------------------------- */
+
+MPI_Request *Comm::start_send(MPI_Request *preq, int npreq, double *buf,
+                              int n, int proc)
+{
+  if (!n) return NULL;
+  if (preq && *preq != MPI_REQUEST_NULL && n == npreq) {
+    MPI_Start(preq);
+    return preq;
+  }
+  MPI_Send(buf,n,MPI_DOUBLE,proc,0,world);
+  return NULL;
+}
+
 /* ----------------------------------------------------------------------
    set communication style
    invoked from input script by communicate command
@@ -1924,6 +2101,13 @@ void Comm::set(int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) ghost_velocity = 0;
       else error->all(FLERR,"Illegal communicate command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"persistent") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal communicate command");
+      if (strcmp(arg[iarg+1],"yes") == 0) persistent = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) persistent = 0;
+      else error->all(FLERR,"Illegal communicate command");
+      free_persistent();
+      iarg += 2;
     } else error->all(FLERR,"Illegal communicate command");
   }
 }
@@ -171,6 +171,17 @@ class Comm : protected Pointers {
   int maxexchange;                  // max # of datums/atom in exchange comm
   int bufextra;                     // extra space beyond maxsend in send buffer
 
+  int persistent;                   // 1 if persistent requests used for swaps
+  int npersist;                     // # of swaps with persistent requests
+  MPI_Request *req_x_recv;          // forward recv directly into x
+  MPI_Request *req_fwd_recv;        // forward recv into buf_recv
+  MPI_Request *req_fwd_send;        // forward send from buf_send
+  MPI_Request *req_rev_recv;        // reverse recv into buf_recv
+  MPI_Request *req_rev_send;        // reverse send from f or buf_send
+  double *persist_x,*persist_f;     // x,f the requests were set up for
+  double *persist_send,*persist_recv; // buffers the requests were set up for
+  int persist_maxrecv;              // maxrecv the requests were set up for
+
   int updown(int, int, int, double, int, double *);
                                             // compare cutoff to procs
   virtual void grow_send(int,int);          // reallocate send buffer
@@ -184,6 +195,11 @@ class Comm : protected Pointers {
   virtual void exchangeEventsRecorder();    // Recorder for Exchange events
   virtual void exchangeEventsCorrector();   // Corrects receiving process ids
 
+  bool setup_persistent();                  // (re)create persistent requests
+  void free_persistent();                   // free persistent requests
+  MPI_Request *start_recv(MPI_Request *, double *, int, int, MPI_Request *);
+  MPI_Request *start_send(MPI_Request *, int, double *, int, int);
+
   bool use_gran_opt();
   bool decide(int i,int dim,double lo,double hi,int ineed);
   bool decide_wedge(int i,int dim,double lo,double hi,int ineed);
@@ -46,6 +46,7 @@
 #include <cmath>
 #include <string.h>
 #include <stdlib.h>
+#include <algorithm>
 #include "compute_cluster_atom.h"
 #include "atom.h"
 #include "update.h"
@@ -55,28 +56,78 @@
 #include "neigh_request.h"
 #include "force.h"
 #include "pair.h"
+#include "pair_gran.h"
+#include "domain.h"
 #include "comm.h"
 #include "memory.h"
 #include "error.h"
 
 using namespace LAMMPS_NS;
 
+#define DELTA 1024
+
 /* ---------------------------------------------------------------------- */
 
 ComputeClusterAtom::ComputeClusterAtom(LAMMPS *lmp, int &iarg, int narg, char **arg) :
   Compute(lmp, iarg, narg, arg)
 {
-  if (narg != iarg+1) error->all(FLERR,"Illegal compute cluster/atom command");
+  if (narg < iarg+1) error->all(FLERR,"Illegal compute cluster/atom command");
 
   double cutoff = force->numeric(FLERR,arg[iarg++]);
   cutsq = cutoff*cutoff;
 
+  contactflag = 0;
+  gap = cutoff;
+  nbin = 0;
+
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"contact") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal compute cluster/atom command");
+      if (strcmp(arg[iarg+1],"yes") == 0) contactflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) contactflag = 0;
+      else error->all(FLERR,"Illegal compute cluster/atom command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"nbin") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal compute cluster/atom command");
+      nbin = force->inumeric(FLERR,arg[iarg+1]);
+      if (nbin < 0) error->all(FLERR,"Illegal compute cluster/atom command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal compute cluster/atom command");
+  }
+
+  if (contactflag && !atom->sphere_flag)
+    error->all(FLERR,"Compute cluster/atom with contact yes requires "
+               "atom style sphere");
+
   peratom_flag = 1;
   size_peratom_cols = 0;
   comm_forward = 1;
 
+  // per-cluster size, mass, centroid of clusters owned by this proc
+  // optional histogram of cluster sizes
+
+  local_flag = 1;
+  size_local_cols = 6;
+
+  if (nbin) {
+    vector_flag = 1;
+    size_vector = nbin;
+    extvector = 0;
+    vector = new double[nbin];
+  }
+
   nmax = 0;
   clusterID = NULL;
+  parent = NULL;
+  linked = NULL;
+  list = NULL;
+  pair_gran = NULL;
+
+  ncluster = maxcluster = 0;
+  cluster = NULL;
+  invoked_stats = -1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -84,6 +135,10 @@ ComputeClusterAtom::ComputeClusterAtom(LAMMPS *lmp, int &iarg, int narg, char **
 ComputeClusterAtom::~ComputeClusterAtom()
 {
   memory->destroy(clusterID);
+  memory->destroy(parent);
+  memory->destroy(linked);
+  memory->destroy(cluster);
+  if (nbin) delete [] vector;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -94,19 +149,34 @@ void ComputeClusterAtom::init()
     error->all(FLERR,"Cannot use compute cluster/atom unless atoms have IDs");
   if (force->pair == NULL)
     error->all(FLERR,"Compute cluster/atom requires a pair style be defined");
-  if (sqrt(cutsq) > force->pair->cutforce)
-    error->all(FLERR,
-               "Compute cluster/atom cutoff is longer than pairwise cutoff");
 
-  // need an occasional full neighbor list
-  // full required so that pair of atoms on 2 procs both set their clusterID
+  if (contactflag) {
+
+    // contacts are taken from the neighbor list of the granular pair style
+    // so no extra neighbor list is needed
+
+    pair_gran = static_cast<PairGran*>(force->pair_match("gran", 0));
+    if (pair_gran == NULL)
+      error->all(FLERR,"Compute cluster/atom with contact yes requires "
+                 "a granular pair style");
+    if (gap > neighbor->skin)
+      error->all(FLERR,"Compute cluster/atom gap is larger than neighbor skin");
+
+  } else {
+    if (sqrt(cutsq) > force->pair->cutforce)
+      error->all(FLERR,
+                 "Compute cluster/atom cutoff is longer than pairwise cutoff");
+
+    // need an occasional full neighbor list
+    // full required so that pair of atoms on 2 procs both set their clusterID
 
-  int irequest = neighbor->request((void *) this);
-  neighbor->requests[irequest]->pair = 0;
-  neighbor->requests[irequest]->compute = 1;
-  neighbor->requests[irequest]->half = 0;
-  neighbor->requests[irequest]->full = 1;
-  neighbor->requests[irequest]->occasional = 1;
+    int irequest = neighbor->request((void *) this);
+    neighbor->requests[irequest]->pair = 0;
+    neighbor->requests[irequest]->compute = 1;
+    neighbor->requests[irequest]->half = 0;
+    neighbor->requests[irequest]->full = 1;
+    neighbor->requests[irequest]->occasional = 1;
+  }
 
   int count = 0;
   for (int i = 0; i < modify->ncompute; i++)
@@ -126,97 +196,380 @@ void ComputeClusterAtom::init_list(int id, NeighList *ptr)
 
 void ComputeClusterAtom::compute_peratom()
 {
-  int i,j,ii,jj,inum,jnum; 
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  int i,j,ii,jj,inum,jnum;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,radsum;
   int *ilist,*jlist,*numneigh,**firstneigh;
+  int *touch = NULL,**firsttouch = NULL;
 
   invoked_peratom = update->ntimestep;
 
-  // grow clusterID array if necessary
+  // grow per-atom arrays if necessary
 
   if (atom->nlocal+atom->nghost > nmax) {
     memory->destroy(clusterID);
+    memory->destroy(parent);
+    memory->destroy(linked);
     nmax = atom->nmax;
     memory->create(clusterID,nmax,"cluster/atom:clusterID");
+    memory->create(parent,nmax,"cluster/atom:parent");
+    memory->create(linked,nmax,"cluster/atom:linked");
     vector_atom = clusterID;
   }
 
-  // invoke full neighbor list (will copy or build if necessary)
+  if (contactflag) {
+    NeighList *glist = pair_gran->list;
+    inum = glist->inum;
+    ilist = glist->ilist;
+    numneigh = glist->numneigh;
+    firstneigh = glist->firstneigh;
+    if (pair_gran->is_history())
+      firsttouch = pair_gran->listgranhistory->firstneigh;
+  } else {
+
+    // invoke full neighbor list (will copy or build if necessary)
 
-  neighbor->build_one(list->index);
+    neighbor->build_one(list->index);
 
-  inum = list->inum;
-  ilist = list->ilist;
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
+    inum = list->inum;
+    ilist = list->ilist;
+    numneigh = list->numneigh;
+    firstneigh = list->firstneigh;
+  }
 
-  // every atom starts in its own cluster, with clusterID = atomID
+  // every atom starts in its own cluster
+  // owned and ghost atoms are nodes of a union-find forest
+  // the root of each tree is the atom with the smallest ID
 
   int *tag = atom->tag;
   int *mask = atom->mask;
+  double **x = atom->x;
+  double *radius = atom->radius;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  for (i = 0; i < nall; i++) {
+    parent[i] = i;
+    linked[i] = 0;
+  }
+
+  // link each pair of neighbors in the group in a single sweep
+  // contact: touching or within gap of each other, else within cutoff
 
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
-    if (mask[i] & groupbit) clusterID[i] = tag[i];
+    if (!(mask[i] & groupbit)) continue;
+
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    if (firsttouch) touch = firsttouch[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      if (!(mask[j] & groupbit)) continue;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (contactflag) {
+        radsum = radius[i] + radius[j] + gap;
+        if (rsq <= radsum*radsum || (touch && touch[jj])) link(i,j);
+      } else if (rsq < cutsq) link(i,j);
+    }
+  }
+
+  // local cluster ID = smallest ID of its tree
+
+  for (i = 0; i < nlocal; i++) {
+    if (mask[i] & groupbit) clusterID[i] = tag[find(i)];
     else clusterID[i] = 0;
   }
 
-  // loop until no more changes on any proc:
-  // acquire clusterIDs of ghost atoms
-  // loop over my atoms, checking distance to neighbors
-  // if both atoms are in cluster, assign lowest clusterID to both
-  // iterate until no changes in my atoms
-  // then check if any proc made changes
+  // acquire local cluster IDs of the owners of ghost atoms
+  // ghost atoms link the local cluster ID on this proc with the one
+  //   on the owning proc, collect these pairs and merge them on all procs
 
-  double **x = atom->x;
+  int *gmylabel = NULL;
+  if (atom->nghost) {
+    memory->create(gmylabel,atom->nghost,"cluster/atom:gmylabel");
+    for (i = nlocal; i < nall; i++) gmylabel[i-nlocal] = tag[find(i)];
+  }
+
+  comm->forward_comm_compute(this);
+
+  merge_global(gmylabel);
+  memory->destroy(gmylabel);
+
+  for (i = 0; i < nlocal; i++)
+    if (mask[i] & groupbit)
+      clusterID[i] = find_global(static_cast<int> (clusterID[i]));
+
+  invoked_stats = -1;
+}
+
+/* ----------------------------------------------------------------------
+   join the trees of atoms i and j, smaller atom ID becomes the root
+------------------------------------------------------------------------- */
+
+void ComputeClusterAtom::link(int i, int j)
+{
+  int *tag = atom->tag;
+
+  linked[i] = linked[j] = 1;
+  i = find(i);
+  j = find(j);
+  if (i == j) return;
+  if (tag[i] < tag[j]) parent[j] = i;
+  else parent[i] = j;
+}
+
+/* ----------------------------------------------------------------------
+   return root of tree of atom i, with path halving
+------------------------------------------------------------------------- */
+
+int ComputeClusterAtom::find(int i)
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+/* ----------------------------------------------------------------------
+   gather (my label, owner label) pairs of all linked ghost atoms
+   from all procs and merge them in a union-find forest over the labels
+   every proc builds the same forest, so no further iteration is needed
+------------------------------------------------------------------------- */
 
-  int change,done,anychange;
-
-  while (1) {
-    comm->forward_comm_compute(this);
-
-    change = 0;
-    while (1) {
-      done = 1;
-      for (ii = 0; ii < inum; ii++) {
-        i = ilist[ii];
-        if (!(mask[i] & groupbit)) continue;
-
-        xtmp = x[i][0];
-        ytmp = x[i][1];
-        ztmp = x[i][2];
-        jlist = firstneigh[i];
-        jnum = numneigh[i];
-
-        for (jj = 0; jj < jnum; jj++) {
-          j = jlist[jj];
-          j &= NEIGHMASK;
-          if (!(mask[j] & groupbit)) continue;
-          if (clusterID[i] == clusterID[j]) continue;
-
-          delx = xtmp - x[j][0];
-          dely = ytmp - x[j][1];
-          delz = ztmp - x[j][2];
-          rsq = delx*delx + dely*dely + delz*delz;
-          if (rsq < cutsq) {
-            clusterID[i] = clusterID[j] = MIN(clusterID[i],clusterID[j]);
-            done = 0;
-          }
-        }
-      }
-      if (!done) change = 1;
-      if (done) break;
+void ComputeClusterAtom::merge_global(int *gmylabel)
+{
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  int *mask = atom->mask;
+
+  std::vector<std::pair<int,int> > pairs;
+  for (int i = nlocal; i < nall; i++) {
+    if (!(mask[i] & groupbit) || !linked[i]) continue;
+    int mine = gmylabel[i-nlocal];
+    int other = static_cast<int> (clusterID[i]);
+    if (mine < other) pairs.push_back(std::make_pair(mine,other));
+    else pairs.push_back(std::make_pair(other,mine));
+  }
+  std::sort(pairs.begin(),pairs.end());
+  pairs.erase(std::unique(pairs.begin(),pairs.end()),pairs.end());
+
+  int nsend = 2*pairs.size();
+  int *sendbuf = new int[nsend > 0 ? nsend : 1];
+  for (size_t k = 0; k < pairs.size(); k++) {
+    sendbuf[2*k] = pairs[k].first;
+    sendbuf[2*k+1] = pairs[k].second;
+  }
+
+  int nprocs = comm->nprocs;
+  int *recvcounts = new int[nprocs];
+  int *displs = new int[nprocs];
+  MPI_Allgather(&nsend,1,MPI_INT,recvcounts,1,MPI_INT,world);
+  int nrecv = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    displs[iproc] = nrecv;
+    nrecv += recvcounts[iproc];
+  }
+  int *recvbuf = new int[nrecv > 0 ? nrecv : 1];
+  MPI_Allgatherv(sendbuf,nsend,MPI_INT,recvbuf,recvcounts,displs,MPI_INT,world);
+
+  // labels sorted ascending, so the root with the smaller index
+  // carries the smaller atom ID
+
+  glabel.assign(recvbuf,recvbuf+nrecv);
+  std::sort(glabel.begin(),glabel.end());
+  glabel.erase(std::unique(glabel.begin(),glabel.end()),glabel.end());
+
+  int nlabel = glabel.size();
+  gparent.resize(nlabel);
+  for (int k = 0; k < nlabel; k++) gparent[k] = k;
+
+  for (int k = 0; k < nrecv; k += 2) {
+    int a = std::lower_bound(glabel.begin(),glabel.end(),recvbuf[k]) -
+      glabel.begin();
+    int b = std::lower_bound(glabel.begin(),glabel.end(),recvbuf[k+1]) -
+      glabel.begin();
+    while (gparent[a] != a) a = gparent[a] = gparent[gparent[a]];
+    while (gparent[b] != b) b = gparent[b] = gparent[gparent[b]];
+    if (a < b) gparent[b] = a;
+    else if (b < a) gparent[a] = b;
+  }
+
+  delete [] sendbuf;
+  delete [] recvcounts;
+  delete [] displs;
+  delete [] recvbuf;
+}
+
+/* ----------------------------------------------------------------------
+   return global cluster ID for a local cluster ID
+------------------------------------------------------------------------- */
+
+int ComputeClusterAtom::find_global(int label)
+{
+  std::vector<int>::iterator it =
+    std::lower_bound(glabel.begin(),glabel.end(),label);
+  if (it == glabel.end() || *it != label) return label;
+
+  int k = it - glabel.begin();
+  while (gparent[k] != k) k = gparent[k] = gparent[gparent[k]];
+  return glabel[k];
+}
+
+/* ----------------------------------------------------------------------
+   size, mass and centroid of each cluster
+   clusters within one proc are summed up locally, clusters spanning
+   procs are exactly the roots of the global forest and are summed up
+   with a single Allreduce
+   each cluster is stored by the proc that owns the atom with its ID
+------------------------------------------------------------------------- */
+
+void ComputeClusterAtom::cluster_stats()
+{
+  if (invoked_peratom != update->ntimestep) compute_peratom();
+  if (invoked_stats == update->ntimestep) return;
+  invoked_stats = update->ntimestep;
+
+  int *tag = atom->tag;
+  int *mask = atom->mask;
+  int *type = atom->type;
+  double *rmass = atom->rmass;
+  double *mass = atom->mass;
+  double **x = atom->x;
+  tagint *image = atom->image;
+  int nlocal = atom->nlocal;
+
+  // slots of clusters spanning procs
+
+  int nlabel = glabel.size();
+  std::vector<int> gslot(nlabel,-1);
+  int nshared = 0;
+  for (int k = 0; k < nlabel; k++)
+    if (gparent[k] == k) gslot[k] = nshared++;
+
+  // atoms of shared clusters use the slot of the global root
+  // all atoms of other clusters are on this proc, including the root atom
+  // root atoms own the cluster and get the next free slot
+
+  std::vector<int> slot(nlocal,-1);
+  std::vector<int> owner;
+  std::vector<std::pair<int,int> > rootbytag;
+  int nslot = nshared;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    int label = static_cast<int> (clusterID[i]);
+    std::vector<int>::iterator it =
+      std::lower_bound(glabel.begin(),glabel.end(),label);
+    if (it != glabel.end() && *it == label) slot[i] = gslot[it-glabel.begin()];
+    if (tag[i] == label) {
+      if (slot[i] < 0) slot[i] = nslot++;
+      owner.push_back(i);
+      rootbytag.push_back(std::make_pair(label,i));
+    }
+  }
+  std::sort(rootbytag.begin(),rootbytag.end());
+
+  double *sums = new double[5*(nslot > 0 ? nslot : 1)];
+  for (int k = 0; k < 5*nslot; k++) sums[k] = 0.0;
+
+  double unwrap[3],massone;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    int m = slot[i];
+    if (m < 0) {
+      int label = static_cast<int> (clusterID[i]);
+      std::vector<std::pair<int,int> >::iterator it =
+        std::lower_bound(rootbytag.begin(),rootbytag.end(),
+                         std::make_pair(label,-1));
+      if (it == rootbytag.end() || it->first != label) continue;
+      m = slot[it->second];
     }
+    if (rmass) massone = rmass[i];
+    else massone = mass[type[i]];
+    domain->unmap(x[i],image[i],unwrap);
+    sums[5*m] += 1.0;
+    sums[5*m+1] += massone;
+    sums[5*m+2] += massone*unwrap[0];
+    sums[5*m+3] += massone*unwrap[1];
+    sums[5*m+4] += massone*unwrap[2];
+  }
+
+  if (nshared) {
+    double *all = new double[5*nshared];
+    MPI_Allreduce(sums,all,5*nshared,MPI_DOUBLE,MPI_SUM,world);
+    for (int k = 0; k < 5*nshared; k++) sums[k] = all[k];
+    delete [] all;
+  }
+
+  // store owned clusters
+
+  ncluster = owner.size();
+  if (ncluster > maxcluster) {
+    memory->destroy(cluster);
+    maxcluster = ncluster + DELTA;
+    memory->create(cluster,maxcluster,size_local_cols,"cluster/atom:cluster");
+  }
+
+  for (int k = 0; k < ncluster; k++) {
+    int m = slot[owner[k]];
+    cluster[k][0] = tag[owner[k]];
+    cluster[k][1] = sums[5*m];
+    cluster[k][2] = sums[5*m+1];
+    if (sums[5*m+1] > 0.0) {
+      cluster[k][3] = sums[5*m+2]/sums[5*m+1];
+      cluster[k][4] = sums[5*m+3]/sums[5*m+1];
+      cluster[k][5] = sums[5*m+4]/sums[5*m+1];
+    } else cluster[k][3] = cluster[k][4] = cluster[k][5] = 0.0;
+  }
 
-    // stop if all procs are done
+  delete [] sums;
 
-    MPI_Allreduce(&change,&anychange,1,MPI_INT,MPI_MAX,world);
-    if (!anychange) break;
+  // histogram of cluster sizes, last bin holds all larger clusters
+
+  if (nbin) {
+    double *histo = new double[nbin];
+    for (int b = 0; b < nbin; b++) histo[b] = 0.0;
+    for (int k = 0; k < ncluster; k++) {
+      int b = static_cast<int> (cluster[k][1]) - 1;
+      if (b >= nbin) b = nbin-1;
+      histo[b] += 1.0;
+    }
+    MPI_Allreduce(histo,vector,nbin,MPI_DOUBLE,MPI_SUM,world);
+    delete [] histo;
   }
 }
 
 /* ---------------------------------------------------------------------- */
 
+void ComputeClusterAtom::compute_vector()
+{
+  invoked_vector = update->ntimestep;
+  cluster_stats();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeClusterAtom::compute_local()
+{
+  invoked_local = update->ntimestep;
+  cluster_stats();
+  size_local_rows = ncluster;
+  array_local = cluster;
+}
+
+/* ---------------------------------------------------------------------- */
+
 int ComputeClusterAtom::pack_comm(int n, int *list, double *buf,
                                   int pbc_flag, int *pbc)
 {
@@ -248,5 +601,7 @@ void ComputeClusterAtom::unpack_comm(int n, int first, double *buf)
 double ComputeClusterAtom::memory_usage()
 {
   double bytes = nmax * sizeof(double);
+  bytes += 2*nmax * sizeof(int);
+  bytes += maxcluster*size_local_cols * sizeof(double);
   return bytes;
 }
@@ -53,6 +53,7 @@ ComputeStyle(cluster/atom,ComputeClusterAtom)
 #define LMP_COMPUTE_CLUSTER_ATOM_H
 
 #include "compute.h"
+#include <vector>
 
 namespace LAMMPS_NS {
 
@@ -63,6 +64,8 @@ class ComputeClusterAtom : public Compute {
   void init();
   void init_list(int, class NeighList *);
   void compute_peratom();
+  void compute_vector();
+  void compute_local();
   int pack_comm(int, int *, double *, int, int *);
   void unpack_comm(int, int, double *);
   double memory_usage();
@@ -72,8 +75,28 @@ class ComputeClusterAtom : public Compute {
   double cutsq;
   class NeighList *list;
   double *clusterID;
-};
 
+  int contactflag;                // 1 if clusters are made of touching particles
+  double gap;                     // max surface distance for contactflag
+  class PairGran *pair_gran;
+
+  int *parent;                    // union-find forest over owned+ghost atoms
+  int *linked;                    // 1 if atom is linked to another atom
+
+  std::vector<int> glabel;        // sorted labels of clusters spanning procs
+  std::vector<int> gparent;       // union-find forest over glabel
+
+  int nbin;                       // # of bins of the cluster size histogram
+  int ncluster,maxcluster;        // # of clusters owned by this proc
+  double **cluster;               // size, mass, centroid of owned clusters
+  bigint invoked_stats;
+
+  void link(int, int);
+  int find(int);
+  int find_global(int);
+  void merge_global(int *);
+  void cluster_stats();
+};
 }
 
 #endif
@@ -96,6 +119,19 @@ E: Compute cluster/atom requires a pair style be defined
 This is so that the pair style defines a cutoff distance which
 is used to find clusters.
 
+E: Compute cluster/atom with contact yes requires atom style sphere
+
+Self-explanatory.
+
+E: Compute cluster/atom with contact yes requires a granular pair style
+
+The contacts are taken from the neighbor list of the granular
+pair style.
+
+E: Compute cluster/atom gap is larger than neighbor skin
+
+Particles with a larger gap may not be in the neighbor list.
+
 E: Compute cluster/atom cutoff is longer than pairwise cutoff
 
 Cannot identify clusters beyond cutoff.
@@ -75,7 +75,17 @@ ComputePairGranLocal::ComputePairGranLocal(LAMMPS *lmp, int &iarg, int narg, cha
 
   local_flag = 1;
   nmax = 0;
+  nvalues = 0;
   array = NULL;
+  rec_i = rec_j = NULL;
+  ipair = 0;
+  fmin = 0.;
+  capture_timestep = -1;
+
+  // record the steps this compute is invoked on
+  // so contacts can be captured during the regular force computation
+
+  timeflag = 1;
 
   // store everything by default expect heat flux
   posflag = velflag = idflag = fflag = torqueflag = histflag = areaflag = 1;
@@ -86,8 +96,14 @@ ComputePairGranLocal::ComputePairGranLocal(LAMMPS *lmp, int &iarg, int narg, cha
   //no extra distance for building the list of pairs
   verbose = false;
 
-  // if further args, store only the properties that are listed
-  if(narg > iarg)
+  // if further args other than options, store only the properties that are listed
+  bool fieldargs = false;
+  for (int jarg = iarg; jarg < narg; jarg++)
+  {
+    if (strcmp(arg[jarg],"fmin") == 0) jarg++;
+    else if (strcmp(arg[jarg],"verbose") != 0) fieldargs = true;
+  }
+  if(fieldargs)
      posflag = velflag = idflag = fflag = fnflag = ftflag = torqueflag = torquenflag = torquetflag = histflag = areaflag = deltaflag = heatflag = cpflag = msidflag = 0;
 
   for (; iarg < narg; iarg++)
@@ -109,6 +125,14 @@ ComputePairGranLocal::ComputePairGranLocal(LAMMPS *lmp, int &iarg, int narg, cha
     else if (strcmp(arg[iarg],"contactPoint") == 0) cpflag = 1;
     else if (strcmp(arg[iarg],"ms_id") == 0) msidflag = 1;
     else if (strcmp(arg[iarg],"verbose") == 0) verbose = true;
+    else if (strcmp(arg[iarg],"fmin") == 0)
+    {
+        if (iarg+1 >= narg)
+            error->compute_error(FLERR,this,"not enough arguments for keyword 'fmin'");
+        fmin = force->numeric(FLERR,arg[++iarg]);
+        if (fmin < 0.)
+            error->compute_error(FLERR,this,"fmin >= 0 required");
+    }
     else if (strcmp(arg[iarg],"extraSurfDistance") == 0) error->all(FLERR,"this keyword is deprecated; neighbor->contactDistanceFactor is now used directly");
     else if(0 == strcmp(style,"wall/gran/local") || 0 == strcmp(style,"pair/gran/local"))
         error->compute_error(FLERR,this,"illegal/unrecognized keyword");
@@ -132,6 +156,8 @@ ComputePairGranLocal::ComputePairGranLocal(LAMMPS *lmp, int &iarg, int narg, cha
 ComputePairGranLocal::~ComputePairGranLocal()
 {
   memory->destroy(array);
+  memory->destroy(rec_i);
+  memory->destroy(rec_j);
 
   if(reference_exists == 0) return;
 }
@@ -239,6 +265,9 @@ void ComputePairGranLocal::init_cpgl(bool requestflag)
           }
           if(!fixheat) error->all(FLERR,"Compute pair/gran/local can not calculate heat flux values since no fix heat/gran/conduction not compute them");
 
+          // heat fluxes are matched to the pairs by their order
+          if(fmin > 0.) error->all(FLERR,"Compute pair/gran/local can not use keyword fmin together with heatFlux");
+
           // group of this compute and heat transfer fix must be same so same number of pairs is computed
           if(groupbit != fixheat->groupbit) error->all(FLERR,"Compute pair/gran/local group and fix heat/gran/conduction group cannot be different");
           fixheat->register_compute_pair_local(this);
@@ -275,9 +304,18 @@ void ComputePairGranLocal::init_cpgl(bool requestflag)
   if(histflag && dnum == 0) error->all(FLERR,"Compute pair/gran/local or wall/gran/local can not calculate history values since pair or wall style does not compute them");
   // standard values: pos1,pos2,id1,id2,extra id for mesh wall,force,torque,contact area
 
+  int nvalues_old = nvalues;
   nvalues = posflag*6 + velflag*6 + idflag*3 + fflag*3 + fnflag*3 + ftflag*3 + torqueflag*3 + torquenflag*3 + torquetflag*3 + histflag*dnum + areaflag + deltaflag + heatflag + cpflag*3 + msidflag*2;
   size_local_cols = nvalues;
 
+  // buffer rows are kept across invocations, re-create if row length changed
+  if(array && nvalues != nvalues_old)
+  {
+      memory->destroy(array);
+      array_local = NULL;
+      nmax = 0;
+  }
+
 }
 
 /* ---------------------------------------------------------------------- */
@@ -303,15 +341,24 @@ void ComputePairGranLocal::compute_local()
 
   if(!reference_exists) error->one(FLERR,"Compute pair/gran/local or wall/gran/local reference does no longer exist (pair or fix deleted)");
 
-  // count local entries and compute pair info
+  // contacts were captured during the force computation of this step
+  // only velocities changed since then, heat fluxes are added as before
+
+  if(capture_timestep == update->ntimestep)
+  {
+      refresh_velocities();
+      if(wall == 0 && fixheat)
+      {
+          ipair = 0;
+          fixheat->cpl_evaluate(this);
+      }
+      return;
+  }
 
-  int nCountSurfacesIntersect(0);
-  if(wall == 0) ncount = count_pairs(nCountSurfacesIntersect);            // # pairs is ensured to be the same for pair and heat
-  else          ncount = count_wallcontacts(nCountSurfacesIntersect);     // # wall contacts ensured to be same for wall/gran and heat
+  // otherwise re-evaluate the contacts for the current state
+  // rows are added to the buffer as needed, size_local_rows is set in pair_finalize()
 
-  // only consider rows with overlap (but allocate memory for all)
-  if (ncount > nmax) reallocate(ncount);
-  size_local_rows = nCountSurfacesIntersect; 
+  size_local_rows = 0;
 
   // get pair data
   if(wall == 0)
@@ -337,77 +384,45 @@ void ComputePairGranLocal::compute_local()
 }
 
 /* ----------------------------------------------------------------------
-   count pairs on this proc
+   true if this compute is invoked on the current step
+   called by the pair style or wall fix before the regular force computation
 ------------------------------------------------------------------------- */
 
-int ComputePairGranLocal::count_pairs(int & nCountSurfacesIntersect)
+bool ComputePairGranLocal::capture_step()
 {
-  int i,j,m,n,ii,jj,inum,jnum;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
-  int *ilist,*jlist,*numneigh,**firstneigh;
-
-  double **x = atom->x;
-  double *radius = atom->radius;
-  int *mask = atom->mask;
-  int nlocal = atom->nlocal;
-  int nall = nlocal + atom->nghost;
-
-  //neighbor->build_one(list->index); 
-
-  list = pairgran->list; 
-  inum = list->inum;
-  ilist = list->ilist;
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
-
-  double contactDistanceFactorSqr = (neighbor->contactDistanceFactor+1e-16) * (neighbor->contactDistanceFactor+1e-16);
-
-  // loop over neighbors of my atoms
-  // skip if I or J are not in group
-
-  m = n = nCountSurfacesIntersect = 0;
-  for (ii = 0; ii < inum; ii++) {
-    i = ilist[ii];
-    if (!(mask[i] & groupbit)) continue;
-
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
-
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-
-      if (j >= nall) j %= nall;
-
-      if (!(mask[j] & groupbit)) continue;
-      if (newton_pair == 0 && j >= nlocal && atom->tag[i] <= atom->tag[j]) continue;
+  return reference_exists && matchstep(update->ntimestep);
+}
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-      
-      if (rsq <  (radius[i]+radius[j])*(radius[i]+radius[j])) nCountSurfacesIntersect++;
-      if (rsq > (radius[i]+radius[j])*(radius[i]+radius[j])*contactDistanceFactorSqr) continue;
-      m++;
-    }
-  }
-  if(verbose)
-      printf("ComputePairGranLocal::count_pairs: detected %d pairs , and %d pairs with surface intersection. \n",
-             m, nCountSurfacesIntersect);
+/* ---------------------------------------------------------------------- */
 
-  return m;
+void ComputePairGranLocal::begin_capture()
+{
+  ipair = 0;
+  capture_timestep = update->ntimestep;
 }
 
 /* ----------------------------------------------------------------------
-   count wall contacts on this proc
+   contacts captured during the force computation carry the velocities
+   of that point in time, update them to the ones at output
 ------------------------------------------------------------------------- */
 
-int ComputePairGranLocal::count_wallcontacts(int & nCountWithOverlap)
+void ComputePairGranLocal::refresh_velocities()
 {
-    return fixwall->n_contacts_local(groupbit, nCountWithOverlap);
+  if(!velflag) return;
+
+  double **v = atom->v;
+  const int offset = offset_v1();
+
+  for(int n = 0; n < size_local_rows; n++)
+  {
+      if(wall == 0)
+      {
+          vectorCopy3D(v[rec_i[n]],&array[n][offset]);
+          vectorCopy3D(v[rec_j[n]],&array[n][offset+3]);
+      }
+      else
+          vectorCopy3D(v[rec_i[n]],&array[n][offset+3]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -436,11 +451,12 @@ void ComputePairGranLocal::add_pair(int i,int j,double fx,double fy,double fz,do
     vi = atom->v[i];
     vj = atom->v[j];
 
-    if(ipair>=nmax)
-    {
-        if(screen) fprintf(screen,"ipair: %d, ncount: %d. \n", ipair, ncount);
-        error->one(FLERR,"Attempt to add_pair, but number of pairs (nmax) is too small. Try to increase contact_distance_factor via an appropriate neigh_modify command!");
-    }
+    if(fmin > 0. && fx*fx+fy*fy+fz*fz < fmin*fmin)
+        return;
+
+    if(ipair >= nmax) reallocate(ipair+1);
+    rec_i[ipair] = i;
+    rec_j[ipair] = j;
 
     int n = 0;
     if(posflag)
@@ -649,6 +665,10 @@ void ComputePairGranLocal::add_wall_1(int iFMG,int idTri,int iP,double *contact_
 {
     if (!(atom->mask[iP] & groupbit)) return;
 
+    if(ipair >= nmax) reallocate(ipair+1);
+    rec_i[ipair] = iP;
+    rec_j[ipair] = -1;
+
     int n = 0;
 
     if(posflag)
@@ -753,6 +773,9 @@ void ComputePairGranLocal::add_wall_2(int i,double fx,double fy,double fz,double
     if(!decide_add(hist, contact_pos))
         return;
 
+    if(fmin > 0. && fx*fx+fy*fy+fz*fz < fmin*fmin)
+        return;
+
     if(posflag)
     {
         if (contact_pos)
@@ -887,12 +910,16 @@ void ComputePairGranLocal::add_heat_wall(int ip,double hf)
 
 void ComputePairGranLocal::reallocate(int n)
 {
-  // grow vector or array and indices array
+  // grow rows keeping the ones already added
+  // buffer is kept across invocations, so this only happens
+  // while the number of contacts on this proc reaches a new maximum
+  // grow geometrically so a large first fill does not copy O(n^2/DELTA)
 
-  while (nmax < n) nmax += DELTA;
+  nmax = MAX(n,MAX(2*nmax,DELTA));
 
-  memory->destroy(array);
-  memory->create(array,nmax,nvalues,"pair/local:array");
+  memory->grow(array,nmax,nvalues,"pair/local:array");
+  memory->grow(rec_i,nmax,"pair/local:rec_i");
+  memory->grow(rec_j,nmax,"pair/local:rec_j");
   array_local = array;
 }
 
@@ -903,6 +930,7 @@ void ComputePairGranLocal::reallocate(int n)
 double ComputePairGranLocal::memory_usage()
 {
   double bytes = nmax*nvalues * sizeof(double);
+  bytes += 2*nmax * sizeof(int);
   return bytes;
 }
 
@@ -77,6 +77,8 @@ class ComputePairGranLocal : public Compute {
   virtual void add_heat_wall(int i,double hf);
 
   virtual void pair_finalize();
+  bool capture_step();
+  void begin_capture();
   int get_history_offset(const char * const name);
 
   /* inline access */
@@ -160,11 +162,9 @@ class ComputePairGranLocal : public Compute {
  protected:
 
   int nvalues;      // number of double values per entry
-  int ncount;       // count of eligible pair - all who are eligible for surfacesIntersect or surfacesClose
 
   int ncount_added_via_pair; // count actually added via call from pair_gran
-                             // might be lower than ncount because is based on hasForceUpdate occurrences
-                             // not all the surfacesClose calls have hasForceUpdate=true
+                             // based on hasForceUpdate occurrences
 
   int newton_pair;
 
@@ -188,17 +188,20 @@ class ComputePairGranLocal : public Compute {
 
   bool   verbose;
 
+  double fmin;                // contacts with smaller force are not stored
+  bigint capture_timestep;    // step of contacts captured in regular force computation
+
   int dnum;
 
   int nmax;
   double *vector;
   double **array;
+  int *rec_i,*rec_j;          // particles of each row, j = -1 for walls
 
   class NeighList *list;
 
-  virtual int count_pairs(int &nCountWithOverlap);
-  int count_wallcontacts(int &nCountWithOverlap);
   void reallocate(int);
+  void refresh_velocities();
 };
 
 }
@@ -189,7 +189,8 @@ void DumpLocal::init_style()
 
   // setup function ptrs
 
-  if (buffer_flag == 1) write_choice = &DumpLocal::write_string;
+  if (binary) write_choice = &DumpLocal::write_binary;
+  else if (buffer_flag == 1) write_choice = &DumpLocal::write_string;
   else write_choice = &DumpLocal::write_lines;
 
   // find current ptr for each compute,fix,variable
@@ -235,6 +236,11 @@ int DumpLocal::modify_param(int narg, char **arg)
 
 void DumpLocal::write_header(bigint ndump)
 {
+  if (binary) {
+    if (multiproc || me == 0) header_binary(ndump);
+    return;
+  }
+
   if (me == 0) {
     fprintf(fp,"ITEM: TIMESTEP\n");
     fprintf(fp,BIGINT_FORMAT "\n",update->ntimestep);
@@ -255,6 +261,32 @@ void DumpLocal::write_header(bigint ndump)
   }
 }
 
+/* ----------------------------------------------------------------------
+   same layout as binary dump custom files, so tools/binary2txt reads them
+------------------------------------------------------------------------- */
+
+void DumpLocal::header_binary(bigint ndump)
+{
+  fwrite(&update->ntimestep,sizeof(bigint),1,fp);
+  fwrite(&ndump,sizeof(bigint),1,fp);
+  fwrite(&domain->triclinic,sizeof(int),1,fp);
+  fwrite(&domain->boundary[0][0],6*sizeof(int),1,fp);
+  fwrite(&boxxlo,sizeof(double),1,fp);
+  fwrite(&boxxhi,sizeof(double),1,fp);
+  fwrite(&boxylo,sizeof(double),1,fp);
+  fwrite(&boxyhi,sizeof(double),1,fp);
+  fwrite(&boxzlo,sizeof(double),1,fp);
+  fwrite(&boxzhi,sizeof(double),1,fp);
+  if (domain->triclinic) {
+    fwrite(&boxxy,sizeof(double),1,fp);
+    fwrite(&boxxz,sizeof(double),1,fp);
+    fwrite(&boxyz,sizeof(double),1,fp);
+  }
+  fwrite(&size_one,sizeof(int),1,fp);
+  if (multiproc) fwrite(&nclusterprocs,sizeof(int),1,fp);
+  else fwrite(&nprocs,sizeof(int),1,fp);
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpLocal::count()
@@ -348,6 +380,15 @@ void DumpLocal::write_string(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
+void DumpLocal::write_binary(int n, double *mybuf)
+{
+  n *= size_one;
+  fwrite(&n,sizeof(int),1,fp);
+  fwrite(mybuf,sizeof(double),n,fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void DumpLocal::write_lines(int n, double *mybuf)
 {
   int i,j;
@@ -88,6 +88,7 @@ class DumpLocal : public Dump {
   void init_style();
   int modify_param(int, char **);
   void write_header(bigint);
+  void header_binary(bigint);
   int count();
   void pack(int *);
   int convert_string(int, double *);
@@ -101,6 +102,7 @@ class DumpLocal : public Dump {
   FnPtrWrite write_choice;             // ptr to write data functions
   void write_string(int, double *);
   void write_lines(int, double *);
+  void write_binary(int, double *);
 
   // customize by adding a method prototype
 
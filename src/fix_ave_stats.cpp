@@ -0,0 +1,711 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+#include "fix_ave_stats.h"
+#include "atom.h"
+#include "update.h"
+#include "modify.h"
+#include "compute.h"
+#include "group.h"
+#include "input.h"
+#include "variable.h"
+#include "memory.h"
+#include "error.h"
+#include "force.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+enum{X,V,F,RADIUS,MASS,COMPUTE,FIX,VARIABLE};
+enum{PERATOM,LOCAL};
+enum{SUM,MIN,MAX,AVE,STD,HISTO,PERCENTILE};
+
+#define BIG 1.0e20
+
+static const char *stylename[] = {"sum","min","max","ave","std","histo","p"};
+
+/* ---------------------------------------------------------------------- */
+
+FixAveStats::FixAveStats(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg),
+  ninputs(0),
+  nstats(0),
+  ncolumns(0),
+  inputs(NULL),
+  stats(NULL),
+  statlist(NULL),
+  nsum(0),
+  nmax(0),
+  sum_(NULL),
+  sum_all_(NULL),
+  max_(NULL),
+  max_all_(NULL),
+  vector(NULL),
+  scratch(NULL),
+  maxscratch(0),
+  fp(NULL),
+  binary(0)
+{
+  if (narg < 6) error->all(FLERR,"Illegal fix ave/stats command");
+
+  MPI_Comm_rank(world,&me);
+
+  nevery = force->inumeric(FLERR,arg[3]);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix ave/stats command");
+
+  // each statistic has at least one argument, so narg bounds the counts
+
+  inputs = new Input[narg];
+  stats = new Stat[narg];
+
+  // parse statistics until one isn't recognized
+
+  int iarg = 4;
+  while (iarg < narg) {
+    Stat &st = stats[nstats];
+    st.lo = st.hi = st.bininv = st.p = 0.;
+    st.nbins = 0;
+
+    if (strcmp(arg[iarg],"sum") == 0) st.style = SUM;
+    else if (strcmp(arg[iarg],"min") == 0) st.style = MIN;
+    else if (strcmp(arg[iarg],"max") == 0) st.style = MAX;
+    else if (strcmp(arg[iarg],"ave") == 0) st.style = AVE;
+    else if (strcmp(arg[iarg],"std") == 0) st.style = STD;
+    else if (strcmp(arg[iarg],"histo") == 0) st.style = HISTO;
+    else if (strcmp(arg[iarg],"percentile") == 0) st.style = PERCENTILE;
+    else break;
+
+    if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/stats command");
+    st.input = parse_input(arg[iarg+1]);
+    iarg += 2;
+
+    if (st.style == PERCENTILE) {
+      if (iarg+1 > narg) error->all(FLERR,"Illegal fix ave/stats command");
+      st.p = force->numeric(FLERR,arg[iarg]);
+      if (st.p < 0. || st.p > 100.)
+        error->all(FLERR,"Fix ave/stats percentile must be between 0 and 100");
+      iarg++;
+    }
+    if (st.style == HISTO || st.style == PERCENTILE) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix ave/stats command");
+      st.lo = force->numeric(FLERR,arg[iarg]);
+      st.hi = force->numeric(FLERR,arg[iarg+1]);
+      st.nbins = force->inumeric(FLERR,arg[iarg+2]);
+      if (st.lo >= st.hi || st.nbins <= 0)
+        error->all(FLERR,"Illegal fix ave/stats command");
+      st.bininv = st.nbins/(st.hi-st.lo);
+      iarg += 3;
+    }
+    nstats++;
+  }
+
+  if (nstats == 0) error->all(FLERR,"Illegal fix ave/stats command");
+
+  // optional keywords
+
+  char *filename = NULL;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"file") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/stats command");
+      filename = arg[iarg+1];
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"format") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/stats command");
+      if (strcmp(arg[iarg+1],"csv") == 0) binary = 0;
+      else if (strcmp(arg[iarg+1],"binary") == 0) binary = 1;
+      else error->all(FLERR,"Illegal fix ave/stats command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix ave/stats command");
+  }
+
+  // layout of the reduction buffers and of the output vector
+  // histograms have an underflow and an overflow bin for percentiles
+
+  statlist = new int[nstats];
+  int nlist = 0;
+  for (int k = 0; k < ninputs; k++) {
+    inputs[k].count = nsum++;
+    inputs[k].first = nlist;
+    for (int s = 0; s < nstats; s++)
+      if (stats[s].input == k) statlist[nlist++] = s;
+    inputs[k].nstat = nlist - inputs[k].first;
+  }
+
+  for (int s = 0; s < nstats; s++) {
+    Stat &st = stats[s];
+    st.column = ncolumns;
+    if (st.style == MIN || st.style == MAX) {
+      st.offset = nmax++;
+    } else {
+      st.offset = nsum;
+      if (st.style == STD) nsum += 2;
+      else if (st.style == HISTO || st.style == PERCENTILE) nsum += st.nbins+2;
+      else nsum++;
+    }
+    ncolumns += (st.style == HISTO) ? st.nbins : 1;
+  }
+
+  memory->create(sum_,nsum,"ave/stats:sum");
+  memory->create(sum_all_,nsum,"ave/stats:sum_all");
+  if (nmax) {
+    memory->create(max_,nmax,"ave/stats:max");
+    memory->create(max_all_,nmax,"ave/stats:max_all");
+  }
+  memory->create(vector,ncolumns,"ave/stats:vector");
+  for (int i = 0; i < ncolumns; i++) vector[i] = 0.;
+
+  // sums and histogram counts are extensive, all others intensive
+
+  global_freq = nevery;
+  vector_flag = 1;
+  size_vector = ncolumns;
+  extvector = -1;
+  extlist = new int[ncolumns];
+  for (int s = 0; s < nstats; s++) {
+    const int n = (stats[s].style == HISTO) ? stats[s].nbins : 1;
+    const int ext = (stats[s].style == SUM || stats[s].style == HISTO) ? 1 : 0;
+    for (int i = 0; i < n; i++) extlist[stats[s].column+i] = ext;
+  }
+
+  if (filename && me == 0) {
+    fp = fopen(filename,binary ? "wb" : "w");
+    if (fp == NULL) {
+      char str[512];
+      sprintf(str,"Cannot open fix ave/stats file %s",filename);
+      error->one(FLERR,str);
+    }
+    write_header();
+  }
+
+  // nvalid = next step on which end_of_step does something
+
+  nvalid = nextvalid();
+  modify->addstep_compute_all(nvalid);
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixAveStats::~FixAveStats()
+{
+  for (int k = 0; k < ninputs; k++) {
+    delete [] inputs[k].name;
+    delete [] inputs[k].id;
+  }
+  delete [] inputs;
+  delete [] stats;
+  delete [] statlist;
+  delete [] extlist;
+
+  memory->destroy(sum_);
+  memory->destroy(sum_all_);
+  memory->destroy(max_);
+  memory->destroy(max_all_);
+  memory->destroy(vector);
+  memory->destroy(scratch);
+
+  if (fp && me == 0) fclose(fp);
+}
+
+/* ----------------------------------------------------------------------
+   find or add the input with this name, return its index
+------------------------------------------------------------------------- */
+
+int FixAveStats::parse_input(const char *str)
+{
+  for (int k = 0; k < ninputs; k++)
+    if (strcmp(inputs[k].name,str) == 0) return k;
+
+  Input &in = inputs[ninputs];
+  in.name = new char[strlen(str)+1];
+  strcpy(in.name,str);
+  in.id = NULL;
+  in.index = -1;
+  in.argindex = 0;
+  in.kind = PERATOM;
+
+  if (strcmp(str,"x") == 0) { in.which = X; in.argindex = 0; }
+  else if (strcmp(str,"y") == 0) { in.which = X; in.argindex = 1; }
+  else if (strcmp(str,"z") == 0) { in.which = X; in.argindex = 2; }
+  else if (strcmp(str,"vx") == 0) { in.which = V; in.argindex = 0; }
+  else if (strcmp(str,"vy") == 0) { in.which = V; in.argindex = 1; }
+  else if (strcmp(str,"vz") == 0) { in.which = V; in.argindex = 2; }
+  else if (strcmp(str,"fx") == 0) { in.which = F; in.argindex = 0; }
+  else if (strcmp(str,"fy") == 0) { in.which = F; in.argindex = 1; }
+  else if (strcmp(str,"fz") == 0) { in.which = F; in.argindex = 2; }
+  else if (strcmp(str,"radius") == 0) {
+    if (!atom->radius_flag)
+      error->all(FLERR,"Fix ave/stats radius requires atom attribute radius");
+    in.which = RADIUS;
+  } else if (strcmp(str,"mass") == 0) in.which = MASS;
+  else if (strncmp(str,"c_",2) == 0 || strncmp(str,"f_",2) == 0 ||
+           strncmp(str,"v_",2) == 0) {
+    if (str[0] == 'c') in.which = COMPUTE;
+    else if (str[0] == 'f') in.which = FIX;
+    else in.which = VARIABLE;
+
+    int n = strlen(str);
+    in.id = new char[n];
+    strcpy(in.id,&str[2]);
+
+    char *ptr = strchr(in.id,'[');
+    if (ptr) {
+      if (in.id[strlen(in.id)-1] != ']')
+        error->all(FLERR,"Illegal fix ave/stats command");
+      in.argindex = atoi(ptr+1);
+      *ptr = '\0';
+    }
+
+    if (in.which == COMPUTE) {
+      int icompute = modify->find_compute(in.id);
+      if (icompute < 0)
+        error->all(FLERR,"Compute ID for fix ave/stats does not exist");
+      Compute *compute = modify->compute[icompute];
+      int ncols;
+      if (compute->peratom_flag) ncols = compute->size_peratom_cols;
+      else if (compute->local_flag) {
+        in.kind = LOCAL;
+        ncols = compute->size_local_cols;
+      } else error->all(FLERR,"Fix ave/stats compute does not "
+                        "calculate per-atom or local values");
+      if (in.argindex == 0 && ncols != 0)
+        error->all(FLERR,"Fix ave/stats compute does not calculate a vector");
+      if (in.argindex && ncols == 0)
+        error->all(FLERR,"Fix ave/stats compute does not calculate an array");
+      if (in.argindex > ncols)
+        error->all(FLERR,"Fix ave/stats compute array is accessed out-of-range");
+
+    } else if (in.which == FIX) {
+      int ifix = modify->find_fix(in.id);
+      if (ifix < 0)
+        error->all(FLERR,"Fix ID for fix ave/stats does not exist");
+      Fix *fix = modify->fix[ifix];
+      int ncols,freq;
+      if (fix->peratom_flag) {
+        ncols = fix->size_peratom_cols;
+        freq = fix->peratom_freq;
+      } else if (fix->local_flag) {
+        in.kind = LOCAL;
+        ncols = fix->size_local_cols;
+        freq = fix->local_freq;
+      } else error->all(FLERR,"Fix ave/stats fix does not "
+                        "calculate per-atom or local values");
+      if (in.argindex == 0 && ncols != 0)
+        error->all(FLERR,"Fix ave/stats fix does not calculate a vector");
+      if (in.argindex && ncols == 0)
+        error->all(FLERR,"Fix ave/stats fix does not calculate an array");
+      if (in.argindex > ncols)
+        error->all(FLERR,"Fix ave/stats fix array is accessed out-of-range");
+      if (nevery % freq)
+        error->all(FLERR,"Fix for fix ave/stats not computed at compatible time");
+
+    } else {
+      int ivariable = input->variable->find(in.id);
+      if (ivariable < 0)
+        error->all(FLERR,"Variable name for fix ave/stats does not exist");
+      if (input->variable->atomstyle(ivariable) == 0)
+        error->all(FLERR,"Fix ave/stats variable is not atom-style variable");
+    }
+  } else error->all(FLERR,"Illegal fix ave/stats command");
+
+  return ninputs++;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixAveStats::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAveStats::init()
+{
+  // set current indices for all computes,fixes,variables
+
+  for (int k = 0; k < ninputs; k++) {
+    Input &in = inputs[k];
+    if (in.which == COMPUTE) {
+      in.index = modify->find_compute(in.id);
+      if (in.index < 0)
+        error->all(FLERR,"Compute ID for fix ave/stats does not exist");
+    } else if (in.which == FIX) {
+      in.index = modify->find_fix(in.id);
+      if (in.index < 0)
+        error->all(FLERR,"Fix ID for fix ave/stats does not exist");
+    } else if (in.which == VARIABLE) {
+      in.index = input->variable->find(in.id);
+      if (in.index < 0)
+        error->all(FLERR,"Variable name for fix ave/stats does not exist");
+    }
+  }
+
+  // need to reset nvalid if nvalid < ntimestep b/c minimize was performed
+
+  if (nvalid < update->ntimestep) {
+    nvalid = nextvalid();
+    modify->addstep_compute_all(nvalid);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   only does something if nvalid = current timestep
+------------------------------------------------------------------------- */
+
+void FixAveStats::setup(int vflag)
+{
+  end_of_step();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAveStats::end_of_step()
+{
+  bigint ntimestep = update->ntimestep;
+  if (ntimestep != nvalid) return;
+
+  for (int i = 0; i < nsum; i++) sum_[i] = 0.;
+  for (int i = 0; i < nmax; i++) max_[i] = -BIG;
+
+  // one sweep over the values of each input, updating all its statistics
+  // compute/fix/variable may invoke computes so wrap with clear/add
+
+  modify->clearstep_compute();
+
+  const int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  for (int k = 0; k < ninputs; k++) {
+    Input &in = inputs[k];
+    const int j = in.argindex;
+    const double *values = NULL;
+    int stride = 1;
+    int n = nlocal;
+
+    if (in.which == X || in.which == V || in.which == F) {
+      double **x = in.which == X ? atom->x : (in.which == V ? atom->v : atom->f);
+      if (nlocal) values = &x[0][j];
+      stride = 3;
+
+    } else if (in.which == RADIUS) {
+      values = atom->radius;
+
+    } else if (in.which == MASS) {
+      if (atom->rmass) values = atom->rmass;
+      else {
+        if (nlocal > maxscratch) {
+          memory->destroy(scratch);
+          maxscratch = atom->nmax;
+          memory->create(scratch,maxscratch,"ave/stats:scratch");
+        }
+        double *mass = atom->mass;
+        int *type = atom->type;
+        for (int i = 0; i < nlocal; i++) scratch[i] = mass[type[i]];
+        values = scratch;
+      }
+
+    } else if (in.which == COMPUTE) {
+      Compute *compute = modify->compute[in.index];
+      if (in.kind == PERATOM) {
+        if (!(compute->invoked_flag & INVOKED_PERATOM)) {
+          compute->compute_peratom();
+          compute->invoked_flag |= INVOKED_PERATOM;
+        }
+        if (j == 0) values = compute->vector_atom;
+        else if (compute->array_atom && nlocal) {
+          values = &compute->array_atom[0][j-1];
+          stride = compute->size_peratom_cols;
+        }
+      } else {
+        if (!(compute->invoked_flag & INVOKED_LOCAL)) {
+          compute->compute_local();
+          compute->invoked_flag |= INVOKED_LOCAL;
+        }
+        n = compute->size_local_rows;
+        if (j == 0) values = compute->vector_local;
+        else if (compute->array_local && n) {
+          values = &compute->array_local[0][j-1];
+          stride = compute->size_local_cols;
+        }
+      }
+
+      // access fix fields, guaranteed to be ready
+
+    } else if (in.which == FIX) {
+      Fix *fix = modify->fix[in.index];
+      if (in.kind == PERATOM) {
+        if (j == 0) values = fix->vector_atom;
+        else if (fix->array_atom && nlocal) {
+          values = &fix->array_atom[0][j-1];
+          stride = fix->size_peratom_cols;
+        }
+      } else {
+        n = fix->size_local_rows;
+        if (j == 0) values = fix->vector_local;
+        else if (fix->array_local && n) {
+          values = &fix->array_local[0][j-1];
+          stride = fix->size_local_cols;
+        }
+      }
+
+    } else if (in.which == VARIABLE) {
+      if (atom->nmax > maxscratch) {
+        memory->destroy(scratch);
+        maxscratch = atom->nmax;
+        memory->create(scratch,maxscratch,"ave/stats:scratch");
+      }
+      input->variable->compute_atom(in.index,igroup,scratch,1,0);
+      values = scratch;
+    }
+
+    if (values && n > 0)
+      accumulate(k,values,stride,n,in.kind == PERATOM ? mask : NULL);
+  }
+
+  // all statistics are combined in at most two collectives
+
+  MPI_Allreduce(sum_,sum_all_,nsum,MPI_DOUBLE,MPI_SUM,world);
+  if (nmax) MPI_Allreduce(max_,max_all_,nmax,MPI_DOUBLE,MPI_MAX,world);
+
+  finalize();
+  if (fp && me == 0) write_row();
+
+  nvalid += nevery;
+  modify->addstep_compute(nvalid);
+}
+
+/* ----------------------------------------------------------------------
+   add n values of input k to the local buffers
+   values are read with stride, per-atom values only for atoms in group
+------------------------------------------------------------------------- */
+
+void FixAveStats::accumulate(int k, const double *values, int stride, int n,
+                             const int *mask)
+{
+  double * const s = sum_;
+  double * const m = max_;
+  const int count = inputs[k].count;
+  const int * const slist = &statlist[inputs[k].first];
+  const int ns = inputs[k].nstat;
+
+  for (int i = 0; i < n; i++) {
+    if (mask && !(mask[i] & groupbit)) continue;
+    const double v = values[i*stride];
+    s[count] += 1.;
+
+    for (int is = 0; is < ns; is++) {
+      const Stat &st = stats[slist[is]];
+      const int o = st.offset;
+
+      switch (st.style) {
+        case SUM:
+        case AVE:
+          s[o] += v;
+          break;
+        case STD:
+          s[o] += v;
+          s[o+1] += v*v;
+          break;
+        case MIN:
+          if (-v > m[o]) m[o] = -v;
+          break;
+        case MAX:
+          if (v > m[o]) m[o] = v;
+          break;
+        default:
+          if (v < st.lo) s[o] += 1.;
+          else if (v >= st.hi) s[o+st.nbins+1] += 1.;
+          else {
+            int ibin = static_cast<int>((v-st.lo)*st.bininv);
+            if (ibin >= st.nbins) ibin = st.nbins-1;
+            s[o+1+ibin] += 1.;
+          }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   turn the reduced buffers into the output values
+------------------------------------------------------------------------- */
+
+void FixAveStats::finalize()
+{
+  for (int is = 0; is < nstats; is++) {
+    const Stat &st = stats[is];
+    const double count = sum_all_[inputs[st.input].count];
+    const double *s = &sum_all_[st.offset];
+    double *vec = &vector[st.column];
+
+    switch (st.style) {
+      case SUM:
+        vec[0] = s[0];
+        break;
+      case AVE:
+        vec[0] = count > 0. ? s[0]/count : 0.;
+        break;
+      case STD:
+        if (count > 0.) {
+          const double mean = s[0]/count;
+          vec[0] = sqrt(MAX(s[1]/count - mean*mean,0.));
+        } else vec[0] = 0.;
+        break;
+      case MIN:
+        vec[0] = count > 0. ? -max_all_[st.offset] : 0.;
+        break;
+      case MAX:
+        vec[0] = count > 0. ? max_all_[st.offset] : 0.;
+        break;
+      case HISTO:
+        for (int ibin = 0; ibin < st.nbins; ibin++) vec[ibin] = s[1+ibin];
+        break;
+      case PERCENTILE:
+        vec[0] = percentile(st,s);
+        break;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   percentile estimated from the histogram h, linear within the bin
+   h[0] and h[nbins+1] count the values below lo and above hi
+------------------------------------------------------------------------- */
+
+double FixAveStats::percentile(const Stat &st, const double *h)
+{
+  double total = 0.;
+  for (int ibin = 0; ibin < st.nbins+2; ibin++) total += h[ibin];
+  if (total == 0.) return 0.;
+
+  const double target = 0.01*st.p*total;
+  double cumulative = h[0];
+  if (target <= cumulative) return st.lo;
+
+  for (int ibin = 0; ibin < st.nbins; ibin++) {
+    const double hb = h[1+ibin];
+    if (hb > 0. && cumulative + hb >= target)
+      return st.lo + (ibin + (target-cumulative)/hb)/st.bininv;
+    cumulative += hb;
+  }
+  return st.hi;
+}
+
+/* ----------------------------------------------------------------------
+   csv: one line with the column names
+   binary: 8 byte tag LGSTATS1, int32 number of columns, then for each
+   column an int32 name length and the name without terminating zero
+------------------------------------------------------------------------- */
+
+void FixAveStats::write_header()
+{
+  char name[256];
+  const int32_t ncol = ncolumns;
+
+  if (binary) {
+    fwrite("LGSTATS1",sizeof(char),8,fp);
+    fwrite(&ncol,sizeof(int32_t),1,fp);
+  } else fprintf(fp,"step");
+
+  for (int is = 0; is < nstats; is++) {
+    const Stat &st = stats[is];
+    const int n = (st.style == HISTO) ? st.nbins : 1;
+    for (int i = 0; i < n; i++) {
+      if (st.style == HISTO)
+        snprintf(name,sizeof(name),"histo(%s)[%d]",inputs[st.input].name,i+1);
+      else if (st.style == PERCENTILE)
+        snprintf(name,sizeof(name),"p%g(%s)",st.p,inputs[st.input].name);
+      else
+        snprintf(name,sizeof(name),"%s(%s)",stylename[st.style],inputs[st.input].name);
+
+      if (binary) {
+        const int32_t len = strlen(name);
+        fwrite(&len,sizeof(int32_t),1,fp);
+        fwrite(name,sizeof(char),len,fp);
+      } else fprintf(fp,",%s",name);
+    }
+  }
+
+  if (!binary) fprintf(fp,"\n");
+  fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   csv: step and all columns in one line
+   binary: int64 step followed by all columns as doubles
+------------------------------------------------------------------------- */
+
+void FixAveStats::write_row()
+{
+  if (binary) {
+    const int64_t step = update->ntimestep;
+    fwrite(&step,sizeof(int64_t),1,fp);
+    fwrite(vector,sizeof(double),ncolumns,fp);
+  } else {
+    fprintf(fp,BIGINT_FORMAT,update->ntimestep);
+    for (int i = 0; i < ncolumns; i++) fprintf(fp,",%.10g",vector[i]);
+    fprintf(fp,"\n");
+  }
+  fflush(fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixAveStats::compute_vector(int i)
+{
+  return vector[i];
+}
+
+/* ----------------------------------------------------------------------
+   calculate nvalid = next step on which end_of_step does something
+   can be this timestep if multiple of nevery
+------------------------------------------------------------------------- */
+
+bigint FixAveStats::nextvalid()
+{
+  bigint nvalid = (update->ntimestep/nevery)*nevery;
+  if (nvalid < update->ntimestep) nvalid += nevery;
+  return nvalid;
+}
@@ -0,0 +1,124 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(ave/stats,FixAveStats)
+
+#else
+
+#ifndef LMP_FIX_AVE_STATS_H
+#define LMP_FIX_AVE_STATS_H
+
+#include <stdio.h>
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixAveStats : public Fix {
+ public:
+  FixAveStats(class LAMMPS *, int, char **);
+  ~FixAveStats();
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  double compute_vector(int);
+
+ private:
+
+  // one per distinct per-atom or local input, shared by all its statistics
+
+  struct Input {
+    char *name;       // as given in the command, for column names
+    int which;        // X, V, F, RADIUS, MASS, COMPUTE, FIX or VARIABLE
+    int argindex;     // component / column, 0 for a vector
+    char *id;         // compute, fix or variable name
+    int index;        // index of compute, fix or variable
+    int kind;         // PERATOM or LOCAL
+    int count;        // offset of the value count in sum_
+    int first,nstat;  // its statistics in statlist
+  };
+
+  struct Stat {
+    int style;        // SUM, MIN, MAX, AVE, STD, HISTO or PERCENTILE
+    int input;
+    double lo,hi,bininv;
+    int nbins;
+    double p;         // percentile in percent
+    int offset;       // offset in sum_ (or in max_ for MIN, MAX)
+    int column;       // 1st column in vector
+  };
+
+  int ninputs,nstats,ncolumns;
+  Input *inputs;
+  Stat *stats;
+  int *statlist;       // statistics sorted by input
+
+  // all partial results are packed into two buffers, reduced with one
+  // MPI_SUM and one MPI_MAX collective per output step, min is stored negated
+
+  int nsum,nmax;
+  double *sum_,*sum_all_;
+  double *max_,*max_all_;
+
+  double *vector;      // final values of all columns
+  double *scratch;     // per-atom values of mass and atom-style variables
+  int maxscratch;
+
+  int me;
+  FILE *fp;
+  int binary;
+  bigint nvalid;
+
+  int parse_input(const char *);
+  void accumulate(int, const double *, int, int, const int *);
+  void finalize();
+  void write_header();
+  void write_row();
+  double percentile(const Stat &, const double *);
+  bigint nextvalid();
+};
+
+}
+
+#endif
+#endif
@@ -105,7 +105,7 @@ FixCfdCoupling::FixCfdCoupling(LAMMPS *lmp, int narg, char **arg) :
   else if (strcmp(arg[iarg_],#key) == 0) dc_ = new Class(lmp,iarg_+1,narg,arg,this);
   #include "style_cfd_datacoupling.h"
   #undef CFD_DATACOUPLING_CLASS
-  else error->fix_error(FLERR,this,"Unknown data coupling style - expecting 'file' or 'MPI'");
+  else error->fix_error(FLERR,this,"Unknown data coupling style - expecting 'file', 'MPI' or 'shm'");
 
   if(!dynamic_cast<CfdDatacouplingMPI*>(dc_) && 0 == couple_nevery_)
     error->fix_error(FLERR,this,"expecting keyword 'couple_every' ");
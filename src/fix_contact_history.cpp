@@ -83,12 +83,20 @@ FixContactHistory::FixContactHistory(LAMMPS *lmp, int narg, char **arg) :
   partner_(0),
   contacthistory_(0),
   maxtouch_(0),
+  adoptflag_(0),
+  adopted_(0),
+  partnerhist_(0),
+  partnerflip_(0),
+  ownhist_(0),
   pair_gran_(0),
   computeflag_(0),
   pgsize_(0),
   oneatom_(0),
   ipage_(0),
-  dpage_(0)
+  dpage_(0),
+  hpage_(0),
+  lpage_(0),
+  spage_(0)
 {
   restart_global = 1;
   restart_peratom = 1;
@@ -135,6 +143,8 @@ FixContactHistory::FixContactHistory(LAMMPS *lmp, int narg, char **arg) :
   if(dnum_ < 0)
     error->fix_error(FLERR,this,"dnum must be >=0");
 
+  adoptflag_ = (strcmp(style,"contacthistory") == 0) ? 1 : 0;
+
   // do not proceed for derived classes
   
   if(!strstr(style,"property") && strcmp(style,"contacthistory"))
@@ -177,8 +187,14 @@ FixContactHistory::~FixContactHistory()
   memory->destroy(npartner_);
   memory->sfree(partner_);
   memory->sfree(contacthistory_);
+  memory->sfree(partnerhist_);
+  memory->sfree(partnerflip_);
+  memory->sfree(ownhist_);
   if(ipage_) delete [] ipage_;
   if(dpage_) delete [] dpage_;
+  if(hpage_) delete [] hpage_;
+  if(lpage_) delete [] lpage_;
+  if(spage_) delete [] spage_;
 
   if(variablename_) delete [] variablename_;
   if(newtonflag_) delete [] newtonflag_;
@@ -247,6 +263,10 @@ void FixContactHistory::init()
 /* ----------------------------------------------------------------------
   create pages if first time or if neighbor pgsize/oneatom has changed
   note that latter could cause shear history info to be discarded
+  lpage_ is set up exactly like the history pages of the neigh list
+  so the two can be swapped in pre_exchange()
+  if history is kept by reference, copied values go to spage_ instead
+  of dpage_, both store histtype
 ------------------------------------------------------------------------- */
 
 void FixContactHistory::allocate_pages()
@@ -259,15 +279,38 @@ void FixContactHistory::allocate_pages()
   if (create) {
     delete [] ipage_;
     delete [] dpage_;
+    delete [] hpage_;
+    delete [] lpage_;
+    delete [] spage_;
+    dpage_ = NULL;
+    hpage_ = NULL;
+    lpage_ = NULL;
+    spage_ = NULL;
+    adopted_ = 0;
 
     pgsize_ = neighbor->pgsize;
     oneatom_ = neighbor->oneatom;
     int nmypage = comm->nthreads;
     ipage_ = new MyPage<int>[nmypage];
-    dpage_ = new MyPage<double>[nmypage];
-    for (int i = 0; i < nmypage; i++) {
+    for (int i = 0; i < nmypage; i++)
       ipage_[i].init(oneatom_,pgsize_);
-      dpage_[i].init(oneatom_*std::max(1,dnum_),pgsize_);
+
+    if (adoptflag_) {
+      spage_ = new MyPage<histtype>[nmypage];
+      hpage_ = new MyPage<histtype *>[nmypage];
+      for (int i = 0; i < nmypage; i++) {
+        spage_[i].init(oneatom_*std::max(1,dnum_),pgsize_);
+        hpage_[i].init(oneatom_,pgsize_);
+      }
+      if (dnum_) {
+        lpage_ = new MyPage<histtype>[nmypage];
+        for (int i = 0; i < nmypage; i++)
+          lpage_[i].init(dnum_*oneatom_,dnum_*pgsize_,1);
+      }
+    } else {
+      dpage_ = new MyPage<double>[nmypage];
+      for (int i = 0; i < nmypage; i++)
+        dpage_[i].init(oneatom_*std::max(1,dnum_),pgsize_);
     }
   }
 }
@@ -298,8 +341,12 @@ void FixContactHistory::setup_pre_exchange()
 }
 
 /* ----------------------------------------------------------------------
-   copy contacthistory partner info from neighbor lists to atom arrays
+   record contacthistory partner info from neighbor lists in atom arrays
    so can be migrated or stored with atoms
+   values are not copied: the fix takes over the history pages of the list
+   and stores a pointer per partner, so only migrating atoms pack values
+   the list builds into the pages released at the previous swap
+   values are copied as before if the list does not own its pages
 ------------------------------------------------------------------------- */
 
 void FixContactHistory::pre_exchange()
@@ -307,7 +354,7 @@ void FixContactHistory::pre_exchange()
   int i,j,ii,jj,m,n,inum,jnum;
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *contact_flag,**first_contact_flag;
-  double *hist,*allhist,**firsthist;
+  histtype *hist,*allhist,**firsthist;
 
   // re-set computeflag: most current info is now in atom arrays
   *computeflag_ = 0;
@@ -317,12 +364,13 @@ void FixContactHistory::pre_exchange()
   int nmax = atom->nmax;
 
   // zero npartner for all current atoms
-  // clear 2 page data structures
+  // clear 3 page data structures
 
   std::fill_n(npartner_, nmax, 0);
 
   ipage_->reset();
-  dpage_->reset();
+  spage_->reset();
+  hpage_->reset();
 
   // 1st loop over neighbor list
   // calculate npartner for each owned atom
@@ -330,12 +378,29 @@ void FixContactHistory::pre_exchange()
 
   int *tag = atom->tag;
   NeighList *list = pair_gran_->list;
+  NeighList *listgranhistory = list->listgranhistory;
   inum = list->inum;
   ilist = list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
-  first_contact_flag = list->listgranhistory->firstneigh;
-  firsthist = list->listgranhistory->firstdouble;
+  first_contact_flag = listgranhistory->firstneigh;
+  firsthist = listgranhistory->firstdouble;
+
+  // take over history pages of the list unless already done since last build
+  // only possible if the list was built with pages that match lpage_
+
+  if (!adopted_ && lpage_ && !list->listskip && !list->listcopy &&
+      !listgranhistory->listcopy && listgranhistory->dpage &&
+      listgranhistory->pgsize == pgsize_ &&
+      listgranhistory->oneatom == oneatom_ &&
+      listgranhistory->dnum == dnum_)
+  {
+    MyPage<histtype> *swap = listgranhistory->dpage;
+    listgranhistory->dpage = lpage_;
+    lpage_ = swap;
+    adopted_ = 1;
+  }
+  int copyflag = adopted_ ? 0 : 1;
 
   int nlocal_neigh = 0;
   if (inum) nlocal_neigh = ilist[inum-1] + 1;
@@ -358,21 +423,24 @@ void FixContactHistory::pre_exchange()
     }
   }
 
-  // get page chunks to store atom IDs and shear history for my atoms
+  // get page chunks to store atom IDs and history references for my atoms
   
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     
     n = npartner_[i];
     partner_[i] = ipage_->get(n);
-    contacthistory_[i] = dpage_->get(dnum_*n);
+    partnerflip_[i] = ipage_->get(n);
+    partnerhist_[i] = hpage_->get(n);
+    ownhist_[i] = copyflag ? spage_->get(dnum_*n) : NULL;
     
-    if (partner_[i] == NULL || contacthistory_[i] == NULL)
+    if (partner_[i] == NULL || partnerflip_[i] == NULL || partnerhist_[i] == NULL ||
+        (copyflag && ownhist_[i] == NULL))
       error->one(FLERR,"Contact history overflow, boost neigh_modify one");
   }
 
   // 2nd loop over neighbor list
-  // store atom IDs and shear history for my atoms
+  // store atom IDs and history references for my atoms
   // re-zero npartner to use as counter for all my atoms
 
   std::fill_n(npartner_, nmax, 0);
@@ -391,10 +459,13 @@ void FixContactHistory::pre_exchange()
         j &= NEIGHMASK;
         m = npartner_[i];
         partner_[i][m] = tag[j];
-        
-        for (int d = 0; d < dnum_; d++) {
-          contacthistory_[i][m*dnum_+d] = hist[d];
+
+        if (copyflag) {
+          vectorCopyN(hist,&(ownhist_[i][m*dnum_]),dnum_);
+          hist = &(ownhist_[i][m*dnum_]);
         }
+        partnerhist_[i][m] = hist;
+        partnerflip_[i][m] = 0;
         
         npartner_[i]++;
         if (j < nlocal_neigh) {
@@ -402,12 +473,8 @@ void FixContactHistory::pre_exchange()
           m = npartner_[j];
 
           partner_[j][m] = tag[i];
-          for (int d = 0; d < dnum_; d++) {
-            if(newtonflag_[d])
-              contacthistory_[j][m*dnum_+d] = -hist[d];
-            else
-              contacthistory_[j][m*dnum_+d] =  hist[d];
-          }
+          partnerhist_[j][m] = hist;
+          partnerflip_[j][m] = 1;
           
           npartner_[j]++;
         }
@@ -450,11 +517,15 @@ double FixContactHistory::memory_usage()
   double bytes = nmax * sizeof(int);
   bytes += nmax * sizeof(int *);
   bytes += nmax * sizeof(double *);
+  if (adoptflag_) bytes += nmax * (sizeof(histtype **) + sizeof(int *) + sizeof(histtype *));
 
   int nmypage = comm->nthreads;
   for (int i = 0; i < nmypage; i++) {
     bytes += ipage_[i].size();
-    bytes += dpage_[i].size();
+    if (dpage_) bytes += dpage_[i].size();
+    if (hpage_) bytes += hpage_[i].size();
+    if (lpage_) bytes += lpage_[i].size();
+    if (spage_) bytes += spage_[i].size();
   }
 
   return bytes;
@@ -473,6 +544,14 @@ void FixContactHistory::grow_arrays(int nmax)
   contacthistory_ = (sptype *)
     memory->srealloc(contacthistory_,nmax*sizeof(sptype),
                      "contact_history:shearpartner");
+  typedef histtype *(*hptype);
+  partnerhist_ = (hptype *)
+    memory->srealloc(partnerhist_,nmax*sizeof(hptype),
+                     "contact_history:partnerhist");
+  partnerflip_ = (int **) memory->srealloc(partnerflip_,nmax*sizeof(int *),
+                                      "contact_history:partnerflip");
+  ownhist_ = (histtype **) memory->srealloc(ownhist_,nmax*sizeof(histtype *),
+                                      "contact_history:ownhist");
 }
 
 /* ----------------------------------------------------------------------
@@ -490,6 +569,9 @@ void FixContactHistory::copy_arrays(int i, int j, int delflag)
   npartner_[j] = npartner_[i];
   partner_[j] = partner_[i];
   contacthistory_[j] = contacthistory_[i];
+  partnerhist_[j] = partnerhist_[i];
+  partnerflip_[j] = partnerflip_[i];
+  ownhist_[j] = ownhist_[i];
 }
 
 /* ----------------------------------------------------------------------
@@ -515,9 +597,8 @@ int FixContactHistory::pack_exchange(int i, double *buf)
   for (int n = 0; n < npartner_[i]; n++) {
     
     buf[m++] = ubuf(partner_[i][n]).d;
-    for (int d = 0; d < dnum_; d++) {
-      buf[m++] = contacthistory_[i][n*dnum_+d];
-    }
+    partner_history(i,n,&buf[m]);
+    m += dnum_;
   }
   return m;
 }
@@ -528,25 +609,68 @@ int FixContactHistory::pack_exchange(int i, double *buf)
 
 int FixContactHistory::unpack_exchange(int nlocal, double *buf)
 {
-  // allocate new chunks from ipage,dpage for incoming values
+  // allocate new chunks from ipage and dpage or spage for incoming values
 
   int m = 0;
   npartner_[nlocal] = ubuf(buf[m++]).i;
   maxtouch_ = MAX(maxtouch_,npartner_[nlocal]);
-  partner_[nlocal] = ipage_->get(npartner_[nlocal]);
-  contacthistory_[nlocal] = dpage_->get(dnum_*npartner_[nlocal]);
-  if (partner_[nlocal] == NULL || contacthistory_[nlocal] == NULL)
-      error->one(FLERR,"Contact history overflow, boost neigh_modify one");
+  allocate_partners(nlocal);
 
   for (int n = 0; n < npartner_[nlocal]; n++) {
     partner_[nlocal][n] = ubuf(buf[m++]).i;
-    for (int d = 0; d < dnum_; d++) {
-      contacthistory_[nlocal][n*dnum_+d] = buf[m++];
-    }
+    set_history(nlocal,n,&buf[m]);
+    m += dnum_;
   }
+  set_partner_references(nlocal);
   return m;
 }
 
+/* ----------------------------------------------------------------------
+   get page chunks for npartner_[i] partners of incoming atom i
+------------------------------------------------------------------------- */
+
+void FixContactHistory::allocate_partners(int i)
+{
+  const int n = npartner_[i];
+  partner_[i] = ipage_->get(n);
+  if (adoptflag_) ownhist_[i] = spage_->get(dnum_*n);
+  else contacthistory_[i] = dpage_->get(dnum_*n);
+  if (partner_[i] == NULL || (adoptflag_ ? ownhist_[i] == NULL : contacthistory_[i] == NULL))
+      error->one(FLERR,"Contact history overflow, boost neigh_modify one");
+}
+
+/* ----------------------------------------------------------------------
+   store incoming history values of the m-th partner of atom i
+------------------------------------------------------------------------- */
+
+void FixContactHistory::set_history(int i,int m,const double *h)
+{
+  if (adoptflag_)
+    for (int d = 0; d < dnum_; d++) ownhist_[i][m*dnum_+d] = h[d];
+  else
+    vectorCopyN(h,&(contacthistory_[i][m*dnum_]),dnum_);
+}
+
+/* ----------------------------------------------------------------------
+   point partner references of atom i to its own copy of the values
+------------------------------------------------------------------------- */
+
+void FixContactHistory::set_partner_references(int i)
+{
+  if (!adoptflag_) return;
+
+  int n = npartner_[i];
+  partnerhist_[i] = hpage_->get(n);
+  partnerflip_[i] = ipage_->get(n);
+  if (partnerhist_[i] == NULL || partnerflip_[i] == NULL)
+      error->one(FLERR,"Contact history overflow, boost neigh_modify one");
+
+  for (int m = 0; m < n; m++) {
+    partnerhist_[i][m] = &(ownhist_[i][m*dnum_]);
+    partnerflip_[i][m] = 0;
+  }
+}
+
 /* ----------------------------------------------------------------------
    pack  state of Fix into one write
 ------------------------------------------------------------------------- */
@@ -593,10 +717,8 @@ int FixContactHistory::pack_restart(int i, double *buf)
   buf[m++] = ubuf(npartner_[i]).d;
   for (int n = 0; n < npartner_[i]; n++) {
     buf[m++] = ubuf(partner_[i][n]).d;
-    for (int d = 0; d < dnum_; d++) {
-      buf[m++] = contacthistory_[i][n*dnum_+d];
-      
-    }
+    partner_history(i,n,&buf[m]);
+    m += dnum_;
   }
   return m;
 }
@@ -622,18 +744,14 @@ void FixContactHistory::unpack_restart(int nlocal, int nth)
   // allocate new chunks from ipage,dpage for incoming values
   npartner_[nlocal] = ubuf(extra[nlocal][m++]).i;
   maxtouch_ = MAX(maxtouch_,npartner_[nlocal]);
-  partner_[nlocal] = ipage_->get(npartner_[nlocal]);
-  contacthistory_[nlocal] = dpage_->get(npartner_[nlocal]*dnum_);
-  if (partner_[nlocal] == NULL || contacthistory_[nlocal] == NULL)
-      error->one(FLERR,"Contact history overflow, boost neigh_modify one");
+  allocate_partners(nlocal);
 
   for (int n = 0; n < npartner_[nlocal]; n++) {
     partner_[nlocal][n] = ubuf(extra[nlocal][m++]).i;
-    
-    for (int d = 0; d < dnum_; d++) {
-      contacthistory_[nlocal][n*dnum_+d] = extra[nlocal][m++];
-    }
+    set_history(nlocal,n,&extra[nlocal][m]);
+    m += dnum_;
   }
+  set_partner_references(nlocal);
 }
 
 /* ----------------------------------------------------------------------
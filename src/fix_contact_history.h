@@ -109,6 +109,24 @@ class FixContactHistory : public Fix {
   inline int get_dnum()
   { return dnum_; }
 
+  // history values of the m-th partner of atom i, as seen from atom i
+  // h is either a neighbor list page (histtype) or a comm buffer (double)
+
+  template<typename T>
+  inline void partner_history(int i,int m,T *h)
+  {
+    if (!adoptflag_) {
+      const double * const src = &(contacthistory_[i][m*dnum_]);
+      for (int d = 0; d < dnum_; d++) h[d] = src[d];
+      return;
+    }
+    const histtype * const src = partnerhist_[i][m];
+    if (partnerflip_[i][m])
+      for (int d = 0; d < dnum_; d++) h[d] = newtonflag_[d] ? -src[d] : src[d];
+    else
+      for (int d = 0; d < dnum_; d++) h[d] = src[d];
+  }
+
  protected:
 
   int iarg_;
@@ -124,14 +142,30 @@ class FixContactHistory : public Fix {
   double **contacthistory_;     // contact history values with the partner
   int maxtouch_;                 // max # of touching partners for my atoms
 
+  // style contacthistory does not copy values out of the neighbor list
+  // in pre_exchange, but takes over the history pages of the list and
+  // only keeps a pointer per partner; j-side entries are flipped on read
+
+  int adoptflag_;                // 1 if partner history is kept by reference
+  int adopted_;                  // 1 if lpage_ holds the current history
+  histtype ***partnerhist_;      // history values of each partner
+  int **partnerflip_;            // 1 if newton components must be negated
+  histtype **ownhist_;           // history values owned by the fix, if copied
+
   class Pair *pair_gran_;
   int *computeflag_;             // computeflag in PairGranHookeHistory
 
   int pgsize_,oneatom_;          // copy of settings in Neighbor
   MyPage<int> *ipage_;           // pages of partner atom IDs
   MyPage<double> *dpage_;        // pages of shear history with partners
+  MyPage<histtype *> *hpage_;    // pages of pointers to partner history
+  MyPage<histtype> *lpage_;      // history pages swapped with neigh list
+  MyPage<histtype> *spage_;      // pages of ownhist_
 
   virtual void allocate_pages();
+  void allocate_partners(int i);
+  void set_history(int i,int m,const double *h);
+  void set_partner_references(int i);
 
 };
 
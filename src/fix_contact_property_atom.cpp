@@ -67,7 +67,11 @@ FixContactPropertyAtom::FixContactPropertyAtom(LAMMPS *lmp, int narg, char **arg
   FixContactHistory(lmp, narg, arg),
   fix_nneighs_full_(0),
   build_neighlist_(true),
-  reset_each_ts_(true)
+  reset_each_ts_(true),
+  pair_offset_(NULL),
+  pair_slot_(NULL),
+  nmax_offset_(0),
+  maxpair_(0)
 {
     bool hasargs = true;
     while(iarg_ < narg && hasargs)
@@ -100,6 +104,8 @@ FixContactPropertyAtom::FixContactPropertyAtom(LAMMPS *lmp, int narg, char **arg
 
 FixContactPropertyAtom::~FixContactPropertyAtom()
 {
+    memory->destroy(pair_offset_);
+    memory->destroy(pair_slot_);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -283,6 +289,41 @@ void FixContactPropertyAtom::clear()
    }
 }
 
+/* ----------------------------------------------------------------------
+   lay out one pair of slots per neighbor list entry of the pair style
+   and mark them as not stored
+------------------------------------------------------------------------- */
+
+void FixContactPropertyAtom::reset_pair_slots()
+{
+    const int inum = pair_gran_->list->inum;
+    const int * const ilist = pair_gran_->list->ilist;
+    const int * const numneigh = pair_gran_->list->numneigh;
+
+    if (atom->nmax > nmax_offset_)
+    {
+        nmax_offset_ = atom->nmax;
+        memory->destroy(pair_offset_);
+        memory->create(pair_offset_,nmax_offset_,"contactproperty/atom:pair_offset");
+    }
+
+    int npair = 0;
+    for (int ii = 0; ii < inum; ii++)
+    {
+        const int i = ilist[ii];
+        pair_offset_[i] = npair;
+        npair += numneigh[i];
+    }
+
+    if (2*npair > maxpair_)
+    {
+        maxpair_ = 2*npair;
+        memory->destroy(pair_slot_);
+        memory->create(pair_slot_,maxpair_,"contactproperty/atom:pair_slot");
+    }
+    vectorInitializeN(pair_slot_,2*npair,-1);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixContactPropertyAtom::min_setup_pre_force(int dummy)
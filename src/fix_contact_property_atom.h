@@ -133,11 +133,43 @@ class FixContactPropertyAtom : public FixContactHistory {
       return npartner_[i];
   }
 
+  // store the contact of neighbor list entry jj of atom i with atom j
+  // and remember its position in the partner lists of i and j, so the
+  // force loop does not have to search for it
+
+  void reset_pair_slots();
+
+  inline void add_pair(const int i, const int jj, const int j, const int tag_i, const int tag_j,
+                       const double * const history_ij, const double * const history_ji)
+  {
+      int * const slot = &pair_slot_[2*(pair_offset_[i]+jj)];
+      slot[0] = npartner_[i];
+      add_partner(i, tag_j, history_ij);
+      slot[1] = npartner_[j];
+      add_partner(j, tag_i, history_ji);
+  }
+
+  // position of the contact of neighbor list entry jj in the partner list
+  // of atom i and of its neighbor j, -1 if not stored or if no slots
+  // were laid out yet
+  // only valid for owned neighbors, since forward comm replaces the
+  // partner lists of ghost atoms
+
+  inline int pair_slot_i(const int i, const int jj) const
+  { return pair_slot_ ? pair_slot_[2*(pair_offset_[i]+jj)] : -1; }
+
+  inline int pair_slot_j(const int i, const int jj) const
+  { return pair_slot_ ? pair_slot_[2*(pair_offset_[i]+jj)+1] : -1; }
+
  protected:
 
   class FixPropertyAtom *fix_nneighs_full_;
 
   bool build_neighlist_, reset_each_ts_;
+
+  int *pair_offset_;             // start of neighbor entries of atom i in pair_slot_
+  int *pair_slot_;               // 2 partner list positions per neighbor entry
+  int nmax_offset_, maxpair_;
 };
 
 }
@@ -59,6 +59,7 @@
 #include "memory.h"
 #include "error.h"
 #include <algorithm>
+#include <set>
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -73,6 +74,11 @@ FixContinuumWeighted::FixContinuumWeighted(LAMMPS *lmp, int narg, char **arg) :
     fix_strain_(NULL),
     fix_cont_vars_(NULL),
     fix_contact_forces_(NULL),
+    npairs_(0),
+    maxpairs_(0),
+    pair_i_(NULL),
+    pair_j_(NULL),
+    pair_phi_(NULL),
     compute_stress(false),
     compute_strain(false),
     kernel_type(TOP_HAT)
@@ -122,6 +128,14 @@ FixContinuumWeighted::FixContinuumWeighted(LAMMPS *lmp, int narg, char **arg) :
                 error->fix_error(FLERR,this,"Unknown compute parameter");
             iarg++;
             hasargs = true;
+        } else if (strcmp(arg[iarg],"every") == 0) {
+            if (narg < iarg+2)
+                error->fix_error(FLERR,this,"not enough arguments for keyword 'every'");
+            iarg++;
+            nevery = force->inumeric(FLERR,arg[iarg++]);
+            if (nevery <= 0)
+                error->fix_error(FLERR,this,"every > 0 required");
+            hasargs = true;
         } else if (strcmp(style,"continuum/weighted") == 0) {
             char *errmsg = new char[strlen(arg[iarg])+50];
             sprintf(errmsg,"unknown keyword or wrong keyword order: %s", arg[iarg]);
@@ -147,7 +161,11 @@ FixContinuumWeighted::FixContinuumWeighted(LAMMPS *lmp, int narg, char **arg) :
 /* ---------------------------------------------------------------------- */
 
 FixContinuumWeighted::~FixContinuumWeighted()
-{ }
+{
+    memory->destroy(pair_i_);
+    memory->destroy(pair_j_);
+    memory->destroy(pair_phi_);
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -418,8 +436,40 @@ inline double FixContinuumWeighted::get_grad_phi(const double r)
     return -1.0;
 }
 
+/* ----------------------------------------------------------------------
+   make room for n cached pairs
+------------------------------------------------------------------------- */
+
+void FixContinuumWeighted::grow_pairs(const int n)
+{
+    if (n <= maxpairs_)
+        return;
+    maxpairs_ = n;
+    memory->grow(pair_i_, maxpairs_, "continuum/weighted:pair_i");
+    memory->grow(pair_j_, maxpairs_, "continuum/weighted:pair_j");
+    memory->grow(pair_phi_, maxpairs_, "continuum/weighted:pair_phi");
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixContinuumWeighted::memory_usage()
+{
+    return static_cast<double>(maxpairs_)*(2*sizeof(int) + sizeof(double));
+}
+
+/* ----------------------------------------------------------------------
+   the first sweep over the neighbor list accumulates density, momentum
+   and strain and caches all pairs within the kernel radius together
+   with their kernel value; the kinetic stress then runs over this cache
+   only, so pair distances and kernels are evaluated once per step
+   only invoked every nevery steps
+------------------------------------------------------------------------- */
+
 void FixContinuumWeighted::post_integrate()
 {
+    if (update->ntimestep % nevery)
+        return;
+
     const double *const *const x = atom->x;
     const double *const *const v = atom->v;
     const double *const mass = atom->rmass;
@@ -437,12 +487,23 @@ void FixContinuumWeighted::post_integrate()
 
     for (int ii = 0; ii < nlocal; ii++)
         vectorZeroizeN(cont_vars[ii],7);
+    // strain is only accumulated for owned particles
     if (compute_strain)
     {
-        for (int i = 0; i < nlocal + atom->nghost; i++)
+        for (int i = 0; i < nlocal; i++)
             vectorZeroizeN(strain[i], 9);
     }
 
+    // upper bound for number of cached pairs: all neighbors plus i itself
+    if (compute_stress)
+    {
+        int nmax = 0;
+        for (int ii = 0; ii < inum; ii++)
+            nmax += numneigh[ilist[ii]] + 1;
+        grow_pairs(nmax);
+    }
+    npairs_ = 0;
+
     for (int ii = 0; ii < inum; ii++) {
         int i = ilist[ii];
         if (!(mask[i] & groupbit)) continue;
@@ -456,30 +517,37 @@ void FixContinuumWeighted::post_integrate()
         const int *const jlist = firstneigh[i];
         const int jnum = numneigh[i];
 
-        for (int jj = 0; jj <= jnum; jj++) {
-            const int j = (jj == jnum ? i : jlist[jj]); // last j is i itself
+        for (int jj = -1; jj < jnum; jj++) {
+            const int j = (jj == -1 ? i : jlist[jj]); // first j is i itself
             if (!(mask[j] & groupbit)) continue;
 
             // compute particle distance
             const double xij[3] = {xi - x[j][0], yi - x[j][1], zi - x[j][2]};
             const double sqDist = vectorMag3DSquared(xij);
 
-            // assuming top hat kernel
+            // all kernels are scaled so that they are either 0 or can be cut off (Gaussian) at kernel_radius_
             if (sqDist < kernel_sqRadius_) {
                 const double mj = mass[j];
                 const double dist = sqrt(sqDist);
                 const double phi = get_phi(dist);
                 const double rhoj = mj*phi;
-                const double grad_phi = get_grad_phi(dist);
                 const double vxj = v[j][0];
                 const double vyj = v[j][1];
                 const double vzj = v[j][2];
+                if (compute_stress)
+                {
+                    pair_i_[npairs_] = i;
+                    pair_j_[npairs_] = j;
+                    pair_phi_[npairs_] = phi;
+                    npairs_++;
+                }
                 cont_vars[i][0] += rhoj*vxj;
                 cont_vars[i][1] += rhoj*vyj;
                 cont_vars[i][2] += rhoj*vzj;
                 cont_vars[i][3] += rhoj;
                 if (compute_strain)
                 {
+                    const double grad_phi = get_grad_phi(dist);
                     const double gradrhoj = mj*grad_phi;
                     cont_vars[i][4] += gradrhoj*xij[0];
                     cont_vars[i][5] += gradrhoj*xij[1];
@@ -493,15 +561,7 @@ void FixContinuumWeighted::post_integrate()
                     strain[i][6] += gradrhoj*xij[0]*vzj;
                     strain[i][7] += gradrhoj*xij[1]*vzj;
                     strain[i][8] += gradrhoj*xij[2]*vzj;
-                }
-                if (j < nlocal && j != i)
-                {
-                    const double rhoi = mi*phi;
-                    cont_vars[j][0] += rhoi*vxi;
-                    cont_vars[j][1] += rhoi*vyi;
-                    cont_vars[j][2] += rhoi*vzi;
-                    cont_vars[j][3] += rhoi;
-                    if (compute_strain)
+                    if (j < nlocal && j != i)
                     {
                         const double gradrhoi = mi*grad_phi;
                         cont_vars[j][4] -= gradrhoi*xij[0];
@@ -518,6 +578,14 @@ void FixContinuumWeighted::post_integrate()
                         strain[j][8] -= gradrhoi*xij[2]*vzi;
                     }
                 }
+                if (j < nlocal && j != i)
+                {
+                    const double rhoi = mi*phi;
+                    cont_vars[j][0] += rhoi*vxi;
+                    cont_vars[j][1] += rhoi*vyi;
+                    cont_vars[j][2] += rhoi*vzi;
+                    cont_vars[j][3] += rhoi;
+                }
             }
         }
 
@@ -537,26 +605,22 @@ void FixContinuumWeighted::post_integrate()
                     if (dist < kernel_radius_) {
                         const double rhoi = mi*get_phi(dist);
                         const double gradrhoi = 2.0*mi*get_grad_phi(dist); // 2.0 again for same reason
-                        fflush(stdout);
                         cont_vars[i][0] += rhoi*vel[0]; // vel of wall
                         cont_vars[i][1] += rhoi*vel[1];
                         cont_vars[i][2] += rhoi*vel[2];
                         cont_vars[i][3] += rhoi;
-                        if (compute_strain)
-                        {
-                            cont_vars[i][4] += gradrhoi*pos[0];
-                            cont_vars[i][5] += gradrhoi*pos[1];
-                            cont_vars[i][6] += gradrhoi*pos[2];
-                            strain[i][0] += gradrhoi*pos[0]*vel[0];
-                            strain[i][1] += gradrhoi*pos[1]*vel[0];
-                            strain[i][2] += gradrhoi*pos[2]*vel[0];
-                            strain[i][3] += gradrhoi*pos[0]*vel[1];
-                            strain[i][4] += gradrhoi*pos[1]*vel[1];
-                            strain[i][5] += gradrhoi*pos[2]*vel[1];
-                            strain[i][6] += gradrhoi*pos[0]*vel[2];
-                            strain[i][7] += gradrhoi*pos[1]*vel[2];
-                            strain[i][8] += gradrhoi*pos[2]*vel[2];
-                        }
+                        cont_vars[i][4] += gradrhoi*pos[0];
+                        cont_vars[i][5] += gradrhoi*pos[1];
+                        cont_vars[i][6] += gradrhoi*pos[2];
+                        strain[i][0] += gradrhoi*pos[0]*vel[0];
+                        strain[i][1] += gradrhoi*pos[1]*vel[0];
+                        strain[i][2] += gradrhoi*pos[2]*vel[0];
+                        strain[i][3] += gradrhoi*pos[0]*vel[1];
+                        strain[i][4] += gradrhoi*pos[1]*vel[1];
+                        strain[i][5] += gradrhoi*pos[2]*vel[1];
+                        strain[i][6] += gradrhoi*pos[0]*vel[2];
+                        strain[i][7] += gradrhoi*pos[1]*vel[2];
+                        strain[i][8] += gradrhoi*pos[2]*vel[2];
                     }
                 }
             }
@@ -580,69 +644,63 @@ void FixContinuumWeighted::post_integrate()
     {
         for (int i = 0; i < nlocal + atom->nghost; i++)
             vectorZeroizeN(stress[i], 9);
+
+        // kinetic contribution from the pairs cached above
+        for (int p = 0; p < npairs_; p++) {
+            const int i = pair_i_[p];
+            const int j = pair_j_[p];
+            const double phi = pair_phi_[p];
+            const double vpxj = v[j][0]-cont_vars[i][0];
+            const double vpyj = v[j][1]-cont_vars[i][1];
+            const double vpzj = v[j][2]-cont_vars[i][2];
+            const double phi_mj = mass[j]*phi;
+            // j -> i
+            stress[i][0] -= vpxj * vpxj * phi_mj;
+            stress[i][1] -= vpxj * vpyj * phi_mj;
+            stress[i][2] -= vpxj * vpzj * phi_mj;
+            stress[i][3] -= vpyj * vpxj * phi_mj;
+            stress[i][4] -= vpyj * vpyj * phi_mj;
+            stress[i][5] -= vpyj * vpzj * phi_mj;
+            stress[i][6] -= vpzj * vpxj * phi_mj;
+            stress[i][7] -= vpzj * vpyj * phi_mj;
+            stress[i][8] -= vpzj * vpzj * phi_mj;
+            // i -> j
+            if (j != i && j < nlocal) { // don't add the contribution i->i twice
+                const double vpxi = v[i][0] - cont_vars[j][0];
+                const double vpyi = v[i][1] - cont_vars[j][1];
+                const double vpzi = v[i][2] - cont_vars[j][2];
+                const double phi_mi = mass[i]*phi;
+                stress[j][0] -= vpxi * vpxi * phi_mi;
+                stress[j][1] -= vpxi * vpyi * phi_mi;
+                stress[j][2] -= vpxi * vpzi * phi_mi;
+                stress[j][3] -= vpyi * vpxi * phi_mi;
+                stress[j][4] -= vpyi * vpyi * phi_mi;
+                stress[j][5] -= vpyi * vpzi * phi_mi;
+                stress[j][6] -= vpzi * vpxi * phi_mi;
+                stress[j][7] -= vpzi * vpyi * phi_mi;
+                stress[j][8] -= vpzi * vpzi * phi_mi;
+            }
+        }
     }
-    for (int ii = 0; ii < inum; ii++) {
+
+    for (int ii = 0; compute_stress && ii < inum; ii++) {
         int i = ilist[ii];
         if (!(mask[i] & groupbit)) continue;
         const double xi[3] = {x[i][0], x[i][1], x[i][2]};
-        const double vi[3] = {v[i][0], v[i][1], v[i][2]};
-        const double mi = mass[i];
         const int *jlist = firstneigh[i];
         const int jnum = numneigh[i];
         const int tag_i = tag[i];
 
-        std::set<int> i_contacts;
-
-        // standard neighbor loop
-        for (int jj = -1; jj < jnum; jj++) {
-            const int j = (jj == -1 ? i : jlist[jj]); // first j is i itself
-            if (!(mask[j] & groupbit)) continue;
+        // compute wall contribution, the line from j to its wall contact
+        // may cross the kernel of i even if j itself is outside of it
+        if (!fix_wall_contact_forces_vector_.empty())
+        {
+            for (int jj = -1; jj < jnum; jj++) {
+                const int j = (jj == -1 ? i : jlist[jj]); // first j is i itself
+                if (!(mask[j] & groupbit)) continue;
 
-            // compute particle distance
-            const double xj[3] = {x[j][0], x[j][1], x[j][2]};
-            const double xij[3] = {xi[0] - xj[0], xi[1] - xj[1], xi[2] - xj[2]};
-            const double vj[3] = {v[j][0], v[j][1], v[j][2]};
-            const double sqDist = vectorMag3DSquared(xij);
+                const double xij[3] = {xi[0] - x[j][0], xi[1] - x[j][1], xi[2] - x[j][2]};
 
-            // all kernels are scaled so that they are either 0 or can be cut off (Gaussian) at kernel_radius_
-            if (compute_stress && sqDist < kernel_sqRadius_) {
-                const double vpxj = vj[0]-cont_vars[i][0];
-                const double vpyj = vj[1]-cont_vars[i][1];
-                const double vpzj = vj[2]-cont_vars[i][2];
-                const double mj = mass[j];
-                const double phi = get_phi(sqDist);
-                const double phi_mj = mj*phi;
-                // j -> i
-                stress[i][0] -= vpxj * vpxj * phi_mj;
-                stress[i][1] -= vpxj * vpyj * phi_mj;
-                stress[i][2] -= vpxj * vpzj * phi_mj;
-                stress[i][3] -= vpyj * vpxj * phi_mj;
-                stress[i][4] -= vpyj * vpyj * phi_mj;
-                stress[i][5] -= vpyj * vpzj * phi_mj;
-                stress[i][6] -= vpzj * vpxj * phi_mj;
-                stress[i][7] -= vpzj * vpyj * phi_mj;
-                stress[i][8] -= vpzj * vpzj * phi_mj;
-                // i -> j
-                if (j != i && j < nlocal) { // don't add the contribution i->i twice
-                    const double vpxi = vi[0] - cont_vars[j][0];
-                    const double vpyi = vi[1] - cont_vars[j][1];
-                    const double vpzi = vi[2] - cont_vars[j][2];
-                    const double phi_mi = mi*phi;
-                    stress[j][0] -= vpxi * vpxi * phi_mi;
-                    stress[j][1] -= vpxi * vpyi * phi_mi;
-                    stress[j][2] -= vpxi * vpzi * phi_mi;
-                    stress[j][3] -= vpyi * vpxi * phi_mi;
-                    stress[j][4] -= vpyi * vpyi * phi_mi;
-                    stress[j][5] -= vpyi * vpzi * phi_mi;
-                    stress[j][6] -= vpzi * vpxi * phi_mi;
-                    stress[j][7] -= vpzi * vpyi * phi_mi;
-                    stress[j][8] -= vpzi * vpzi * phi_mi;
-                }
-            }
-
-            // compute wall contribution
-            if (compute_stress)
-            {
                 std::vector<FixContactPropertyAtom *>::iterator it;
                 for (it = fix_wall_contact_forces_vector_.begin(); it < fix_wall_contact_forces_vector_.end(); it++)
                 {
@@ -682,10 +740,10 @@ void FixContinuumWeighted::post_integrate()
                     }
                 }
             }
-
-        } // end loop j neighbors
+        }
 
         // contactproperty atom loop
+        std::set<int> i_contacts;
         for (int jj = 0; jj < fix_contact_forces_->get_npartners(i); jj++)
         {
             const double *const force_pos_ij = fix_contact_forces_->contacthistory(i, jj);
@@ -693,69 +751,60 @@ void FixContinuumWeighted::post_integrate()
             i_contacts.insert(tag[j]);
         }
 
-        if (compute_stress)
+        // contactproperty atom loop
+        for (int jj = 0; jj < fix_contact_forces_->get_npartners(i); jj++)
         {
-            // contactproperty atom loop
-            for (int jj = 0; jj < fix_contact_forces_->get_npartners(i); jj++)
+            const double *const force_pos_ij = fix_contact_forces_->contacthistory(i, jj);
+            const int j = (int)force_pos_ij[3];
+            const double xji[3] = {x[j][0] - xi[0], x[j][1] - xi[1], x[j][2] - xi[2]};
+
+            std::set<int> skip_contacts;
+            for (int ll = 0; ll < fix_contact_forces_->get_npartners(j); ll++)
             {
-                const double *const force_pos_ij = fix_contact_forces_->contacthistory(i, jj);
-                const int j = (int)force_pos_ij[3];
-                const double xji[3] = {x[j][0] - xi[0], x[j][1] - xi[1], x[j][2] - xi[2]};
-                const double sqDistji = vectorMag3DSquared(xji);
+                const double *const force_pos_jl = fix_contact_forces_->contacthistory(j, ll);
+                const int l = (int)force_pos_jl[3];
+                const int tag_l = tag[l];
+                if (tag_l < tag_i && i_contacts.find(tag_l) != i_contacts.end())
+                    skip_contacts.insert(tag_l);
+            }
 
-                if (!compute_stress && sqDistji > kernel_sqRadius_)
+            for (int kk = 0; kk < fix_contact_forces_->get_npartners(i); kk++)
+            {
+                const double *const force_pos_ik = fix_contact_forces_->contacthistory(i, kk);
+                const int k = (int)force_pos_ik[3];
+                const int tag_k = tag[k];
+                const double xik[3] = {xi[0] - x[k][0], xi[1] - x[k][1], xi[2] - x[k][2]};
+
+                if (skip_contacts.find(tag_k) != skip_contacts.end())
                     continue;
 
-                std::set<int> skip_contacts;
-                for (int ll = 0; ll < fix_contact_forces_->get_npartners(j); ll++)
-                {
-                    const double *const force_pos_jl = fix_contact_forces_->contacthistory(j, ll);
-                    const int l = (int)force_pos_jl[3];
-                    const int tag_l = tag[l];
-                    if (tag_l < tag_i && i_contacts.find(tag_l) != i_contacts.end())
-                        skip_contacts.insert(tag_l);
-                }
+                // stress contribution
+                // check if forces are actually present between those two particles, if not go to next contact
+                const double absForces = vectorMag3DSquared(force_pos_ik);
+                if (absForces < 1e-6)
+                    continue;
 
-                for (int kk = 0; kk < fix_contact_forces_->get_npartners(i); kk++)
+                const double integralVal_ijk = 0.5*compute_line_sphere_intersection(xji, xik);
+                if (integralVal_ijk > 1e-6)
                 {
-                    const double *const force_pos_ik = fix_contact_forces_->contacthistory(i, kk);
-                    const int k = (int)force_pos_ik[3];
-                    const int tag_k = tag[k];
-                    const double xik[3] = {xi[0] - x[k][0], xi[1] - x[k][1], xi[2] - x[k][2]};
-
-                    if (skip_contacts.find(tag_k) != skip_contacts.end())
-                        continue;
-
-                    // stress contribution
-                    // check if forces are actually present between those two particles, if not go to next contact
-                    const double absForces = vectorMag3DSquared(force_pos_ik);
-                    if (absForces < 1e-6)
-                        continue;
-
-                    const double integralVal_ijk = 0.5*compute_line_sphere_intersection(xji, xik);
-                    if (integralVal_ijk > 1e-6)
-                    {
-                        stress[j][0] -= force_pos_ik[0]*xik[0]*integralVal_ijk; // - 1/2 f_ij (x) r_ij * integral
-                        stress[j][1] -= force_pos_ik[0]*xik[1]*integralVal_ijk;
-                        stress[j][2] -= force_pos_ik[0]*xik[2]*integralVal_ijk;
-                        stress[j][3] -= force_pos_ik[1]*xik[0]*integralVal_ijk;
-                        stress[j][4] -= force_pos_ik[1]*xik[1]*integralVal_ijk;
-                        stress[j][5] -= force_pos_ik[1]*xik[2]*integralVal_ijk;
-                        stress[j][6] -= force_pos_ik[2]*xik[0]*integralVal_ijk;
-                        stress[j][7] -= force_pos_ik[2]*xik[1]*integralVal_ijk;
-                        stress[j][8] -= force_pos_ik[2]*xik[2]*integralVal_ijk;
-                    }
+                    stress[j][0] -= force_pos_ik[0]*xik[0]*integralVal_ijk; // - 1/2 f_ij (x) r_ij * integral
+                    stress[j][1] -= force_pos_ik[0]*xik[1]*integralVal_ijk;
+                    stress[j][2] -= force_pos_ik[0]*xik[2]*integralVal_ijk;
+                    stress[j][3] -= force_pos_ik[1]*xik[0]*integralVal_ijk;
+                    stress[j][4] -= force_pos_ik[1]*xik[1]*integralVal_ijk;
+                    stress[j][5] -= force_pos_ik[1]*xik[2]*integralVal_ijk;
+                    stress[j][6] -= force_pos_ik[2]*xik[0]*integralVal_ijk;
+                    stress[j][7] -= force_pos_ik[2]*xik[1]*integralVal_ijk;
+                    stress[j][8] -= force_pos_ik[2]*xik[2]*integralVal_ijk;
                 }
             }
         }
-
     }
 
-    for (int ii = 0; ii < inum; ii++) {
-        int i = ilist[ii];
-        //if(tag[i] == 87) printf("stress[i][0]: %e %d\n", stress[i][0], update->ntimestep);
-        if (compute_strain)
-        {
+    if (compute_strain)
+    {
+        for (int ii = 0; ii < inum; ii++) {
+            int i = ilist[ii];
             const double rho = cont_vars[i][3];
             const double inv2Rho = 0.5/rho;
             const double pDivRho[3] = {cont_vars[i][0], cont_vars[i][1], cont_vars[i][2]}; // momentum density was already divided by rho before
@@ -769,7 +818,6 @@ void FixContinuumWeighted::post_integrate()
             strain[i][6] = dt*(strain[i][6] - pDivRho[2]*gradRho[0])*inv2Rho;
             strain[i][7] = dt*(strain[i][7] - pDivRho[2]*gradRho[1])*inv2Rho;
             strain[i][8] = dt*(strain[i][8] - pDivRho[2]*gradRho[2])*inv2Rho;
-
         }
     }
 
@@ -74,6 +74,7 @@ class FixContinuumWeighted : public Fix {
     void init();
 
     void post_integrate();
+    double memory_usage();
 
     double get_phi(const double r);
     double get_grad_phi(const double r);
@@ -87,6 +88,11 @@ class FixContinuumWeighted : public Fix {
     class FixPropertyAtom *fix_cont_vars_;
     class FixContactPropertyAtom *fix_contact_forces_;
     std::vector<FixContactPropertyAtom *> fix_wall_contact_forces_vector_;
+    // pairs within the kernel radius found in the density sweep
+    int npairs_, maxpairs_;
+    int *pair_i_, *pair_j_;
+    double *pair_phi_;
+    void grow_pairs(const int n);
     double integrate_phi(const double *const xij, const double *const nkj, const double a, const double b);
     template<kernel_type_t kernel_type> double weightingFunction(const double r);
     template<kernel_type_t kernel_type> double gradWeightingFunction(const double r);
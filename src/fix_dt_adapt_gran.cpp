@@ -0,0 +1,407 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#include <string.h>
+#include <stdlib.h>
+#include <cmath>
+#include <algorithm>
+#include "fix_dt_adapt_gran.h"
+#include "atom.h"
+#include "update.h"
+#include "integrate.h"
+#include "error.h"
+#include "pair_gran.h"
+#include "properties.h"
+#include "fix_property_global.h"
+#include "force.h"
+#include "comm.h"
+#include "modify.h"
+#include "fix_wall_gran.h"
+#include "fix_mesh_surface.h"
+#include "neighbor.h"
+#include "neigh_list.h"
+#include "memory.h"
+#include "mpi_liggghts.h"
+#include "property_registry.h"
+#include "global_properties.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+using namespace MODEL_PARAMS;
+
+#define BIG 1.0e20
+
+/* ---------------------------------------------------------------------- */
+
+FixDtAdaptGran::FixDtAdaptGran(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg),
+  pg(NULL),
+  Y(NULL),
+  nu(NULL),
+  Yeff(NULL),
+  max_type(0),
+  rayleigh_coeff(NULL),
+  hertz_coeff(NULL),
+  fraction_rayleigh(0.1),
+  fraction_hertz(0.1),
+  fraction_skin(0.5),
+  growth(1.1),
+  vmax_user(0.),
+  rayleigh_time(BIG),
+  hertz_time(BIG),
+  v_impact_max(0.),
+  v_rel_max(0.),
+  dt_target(0.),
+  laststep(update->ntimestep)
+{
+  if (narg < 6) error->fix_error(FLERR,this,"not enough arguments");
+
+  // set time_depend, else elapsed time accumulation can be messed up
+
+  time_depend = 1;
+
+  nevery = force->inumeric(FLERR,arg[3]);
+  dtmin = force->numeric(FLERR,arg[4]);
+  dtmax = force->numeric(FLERR,arg[5]);
+
+  if (nevery <= 0) error->fix_error(FLERR,this,"N must be > 0");
+  if (dtmin <= 0. || dtmax < dtmin)
+    error->fix_error(FLERR,this,"expecting 0 < dtmin <= dtmax");
+
+  int iarg = 6;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"fraction_rayleigh") == 0) {
+      if (narg < iarg+2) error->fix_error(FLERR,this,"not enough arguments for 'fraction_rayleigh'");
+      fraction_rayleigh = force->numeric(FLERR,arg[iarg+1]);
+      if (fraction_rayleigh <= 0.) error->fix_error(FLERR,this,"'fraction_rayleigh' must be > 0");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fraction_hertz") == 0) {
+      if (narg < iarg+2) error->fix_error(FLERR,this,"not enough arguments for 'fraction_hertz'");
+      fraction_hertz = force->numeric(FLERR,arg[iarg+1]);
+      if (fraction_hertz <= 0.) error->fix_error(FLERR,this,"'fraction_hertz' must be > 0");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fraction_skin") == 0) {
+      if (narg < iarg+2) error->fix_error(FLERR,this,"not enough arguments for 'fraction_skin'");
+      fraction_skin = force->numeric(FLERR,arg[iarg+1]);
+      if (fraction_skin <= 0.) error->fix_error(FLERR,this,"'fraction_skin' must be > 0");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"growth") == 0) {
+      if (narg < iarg+2) error->fix_error(FLERR,this,"not enough arguments for 'growth'");
+      growth = force->numeric(FLERR,arg[iarg+1]);
+      if (growth < 1.) error->fix_error(FLERR,this,"'growth' must be >= 1");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"vmax") == 0) {
+      if (narg < iarg+2) error->fix_error(FLERR,this,"not enough arguments for 'vmax'");
+      vmax_user = force->numeric(FLERR,arg[iarg+1]);
+      iarg += 2;
+    } else {
+      char *errmsg = new char[strlen(arg[iarg])+50];
+      sprintf(errmsg,"unknown keyword or wrong keyword order: %s", arg[iarg]);
+      error->fix_error(FLERR,this,errmsg);
+      delete []errmsg;
+    }
+  }
+
+  scalar_flag = 1;
+  vector_flag = 1;
+  size_vector = 5;
+  global_freq = 1;
+  extscalar = 0;
+  extvector = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixDtAdaptGran::~FixDtAdaptGran()
+{
+  memory->destroy(rayleigh_coeff);
+  memory->destroy(hertz_coeff);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixDtAdaptGran::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDtAdaptGran::init()
+{
+  if (!atom->radius_flag || !atom->density_flag)
+    error->fix_error(FLERR,this,"can only be used together with atom style sphere");
+
+  if (strstr(update->integrate_style,"respa"))
+    error->fix_error(FLERR,this,"does not support run_style respa");
+
+  pg = (PairGran*)force->pair_match("gran",1);
+  if (!pg) pg = (PairGran*)force->pair_match("gran/omp",1);
+  if (!pg) error->fix_error(FLERR,this,"can only be used together with: gran");
+
+  Properties *properties = atom->get_properties();
+  max_type = properties->max_type();
+
+  Y = static_cast<FixPropertyGlobal*>(modify->find_fix_property("youngsModulus","property/global","peratomtype",max_type,0,style));
+  nu = static_cast<FixPropertyGlobal*>(modify->find_fix_property("poissonsRatio","property/global","peratomtype",max_type,0,style));
+  if (!Y || !nu)
+    error->fix_error(FLERR,this,"only works with a pair style that defines youngsModulus and poissonsRatio");
+
+  force->registry.registerProperty("Yeff", &MODEL_PARAMS::createYeff);
+  force->registry.connect("Yeff", Yeff,this->style);
+
+  // T_rayleigh = rayleigh_coeff[type] * r * sqrt(density)
+  // T_hertz = 2.87 * (hertz_coeff[type] * m^2 / (r/2 * v_impact))^0.2
+
+  memory->destroy(rayleigh_coeff);
+  memory->destroy(hertz_coeff);
+  memory->create(rayleigh_coeff,max_type+1,"dt/adapt/gran:rayleigh_coeff");
+  memory->create(hertz_coeff,max_type+1,"dt/adapt/gran:hertz_coeff");
+
+  for (int t = 1; t <= max_type; t++) {
+    const double nu_t = nu->get_values()[t-1];
+    const double shear_mod = Y->get_values()[t-1]/(2.*(nu_t+1.));
+    rayleigh_coeff[t] = M_PI/sqrt(shear_mod)/(0.1631*nu_t+0.8766);
+    hertz_coeff[t] = 1./(Yeff[t][t]*Yeff[t][t]);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDtAdaptGran::setup(int vflag)
+{
+  end_of_step();
+}
+
+/* ----------------------------------------------------------------------
+   dt follows the smallest of the Rayleigh, Hertz and skin limits
+   decreases are applied immediately, increases are limited by 'growth'
+------------------------------------------------------------------------- */
+
+void FixDtAdaptGran::end_of_step()
+{
+  calc_time_scales();
+
+  dt_target = BIG;
+  if (rayleigh_time < BIG) dt_target = std::min(dt_target,fraction_rayleigh*rayleigh_time);
+  if (hertz_time < BIG) dt_target = std::min(dt_target,fraction_hertz*hertz_time);
+  if (v_rel_max > 0.) dt_target = std::min(dt_target,fraction_skin*neighbor->skin/v_rel_max);
+  dt_target = std::max(dtmin,std::min(dtmax,dt_target));
+
+  const double dt_old = update->dt;
+  double dt_new = dt_target;
+
+  if (dt_new > dt_old) dt_new = std::min(dt_new,growth*dt_old);
+
+  if (dt_new == dt_old) return;
+
+  apply_dt(dt_new);
+}
+
+/* ----------------------------------------------------------------------
+   reset update->dt and the classes that depend on it, see fix dt/reset
+------------------------------------------------------------------------- */
+
+void FixDtAdaptGran::apply_dt(double dt_new)
+{
+  laststep = update->ntimestep;
+
+  update->update_time();
+  update->dt = dt_new;
+  if (force->pair) force->pair->reset_dt();
+  for (int i = 0; i < modify->nfix; i++) modify->fix[i]->reset_dt();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDtAdaptGran::calc_time_scales()
+{
+  double **v = atom->v;
+  double *density = atom->density;
+  double *r = atom->radius;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  const int nlocal = atom->nlocal;
+
+  // min of Rayleigh time and of the mass term of the Hertz time, max speed
+
+  double rayleigh_min = BIG;
+  double hertz_term_min = BIG;
+  double vmax_sqr = 0.;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+
+    const int t = type[i];
+    const double rayleigh_i = rayleigh_coeff[t]*r[i]*sqrt(density[i]);
+    if (rayleigh_i < rayleigh_min) rayleigh_min = rayleigh_i;
+
+    const double m = 4.*M_PI/3.*r[i]*r[i]*r[i]*density[i];
+    const double hertz_term_i = hertz_coeff[t]*m*m/(0.5*r[i]);
+    if (hertz_term_i < hertz_term_min) hertz_term_min = hertz_term_i;
+
+    const double vmag_sqr = vectorMag3DSquared(v[i]);
+    if (vmag_sqr > vmax_sqr) vmax_sqr = vmag_sqr;
+  }
+
+  double v_impact = max_impact_velocity_pair();
+
+  MPI_Min_Scalar(rayleigh_min,world);
+  MPI_Min_Scalar(hertz_term_min,world);
+  MPI_Max_Scalar(vmax_sqr,world);
+  MPI_Max_Scalar(v_impact,world);
+
+  double vmax = sqrt(vmax_sqr);
+  if (vmax_user > vmax) vmax = vmax_user;
+
+  // walls: a particle can hit a wall with its full speed plus that of the mesh
+
+  if (modify->n_fixes_style("wall/gran") > 0)
+    v_impact = std::max(v_impact,vmax + max_mesh_velocity());
+
+  v_impact_max = v_impact;
+  v_rel_max = std::max(2.*vmax,v_impact);
+
+  rayleigh_time = rayleigh_min;
+  hertz_time = BIG;
+  if (v_impact_max > 0. && hertz_term_min < BIG)
+    hertz_time = 2.87*pow(hertz_term_min/v_impact_max,0.2);
+}
+
+/* ----------------------------------------------------------------------
+   max normal approach velocity of all pairs in the neighbor list
+   pairs within the skin are included, so impacts are seen before they occur
+------------------------------------------------------------------------- */
+
+double FixDtAdaptGran::max_impact_velocity_pair()
+{
+  double **x = atom->x;
+  double **v = atom->v;
+  int *mask = atom->mask;
+
+  const int inum = pg->list->inum;
+  int *ilist = pg->list->ilist;
+  int *numneigh = pg->list->numneigh;
+  int **firstneigh = pg->list->firstneigh;
+
+  double vn_max = 0.;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    if (!(mask[i] & groupbit)) continue;
+
+    int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int j = jlist[jj] & NEIGHMASK;
+
+      const double delx = x[j][0] - x[i][0];
+      const double dely = x[j][1] - x[i][1];
+      const double delz = x[j][2] - x[i][2];
+      const double vn = (v[i][0]-v[j][0])*delx + (v[i][1]-v[j][1])*dely + (v[i][2]-v[j][2])*delz;
+      if (vn <= 0.) continue;
+
+      const double rsq = delx*delx + dely*dely + delz*delz;
+      if (vn*vn > vn_max*vn_max*rsq) vn_max = vn/sqrt(rsq);
+    }
+  }
+
+  return vn_max;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixDtAdaptGran::max_mesh_velocity()
+{
+  double vmax_sqr_mesh = 0.;
+
+  const int n_wall = modify->n_fixes_style("wall/gran");
+  for (int iwall = 0; iwall < n_wall; iwall++) {
+    FixWallGran *fwg = static_cast<FixWallGran*>(modify->find_fix_style("wall/gran",iwall));
+    if (!fwg->is_mesh_wall()) continue;
+
+    FixMeshSurface **mesh_list = fwg->mesh_list();
+    for (int imesh = 0; imesh < fwg->n_meshes(); imesh++) {
+      TriMesh *mesh = mesh_list[imesh]->triMesh();
+      if (!mesh->isMoving()) continue;
+
+      MultiVectorContainer<double,3,3> *v_mesh = mesh->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v");
+      if (!v_mesh) error->one(FLERR,"Internal error - mesh has no perElementProperty 'v'");
+
+      const int sizeMesh = mesh->sizeLocal();
+      for (int itri = 0; itri < sizeMesh; itri++)
+        for (int inode = 0; inode < 3; inode++) {
+          const double vmag_sqr = vectorMag3DSquared(v_mesh->begin()[itri][inode]);
+          if (vmag_sqr > vmax_sqr_mesh) vmax_sqr_mesh = vmag_sqr;
+        }
+    }
+  }
+
+  MPI_Max_Scalar(vmax_sqr_mesh,world);
+  return sqrt(vmax_sqr_mesh);
+}
+
+/* ----------------------------------------------------------------------
+   return current time-step
+------------------------------------------------------------------------- */
+
+double FixDtAdaptGran::compute_scalar()
+{
+  return update->dt;
+}
+
+/* ----------------------------------------------------------------------
+   return target time-step, rayleigh time, hertz time,
+   max impact velocity and last step the time-step was changed
+------------------------------------------------------------------------- */
+
+double FixDtAdaptGran::compute_vector(int n)
+{
+  if (n == 0)      return dt_target;
+  else if (n == 1) return rayleigh_time;
+  else if (n == 2) return hertz_time;
+  else if (n == 3) return v_impact_max;
+  else if (n == 4) return static_cast<double>(laststep);
+  return 0.;
+}
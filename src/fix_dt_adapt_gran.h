@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(dt/adapt/gran,FixDtAdaptGran)
+
+#else
+
+#ifndef LMP_FIX_DT_ADAPT_GRAN_H
+#define LMP_FIX_DT_ADAPT_GRAN_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixDtAdaptGran : public Fix {
+ public:
+  FixDtAdaptGran(class LAMMPS *, int, char **);
+  ~FixDtAdaptGran();
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  double compute_scalar();
+  double compute_vector(int);
+
+ private:
+  void calc_time_scales();
+  double max_impact_velocity_pair();
+  double max_mesh_velocity();
+  void apply_dt(double dt_new);
+
+  class PairGran *pg;
+  class FixPropertyGlobal *Y;
+  class FixPropertyGlobal *nu;
+  double **Yeff;
+  int max_type;
+
+  // per-type prefactors of the Rayleigh and Hertz estimates
+  double *rayleigh_coeff;
+  double *hertz_coeff;
+
+  double dtmin,dtmax;
+  double fraction_rayleigh,fraction_hertz,fraction_skin;
+  double growth;
+  double vmax_user;
+
+  // last estimates, for output
+  double rayleigh_time,hertz_time;
+  double v_impact_max,v_rel_max;
+  double dt_target;
+  bigint laststep;
+};
+
+}
+
+#endif
+#endif
@@ -33,6 +33,7 @@ class Multisphere {
     return *(new CustomValueTracker(dptr));
   }
   void recalc_n_steps(double dt_ratio) {}
+  void set_start_step(int body, int step) {}
   inline double mass(int i)
   {
       return 0.;
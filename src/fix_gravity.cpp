@@ -64,6 +64,7 @@
 #include "math_const.h"
 #include "fix_multisphere.h"  
 #include "fix_relax_contacts.h"  
+#include "fix_nve_sphere.h"
 #include "error.h"
 #include "force.h"
 
@@ -173,6 +174,7 @@ FixGravity::FixGravity(LAMMPS *lmp, int narg, char **arg) :
   egrav = 0.0;
 
   fm = NULL; 
+  fused_ = false;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -281,6 +283,40 @@ void FixGravity::init()
         fix_relax = static_cast<FixRelaxContacts*>(modify->find_fix_style("relax",0));
   else
         fix_relax = 0;
+
+  // leave the acceleration to fix nve/sphere if it asked for it
+  // and nothing else needs the gravity force in f
+
+  fused_ = false;
+  for (int ifix = 0; ifix < modify->nfix; ifix++)
+    if (strcmp(modify->fix[ifix]->style,"nve/sphere") == 0 &&
+        static_cast<FixNVESphere*>(modify->fix[ifix])->fuse_gravity())
+      fused_ = fusable(modify->fix[ifix]);
+}
+
+/* ----------------------------------------------------------------------
+   true if the integrator can apply the acceleration of this fix directly:
+   constant gravity on the same group, the integrator is the only one,
+   and no fix modifies or overwrites the gravity force in f
+------------------------------------------------------------------------- */
+
+bool FixGravity::fusable(Fix *integrator)
+{
+  if (integrator->igroup != igroup) return false;
+  if (mstr || vstr || pstr || tstr || xstr || ystr || zstr) return false;
+  if (!strstr(update->integrate_style,"verlet")) return false;
+
+  if (modify->n_fixes_style("multisphere") || modify->n_fixes_style("relax"))
+    return false;
+  if (modify->n_fixes_style("freeze") || modify->n_fixes_style("setforce") ||
+      modify->n_fixes_style("aveforce"))
+    return false;
+
+  for (int ifix = 0; ifix < modify->nfix; ifix++)
+    if (modify->fix[ifix]->time_integrate && modify->fix[ifix] != integrator)
+      return false;
+
+  return true;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -316,6 +352,11 @@ void FixGravity::post_force(int vflag)
     set_acceleration();
   }
 
+  eflag = 0;
+  egrav = 0.0;
+
+  if (fused_) return;
+
   double **x = atom->x;
   double **f = atom->f;
   double *rmass = atom->rmass;
@@ -325,9 +366,6 @@ void FixGravity::post_force(int vflag)
   int nlocal = atom->nlocal;
   double massone;
 
-  eflag = 0;
-  egrav = 0.0;
-
   if (rmass) {
     for (int i = 0; i < nlocal; i++)
       if ((mask[i] & groupbit) && (!fm || (fm && fm->belongs_to(i) < 0))) { 
@@ -406,12 +444,31 @@ double FixGravity::compute_scalar()
   // only sum across procs one time
 
   if (eflag == 0) {
+    if (fused_) compute_egrav();
     MPI_Allreduce(&egrav,&egrav_all,1,MPI_DOUBLE,MPI_SUM,world);
     eflag = 1;
   }
   return egrav_all;
 }
 
+/* ----------------------------------------------------------------------
+   potential energy of the group, only needed if the loop in post_force
+   was skipped because the acceleration is fused into the integrator
+------------------------------------------------------------------------- */
+
+void FixGravity::compute_egrav()
+{
+  double **x = atom->x;
+  double *rmass = atom->rmass;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  egrav = 0.0;
+  for (int i = 0; i < nlocal; i++)
+    if (mask[i] & groupbit)
+      egrav -= rmass[i] * (xacc*x[i][0] + yacc*x[i][1] + zacc*x[i][2]);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixGravity::get_gravity(double *grav)
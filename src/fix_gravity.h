@@ -77,6 +77,8 @@ class FixGravity : public Fix {
 
   void get_gravity(double*); 
 
+  bool fusable(class Fix *);
+
  protected:
   int style;
   double magnitude;
@@ -97,6 +99,10 @@ class FixGravity : public Fix {
   void set_acceleration();
   class FixMultisphere *fm;
   class FixRelaxContacts *fix_relax;
+
+  // acceleration is applied by the time integration fix
+  bool fused_;
+  void compute_egrav();
 };
 
 }
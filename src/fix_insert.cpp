@@ -86,6 +86,10 @@ FixInsert::FixInsert(LAMMPS *lmp, int narg, char **arg) :
 
   setup_flag = false;
 
+  insert_period = 0.;
+  dt_schedule = 0.;
+  next_insert_time = -1.;
+
   fix_distribution = NULL;
   fix_multisphere = NULL;
   multisphere = NULL;
@@ -359,12 +363,20 @@ void FixInsert::setup(int vflag)
 {
   
   // do this only once
-  if(setup_flag) return;
+  // time-step may have been changed between runs
+  if(setup_flag)
+  {
+      if(update->dt != dt_schedule) reset_dt();
+      return;
+  }
   else setup_flag = true;
 
   // calculate ninsert, insert_every, ninsert_per
   calc_insertion_properties();
 
+  insert_period = static_cast<double>(insert_every)*update->dt;
+  dt_schedule = update->dt;
+
   // calc last step of insertion
   if(ninsert_exists)
   {
@@ -586,6 +598,49 @@ void FixInsert::reset_timestep(bigint newstep,bigint oldstep)
     
 }
 
+/* ----------------------------------------------------------------------
+   time-step changed, keep the insertion schedule fixed in physical time
+   so particle and mass rates are not affected
+------------------------------------------------------------------------- */
+
+void FixInsert::reset_dt()
+{
+    const double dt = update->dt;
+    if(dt_schedule <= 0. || dt == dt_schedule) return;
+
+    const bigint ntimestep = update->ntimestep;
+    const double time = update->get_cur_time();
+
+    if(insert_every > 0)
+        insert_every = std::max(1,static_cast<int>(insert_period/dt + 0.5));
+
+    // next insertion step is derived from its time, not from the
+    // already rounded step, so repeated changes do not drift
+
+    if(next_reneighbor > ntimestep)
+    {
+        if(next_insert_time < 0.)
+            next_insert_time = time + static_cast<double>(next_reneighbor - ntimestep) * dt_schedule;
+        const double steps_left = (next_insert_time - time) / dt;
+        next_reneighbor = ntimestep + std::max(static_cast<bigint>(1),static_cast<bigint>(steps_left + 0.5));
+    }
+    else
+        next_insert_time = -1.;
+
+    dt_schedule = dt;
+}
+
+/* ----------------------------------------------------------------------
+   advance to next insertion step, and its time if it is tracked
+------------------------------------------------------------------------- */
+
+void FixInsert::schedule_next_insertion()
+{
+    next_reneighbor += insert_every;
+    if(next_insert_time >= 0.)
+        next_insert_time += insert_period;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int FixInsert::min_type()
@@ -704,7 +759,7 @@ void FixInsert::pre_exchange()
 
       // schedule next insertion
       if (insert_every && (!ninsert_exists || ninserted < ninsert))
-        next_reneighbor += insert_every;
+        schedule_next_insertion();
       
       else if(0 == insert_every)
         next_reneighbor = -1;
@@ -817,7 +872,7 @@ void FixInsert::pre_exchange()
       irregular->migrate_atoms();
 
   // next timestep to insert
-  if (insert_every && (!ninsert_exists || ninserted < ninsert)) next_reneighbor += insert_every;
+  if (insert_every && (!ninsert_exists || ninserted < ninsert)) schedule_next_insertion();
   else next_reneighbor = 0;
 
 }
@@ -1011,6 +1066,7 @@ void FixInsert::restart(char *buf)
   // if insert was already finished in run to be restarted
   if(next_reneighbor_re != 0) next_reneighbor = next_reneighbor_re;
 
+  next_insert_time = -1.;
 }
 
 /* ----------------------------------------------------------------------
@@ -62,6 +62,7 @@ class FixInsert : public Fix {
   virtual int setmask();
   virtual void init();
   void reset_timestep(bigint newstep,bigint oldstep);
+  virtual void reset_dt();
   virtual void setup_pre_exchange() {}
   void setup(int vflag);
   virtual double extend_cut_ghost();
@@ -130,6 +131,14 @@ class FixInsert : public Fix {
   int insert_every;
   double ninsert_per;
 
+  // insertion period in time units and the time-step the schedule refers to
+  double insert_period;
+  double dt_schedule;
+
+  // time of next insertion, so rounding to steps does not accumulate
+  // over repeated time-step changes; < 0 if not yet known
+  double next_insert_time;
+
   // determines how particle distributions are interpreted
   // total number of particles inserted for each vary with calc_ninsert_this() result
   // if exact_number = 0, total # inserted particles will deviate from calc_ninsert_this() result
@@ -228,6 +237,8 @@ class FixInsert : public Fix {
 
   bool setup_flag;
 
+  void schedule_next_insertion();
+
   class Irregular *irregular;
 
   virtual int distribute_ninsert_this(int);
@@ -78,6 +78,7 @@ FixInsertStream::FixInsertStream(LAMMPS *lmp, int narg, char **arg) :
   FixInsert(lmp, narg, arg),
   recalc_release_ms(false),
   dt_ratio(0.),
+  dt_release(0.),
   save_template_(false),
   fix_template_(NULL)
 {
@@ -446,6 +447,8 @@ void FixInsertStream::init()
 
     i_am_integrator = modify->i_am_first_of_style(this);
 
+    if(dt_release == 0.) dt_release = update->dt;
+
     // error check on insertion face
     if(face_style == FACE_NONE)
         error->fix_error(FLERR,this,"must define an insertion face");
@@ -849,7 +852,7 @@ void FixInsertStream::end_of_step()
                 continue;
 
             i_step = static_cast<int>(release_data[i][3]+FIX_INSERT_STREAM_TINY);
-            r_step = static_cast<int>(release_data[i][4]+FIX_INSERT_STREAM_TINY);
+            r_step = release_step(release_data[i][4]);
             vectorCopy3D(&release_data[i][5],v_integrate);
 
             if(step > r_step) continue;
@@ -950,6 +953,71 @@ void FixInsertStream::reset_releasedata(bigint newstep,bigint oldstep)
   }
 }
 
+/* ----------------------------------------------------------------------
+   time-step changed, either between runs or by fix dt/adapt/gran
+   particles still in the insertion volume are re-based to their current
+   position, and their remaining steps until release are rescaled so that
+   they are released after the same physical time
+   the release step is kept unrounded, i.e. it is the release time in units
+   of the current time-step, and only rounded in end_of_step(), so rounding
+   errors do not accumulate over repeated changes
+------------------------------------------------------------------------- */
+
+void FixInsertStream::reset_dt()
+{
+  FixInsert::reset_dt();
+
+  const double dt = update->dt;
+  if(dt_release <= 0. || dt == dt_release) return;
+
+  const double change_ratio = dt_release / dt;
+  const double dt_old = dt_release;
+  dt_release = dt;
+
+  // release data is shared, only the integrating fix re-bases it
+  if(!i_am_integrator) return;
+
+  const bigint step = update->ntimestep;
+  const int nlocal = atom->nlocal;
+  double **release_data = fix_release->array_atom;
+  double dist_elapsed[3];
+
+  for(int i = 0; i < nlocal; i++)
+  {
+        if(MathExtraLiggghts::compDouble(release_data[i][3],0.,1.e-13))
+            continue;
+        if(release_step(release_data[i][4]) <= step)
+            continue;
+
+        // position at current step, integrated with the old time-step
+        const double time_elapsed = (static_cast<double>(step) - release_data[i][3]) * dt_old;
+        vectorScalarMult3D(&release_data[i][5],time_elapsed,dist_elapsed);
+        vectorAdd3D(release_data[i],dist_elapsed,release_data[i]);
+
+        release_data[i][3] = static_cast<double>(step);
+
+        // must not be released in a step that is already done
+        release_data[i][4] = std::max(static_cast<double>(step+1),static_cast<double>(step) + change_ratio*(release_data[i][4] - static_cast<double>(step)));
+  }
+
+  if(!fix_multisphere) return;
+
+  // bodies use the release step of their atoms, so both agree and
+  // do not drift, bodies without a local atom fall back to rescaling
+
+  Multisphere &ms = fix_multisphere->data();
+  ms.recalc_n_steps(change_ratio);
+  for(int i = 0; i < nlocal; i++)
+  {
+        const int body = fix_multisphere->belongs_to(i);
+        if(body < 0 || MathExtraLiggghts::compDouble(release_data[i][3],0.,1.e-13))
+            continue;
+        const int r_step = release_step(release_data[i][4]);
+        if(r_step > step)
+            ms.set_start_step(body,r_step);
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixInsertStream::recalc_release_restart()
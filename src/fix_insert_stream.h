@@ -72,6 +72,7 @@ class FixInsertStream : public FixInsert {
   virtual void init_defaults();
 
   virtual void reset_timestep(bigint newstep,bigint oldstep);
+  virtual void reset_dt();
 
   void register_tracer_callback(class FixPropertyAtomTracerStream* tr);
 
@@ -155,6 +156,13 @@ class FixInsertStream : public FixInsert {
   bool recalc_release_ms;
   double dt_ratio;
 
+  // time-step the release data refers to
+  double dt_release;
+
+  // release step, may be fractional after a time-step change
+  static inline int release_step(double r)
+  { return static_cast<int>(r + 0.5); }
+
   bool save_template_;
   FixPropertyAtom *fix_template_;
 };
@@ -553,6 +553,17 @@ void FixMeshSurface::end_of_step()
         active_mesh_modules[*it]->end_of_step();
 }
 
+/* ----------------------------------------------------------------------
+   Forwards a change of the time step to all modules
+------------------------------------------------------------------------- */
+
+void FixMeshSurface::reset_dt()
+{
+    std::vector<std::string>::iterator it;
+    for(it = mesh_module_order.begin(); it != mesh_module_order.end(); it++)
+        active_mesh_modules[*it]->reset_dt();
+}
+
 /* ----------------------------------------------------------------------
    Checks if any modules compute a vector
 ------------------------------------------------------------------------- */
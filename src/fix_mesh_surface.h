@@ -88,6 +88,7 @@ namespace LAMMPS_NS
         virtual void initial_integrate(int);
         virtual void final_integrate();
         virtual void end_of_step();
+        virtual void reset_dt();
 
         virtual int modify_param(int narg, char **arg);
 
@@ -58,7 +58,6 @@
 #include "neigh_request.h"
 #include "memory.h"
 #include "error.h"
-#include <list>
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -68,7 +67,10 @@ using namespace FixConst;
 FixMultiContactHalfSpace::FixMultiContactHalfSpace(LAMMPS *lmp, int narg, char **arg) :
     Fix(lmp, narg, arg),
     pairgran_(0),
-    geometric_prefactor(1.125)
+    geometric_prefactor(1.125),
+    maxcontact_(0),
+    surfPos_(NULL),
+    contact_(NULL)
 {
     nevery = 1;
 
@@ -107,6 +109,20 @@ FixMultiContactHalfSpace::~FixMultiContactHalfSpace()
 {
     history_vector.clear();
     contact_property_atom_vector.clear();
+
+    delete [] surfPos_;
+    memory->destroy(contact_);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixMultiContactHalfSpace::grow_contacts(int n)
+{
+    maxcontact_ = n;
+    delete [] surfPos_;
+    memory->destroy(contact_);
+    surfPos_ = new double*[maxcontact_];
+    memory->create(contact_,8,maxcontact_,"multicontact/halfspace:contact");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -224,11 +240,27 @@ void FixMultiContactHalfSpace::setup_pre_force(int)
 
 /* ---------------------------------------------------------------------- */
 
+void FixMultiContactHalfSpace::min_setup_pre_force(int)
+{
+    pre_force(0);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixMultiContactHalfSpace::min_pre_force(int)
+{
+    pre_force(0);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixMultiContactHalfSpace::pre_force(int)
 {
     // Clear all data in the FixContactPropertyAtom structure
+    // the pair fix also records where each neighbor pair is stored
     std::vector<FixContactPropertyAtom*>::iterator contact_property_atom = contact_property_atom_vector.begin();
     (*contact_property_atom)->clear();
+    (*contact_property_atom)->reset_pair_slots();
     contact_property_atom++;
     for (; contact_property_atom < contact_property_atom_vector.end(); contact_property_atom++)
         static_cast<FixContactPropertyAtomWall*>(*contact_property_atom)->clear();
@@ -283,6 +315,8 @@ void FixMultiContactHalfSpace::pre_force(int)
 
     // STEP 2:
     // Compute delta_ij from contacts ik (k!=j)
+    // the contacts of particle i are gathered into contiguous scratch rows,
+    // every pair of contacts is visited once and updates both delta values
     /////////////////////////////////////////////////////////
     for (i = 0; i < nlocal; i++) {
 
@@ -293,90 +327,98 @@ void FixMultiContactHalfSpace::pre_force(int)
             const double C1 = -(1.0+nui)/(2.0*M_PI*Yi)*geometric_prefactor;
             const double C2 = 3.0 - 4.0*nui;
             const double C3 = 1.0 - 2.0*nui;
+            const bool useC3 = fabs(C3) > 1e-6;
             // small value for force epsilon
             const double F_eps = Yi*radius[i]*radius[i]*1e-14;
-
-            std::list<double> delta_list;
-            std::list<double*> surfPos;
-            std::list<double> invMagSurfPos;
-            std::list<double>::iterator delta_ij, delta_ik;
-            std::list<double*>::iterator surfPos_ij, surfPos_ik;
-            std::list<double>::iterator invMagSurfPos_ij, invMagSurfPos_ik;
-            // loop over all contacts ij and get pointers to surfPos
+            const double minMagSurfPos = 1e-6*radius[i];
+
+            int ncontact = 0;
+            for (contact_property_atom = contact_property_atom_vector.begin(); contact_property_atom < contact_property_atom_vector.end(); contact_property_atom++)
+                ncontact += (*contact_property_atom)->get_npartners(i);
+            if (ncontact == 0)
+                continue;
+            if (ncontact > maxcontact_)
+                grow_contacts(ncontact);
+
+            double * const sx = contact_[0];
+            double * const sy = contact_[1];
+            double * const sz = contact_[2];
+            double * const f  = contact_[3];
+            double * const nx = contact_[4];
+            double * const ny = contact_[5];
+            double * const nz = contact_[6];
+            double * const delta = contact_[7];
+
+            // gather surface positions, forces and unit normals of all contacts ij
+            int c = 0;
             for (contact_property_atom = contact_property_atom_vector.begin(); contact_property_atom < contact_property_atom_vector.end(); contact_property_atom++) {
-                for (j = 0; j < (*contact_property_atom)->get_npartners(i); j++) {
-                        surfPos.push_back((*contact_property_atom)->contacthistory(i,j));
-                        invMagSurfPos.push_back(1.0/fmax(vectorMag3D(surfPos.back()),1e-6*radius[i]));
-                        delta_list.push_back(0.0);
+                const int n = (*contact_property_atom)->get_npartners(i);
+                for (j = 0; j < n; j++) {
+                    double * const surfPos = (*contact_property_atom)->contacthistory(i,j);
+                    const double invMagSurfPos = 1.0/fmax(vectorMag3D(surfPos),minMagSurfPos);
+                    surfPos_[c] = surfPos;
+                    sx[c] = surfPos[0];
+                    sy[c] = surfPos[1];
+                    sz[c] = surfPos[2];
+                    f[c] = surfPos[3];
+                    nx[c] = surfPos[0]*invMagSurfPos;
+                    ny[c] = surfPos[1]*invMagSurfPos;
+                    nz[c] = surfPos[2]*invMagSurfPos;
+                    delta[c] = 0.0;
+                    c++;
                 }
             }
 
-            // loop over all contacts ij
-            for (surfPos_ij = surfPos.begin(), invMagSurfPos_ij = invMagSurfPos.begin(), delta_ij = delta_list.begin();
-                 *surfPos_ij != surfPos.back();
-                 surfPos_ij++, invMagSurfPos_ij++, delta_ij++) {
-
-                // loop over all contacts ik
-                surfPos_ik = surfPos_ij;
-                invMagSurfPos_ik = invMagSurfPos_ij;
-                delta_ik = delta_ij;
-                do {
-                    surfPos_ik++;
-                    invMagSurfPos_ik++;
-                    delta_ik++;
-
-                    const double f_ij = (*surfPos_ij)[3];
-                    const double f_ik = (*surfPos_ik)[3];
-
-                    if (f_ij > F_eps || f_ik > F_eps) { // check if one of the force magnitudes is larger than the threshold
-                        double ukc[3];
-                        vectorSubtract3D(*surfPos_ij, *surfPos_ik, ukc);
-                        const double invDkc = 1.0/vectorMag3D(ukc);
-                        if (invDkc < 1e10) {
-                            const double nk_dot_nc = vectorDot3D(*surfPos_ij, *surfPos_ik)*(*invMagSurfPos_ij)*(*invMagSurfPos_ik);
-                            const double ukc_dot_nc = -vectorDot3D(ukc, *surfPos_ij)*(*invMagSurfPos_ij)*invDkc;
-                            const double ukc_dot_nk = -vectorDot3D(ukc, *surfPos_ik)*(*invMagSurfPos_ik)*invDkc;
-                            double careful_expression = C2*nk_dot_nc + ukc_dot_nk*ukc_dot_nc;
-                            if (f_ik > F_eps) {
-                                double c3term = 0.0;
-                                if (fabs(C3) > 1e-6) {
-                                    const double divisor = 1.0 + ukc_dot_nk;
-                                    if (divisor > 1e-6)
-                                        c3term = -C3*(nk_dot_nc + ukc_dot_nc)/divisor;
-                                }
-                                *delta_ij += C1*f_ik * (careful_expression + c3term) * invDkc;
-                            }
-                            if (f_ij > F_eps) {
-                                double c3term = 0.0;
-                                if (fabs(C3) > 1e-6) {
-                                    const double divisor = 1.0 - ukc_dot_nc;
-                                    if (divisor > 1e-6)
-                                        c3term = -C3*(nk_dot_nc - ukc_dot_nk)/divisor;
-                                }
-                                *delta_ik += C1*f_ij * (careful_expression + c3term) * invDkc;
-                            }
+            // loop over all pairs of contacts ij (index c) and ik (index k)
+            for (c = 0; c < ncontact-1; c++) {
+                const double f_ij = f[c];
+                double delta_ij = 0.0;
+
+                for (int k = c+1; k < ncontact; k++) {
+                    const double f_ik = f[k];
+
+                    // check if one of the force magnitudes is larger than the threshold
+                    if (f_ij <= F_eps && f_ik <= F_eps)
+                        continue;
+
+                    const double ukc0 = sx[c] - sx[k];
+                    const double ukc1 = sy[c] - sy[k];
+                    const double ukc2 = sz[c] - sz[k];
+                    const double invDkc = 1.0/sqrt(ukc0*ukc0 + ukc1*ukc1 + ukc2*ukc2);
+                    if (!(invDkc < 1e10))
+                        continue;
+
+                    const double nk_dot_nc = nx[c]*nx[k] + ny[c]*ny[k] + nz[c]*nz[k];
+                    const double ukc_dot_nc = -(ukc0*nx[c] + ukc1*ny[c] + ukc2*nz[c])*invDkc;
+                    const double ukc_dot_nk = -(ukc0*nx[k] + ukc1*ny[k] + ukc2*nz[k])*invDkc;
+                    const double careful_expression = C2*nk_dot_nc + ukc_dot_nk*ukc_dot_nc;
+
+                    if (f_ik > F_eps) {
+                        double c3term = 0.0;
+                        if (useC3) {
+                            const double divisor = 1.0 + ukc_dot_nk;
+                            if (divisor > 1e-6)
+                                c3term = -C3*(nk_dot_nc + ukc_dot_nc)/divisor;
                         }
+                        delta_ij += C1*f_ik * (careful_expression + c3term) * invDkc;
+                    }
+                    if (f_ij > F_eps) {
+                        double c3term = 0.0;
+                        if (useC3) {
+                            const double divisor = 1.0 - ukc_dot_nc;
+                            if (divisor > 1e-6)
+                                c3term = -C3*(nk_dot_nc - ukc_dot_nk)/divisor;
+                        }
+                        delta[k] += C1*f_ij * (careful_expression + c3term) * invDkc;
                     }
-                } while (*surfPos_ik != surfPos.back());
-            }
-
-            // loop over all contacts ij to save the delta values instead of the f.n values that were saved in the contact property atom structure before
-            // this needs to be done after in order to avoid a race condition
-            delta_ij = delta_list.begin();
-            surfPos_ij = surfPos.begin();
-            // loop over all contacts ij
-            for (contact_property_atom = contact_property_atom_vector.begin(); contact_property_atom < contact_property_atom_vector.end(); contact_property_atom++) {
-                for (j = 0; j < (*contact_property_atom)->get_npartners(i); j++) {
-                    // get the pointer to the contact history
-                    // replace f.n in the contactpropertyatom structure with delta_ij
-                    (*surfPos_ij)[3] = *delta_ij;
-                    // advance delta list iterator
-                    delta_ij++;
-                    surfPos_ij++;
                 }
+                delta[c] += delta_ij;
             }
-            // clear the delta list so that it can be refilled for the next grain
-            delta_list.clear();
+
+            // replace f.n in the contactpropertyatom structure with delta_ij
+            // this needs to be done after all pairs are processed since f.n is read above
+            for (c = 0; c < ncontact; c++)
+                surfPos_[c][3] = delta[c];
         }
     }
 
@@ -403,8 +445,15 @@ double * const HistoryData::get_data_ptr(const int i, const int jj)
 {
     if (type == 'p') {
         NeighList* list = static_cast<PairGranProxy*>(fix_ptr)->list;
-        double * const all_contact_list = list->listgranhistory->firstdouble[i];
+        histtype * const all_contact_list = list->listgranhistory->firstdouble[i];
+#ifdef LIGGGHTS_FLOAT_HISTORY
+        const histtype * const h = &all_contact_list[jj*list->listgranhistory->dnum + offset];
+        for (int d = 0; d < 3; d++)
+            pair_data[d] = h[d];
+        return pair_data;
+#else
         return &all_contact_list[jj*list->listgranhistory->dnum + offset];
+#endif
     } else if (type == 'm') {
         const int j = static_cast<FixContactHistoryMesh*>(fix_ptr)->get_contact(i, jj);
         return static_cast<FixContactHistoryMesh*>(fix_ptr)->contacthistory(i,j) + sizeof(double)*offset;
@@ -465,8 +514,7 @@ void HistoryData::save_contact_property_atom(const int i, const int jj, const in
     if (type == 'p') {
         const NeighList * const list = static_cast<PairGranProxy*>(fix_ptr)->list;
         const int j = list->firstneigh[i][jj];
-        cpa->add_partner(i, tag[j], surfPos_ij);
-        cpa->add_partner(j, tag[i], surfPos_ji);
+        cpa->add_pair(i, jj, j, tag[i], tag[j], surfPos_ij, surfPos_ji);
     } else if (type == 'm') {
         const FixContactHistoryMesh * const fix_history = static_cast<FixContactHistoryMesh*>(fix_ptr);
         const int idTri = fix_history->get_partner_idTri(i, jj);
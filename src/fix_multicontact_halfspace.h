@@ -65,6 +65,9 @@ private:
     char type;
     void *fix_ptr;
     int offset;
+#ifdef LIGGGHTS_FLOAT_HISTORY
+    double pair_data[3]; // pair history widened to double
+#endif
 public:
     HistoryData(const char c, void* const ptr, const int i) :
         type(c),
@@ -96,6 +99,8 @@ class FixMultiContactHalfSpace : public Fix {
 
     void setup_pre_force(int);
     void pre_force(int);
+    void min_setup_pre_force(int);
+    void min_pre_force(int);
 
    private:
 
@@ -118,6 +123,15 @@ class FixMultiContactHalfSpace : public Fix {
     // list of all fixes that contain contact property atom (wall) fixes
     std::vector<FixContactPropertyAtom*> contact_property_atom_vector;
 
+    // scratch for the contacts of one particle in STEP 2 of pre_force
+    // surfPos_ points into the contact property atom fixes, contact_ holds
+    // rows of contiguous values (surface position, force, normal, delta)
+    int maxcontact_;
+    double **surfPos_;
+    double **contact_;
+
+    void grow_contacts(int n);
+
 };
 
 }
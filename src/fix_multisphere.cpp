@@ -98,6 +98,7 @@ FixMultisphere::FixMultisphere(LAMMPS *lmp, int narg, char **arg) :
   rev_comm_flag_(MS_COMM_UNDEFINED),
   body_(NULL),
   displace_(NULL),
+  bsphere_(NULL),
   ntypes_(0),
   Vclump_(0),
   allow_group_and_set_(false),
@@ -235,6 +236,9 @@ FixMultisphere::~FixMultisphere()
     delete &multisphere_;
 
     memory->destroy(displace_);
+    memory->destroy(bsphere_);
+
+    neighbor->set_body_spheres(NULL);
 
     if(accepts_restart_data_from_style)
     {
@@ -437,6 +441,15 @@ void FixMultisphere::init()
 
 /* ---------------------------------------------------------------------- */
 
+void FixMultisphere::reset_dt()
+{
+    dtv = update->dt;
+    dtf = 0.5 * update->dt * force->ftm2v;
+    dtq = 0.5 * update->dt;
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixMultisphere::add_remove_callback(FixRemove *ptr)
 {
     fix_remove_.push_back(ptr);
@@ -1298,6 +1311,47 @@ void FixMultisphere::pre_neighbor()
     MPI_Max_Scalar(forceNeighbour,world);
     if (forceNeighbour)
         next_reneighbor = update->ntimestep + 5;
+
+    set_bsphere();
+}
+
+/* ----------------------------------------------------------------------
+   set bounding sphere of the body of each owned and ghost atom for the
+   body-level broad phase of the neighbor list build
+   stored as offset from atom to sphere center, which is invariant to
+   periodic shifts, so ghosts need no pbc correction
+   computed where the body is owned, then reverse and forward communicated
+------------------------------------------------------------------------- */
+
+void FixMultisphere::set_bsphere()
+{
+    int nall = atom->nlocal + atom->nghost;
+    double **ex_space = multisphere_.ex_space_.begin();
+    double **ey_space = multisphere_.ey_space_.begin();
+    double **ez_space = multisphere_.ez_space_.begin();
+    double **xcm_to_xbound = multisphere_.xcm_to_xbound_.begin();
+    double *r_bound = multisphere_.r_bound_.begin();
+    double delta[3];
+
+    for(int i = 0; i < nall; i++)
+    {
+        bsphere_[i][3] = -1.;
+
+        if(body_[i] < 0) continue;
+        int ibody = map(body_[i]);
+        if(ibody < 0) continue;
+
+        vectorSubtract3D(xcm_to_xbound[ibody],displace_[i],delta);
+        MathExtra::matvec(ex_space[ibody],ey_space[ibody],ez_space[ibody],delta,bsphere_[i]);
+        bsphere_[i][3] = r_bound[ibody];
+    }
+
+    rev_comm_flag_ = MS_COMM_REV_BSPHERE;
+    reverse_comm();
+    fw_comm_flag_ = MS_COMM_FW_BSPHERE;
+    forward_comm();
+
+    neighbor->set_body_spheres(bsphere_);
 }
 
 /* ----------------------------------------------------------------------
@@ -1324,6 +1378,7 @@ double FixMultisphere::memory_usage()
   int nmax = atom->nmax;
   double bytes = nmax * sizeof(int);
   bytes += nmax*3 * sizeof(double);
+  bytes += nmax*4 * sizeof(double);
   bytes += maxvatom*6 * sizeof(double);
 
   // add Multisphere memory usage
@@ -1340,6 +1395,16 @@ void FixMultisphere::grow_arrays(int nmax)
     
     body_ = memory->grow(body_,nmax,"rigid:body_");
     memory->grow(displace_,nmax,3,"rigid:displace");
+
+    // reallocation moves bsphere_, so update the neighbor's pointer and
+    // mark the new rows unknown until set_bsphere() fills them
+
+    const int first = bsphere_ ? atom->nlocal + atom->nghost : 0;
+    memory->grow(bsphere_,nmax,4,"rigid:bsphere");
+    for(int i = first; i < nmax; i++)
+        bsphere_[i][3] = -1.;
+    neighbor->set_body_spheres(bsphere_);
+
     atom->molecule = body_;
 }
 
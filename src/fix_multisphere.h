@@ -69,11 +69,13 @@ enum
     MS_COMM_FW_V_OMEGA,
     MS_COMM_FW_F_TORQUE,
     MS_COMM_FW_TEMP,
+    MS_COMM_FW_BSPHERE,
     MS_COMM_REV_X_V_OMEGA,
     MS_COMM_REV_V_OMEGA,
     MS_COMM_REV_IMAGE,
     MS_COMM_REV_DISPLACE,
-    MS_COMM_REV_TEMP
+    MS_COMM_REV_TEMP,
+    MS_COMM_REV_BSPHERE
 };
 
 class FixMultisphere : public Fix
@@ -90,6 +92,7 @@ class FixMultisphere : public Fix
       void pre_delete(bool unfixflag);
       virtual int setmask();
       virtual void init();
+      void reset_dt();
 
       virtual void setup(int);
       virtual void setup_pre_force(int);
@@ -240,6 +243,7 @@ class FixMultisphere : public Fix
       void set_xv(int);
       void set_v();
       void set_v(int);
+      void set_bsphere();
 
       bool do_modify_body_forces_torques_;
       virtual void modify_body_forces_torques() {}
@@ -260,6 +264,7 @@ class FixMultisphere : public Fix
       // per-atom properties handled by this fix
       int *body_;                // which body each atom is part of (-1 if none)
       double **displace_;        // displacement of each atom in body coords
+      double **bsphere_;         // offset to bounding sphere center of body, radius
 
       double dtv,dtf,dtq;
 
@@ -67,6 +67,7 @@
 #include "math_extra_liggghts.h"
 #include "math_const.h"
 #include "variable.h"
+#include "pair_gran.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -273,6 +274,8 @@ void FixMultisphereBreak::pre_neighbor()
     fw_comm_flag_ = MS_COMM_FW_IMAGE_DISPLACE;
     forward_comm();
 
+    set_bsphere();
+
     // DO NOT merge delflag and existflag, since we would like to keep atoms that are not in a body
 //    int nlocal = atom->nlocal;
 //    delflag =   fix_delflag_->vector_atom;
@@ -393,7 +396,14 @@ void FixMultisphereBreak::final_integrate()
 
     }
     if(haveRemovedAtoms>0)
+    {
         FixMultisphere::add_body_finalize();
+
+        // released spheres carry their own mass from now on
+        PairGran *pg = static_cast<PairGran*>(force->pair_match("gran",0));
+        if(pg)
+            pg->reset_pair_cache();
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -196,6 +196,8 @@ void FixMultisphere::unpack_comm(int n, int first, double *buf)
         unpack_comm_f_torque(n,first,buf);
     else if(fw_comm_flag_ == MS_COMM_FW_TEMP)
         unpack_comm_temp(n,first,buf);
+    else if(fw_comm_flag_ == MS_COMM_FW_BSPHERE)
+        unpack_comm_bsphere(n,first,buf);
     else error->fix_error(FLERR,this,"FixMultisphere::unpack_comm internal error");
 }
 
@@ -293,6 +295,33 @@ void FixMultisphere::unpack_comm_temp(int n, int first, double *buf)
     }
 }
 
+/* ---------------------------------------------------------------------- */
+
+int FixMultisphere::pack_comm_bsphere(int n, int *list, double *buf, int pbc_flag, int *pbc)
+{
+    //we dont need to account for pbc here, offset is shift invariant
+    int i,j, m = 0;
+    for (i = 0; i < n; i++)
+    {
+        j = list[i];
+
+        vectorToBuf4D(bsphere_[j],buf,m);
+    }
+    return 4;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixMultisphere::unpack_comm_bsphere(int n, int first, double *buf)
+{
+    int i,m,last;
+
+    m = 0;
+    last = first + n;
+    for (i = first; i < last; i++)
+        bufToVector4D(bsphere_[i],buf,m);
+}
+
 /* ----------------------------------------------------------------------
    forward comm
 ------------------------------------------------------------------------- */
@@ -322,6 +351,8 @@ int FixMultisphere::pack_reverse_comm(int n, int first, double *buf)
         return pack_reverse_comm_displace(n,first,buf);
     else if(rev_comm_flag_ == MS_COMM_REV_TEMP)
         return pack_reverse_comm_temp(n,first,buf);
+    else if(rev_comm_flag_ == MS_COMM_REV_BSPHERE)
+        return pack_reverse_comm_bsphere(n,first,buf);
     else error->fix_error(FLERR,this,"FixMultisphere::pack_reverse_comm internal error");
     return 0;
 }
@@ -483,6 +514,8 @@ void FixMultisphere::unpack_reverse_comm(int n, int *list, double *buf)
         unpack_reverse_comm_displace(n,list,buf);
     else if(rev_comm_flag_ == MS_COMM_REV_TEMP)
         unpack_reverse_comm_temp(n,list,buf);
+    else if(rev_comm_flag_ == MS_COMM_REV_BSPHERE)
+        unpack_reverse_comm_bsphere(n,list,buf);
     else error->fix_error(FLERR,this,"FixMultisphere::unpack_reverse_comm internal error");
 }
 
@@ -619,6 +652,38 @@ void FixMultisphere::unpack_reverse_comm_temp(int n, int *list, double *buf)
     }
 }
 
+/* ---------------------------------------------------------------------- */
+
+int FixMultisphere::pack_reverse_comm_bsphere(int n, int first, double *buf)
+{
+    int i,m,last;
+
+    m = 0;
+    last = first + n;
+    for (i = first; i < last; i++)
+    {
+        buf[m++] = bsphere_[i][3] < 0. ? 0. : 1.;
+        vectorToBuf4D(bsphere_[i],buf,m);
+    }
+    return 5;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixMultisphere::unpack_reverse_comm_bsphere(int n, int *list, double *buf)
+{
+    int i,j,flag,m = 0;
+
+    for (i = 0; i < n; i++) {
+        j = list[i];
+
+        flag = static_cast<int>(buf[m++]);
+        if(flag)
+            bufToVector4D(bsphere_[j],buf,m);
+        else m += 4;
+    }
+}
+
 /* ----------------------------------------------------------------------
    pack comm
 ------------------------------------------------------------------------- */
@@ -636,6 +701,8 @@ int FixMultisphere::pack_comm(int n, int *list, double *buf, int pbc_flag, int *
         return pack_comm_f_torque(n,list,buf,pbc_flag,pbc);
     else if(fw_comm_flag_ == MS_COMM_FW_TEMP)
         return pack_comm_temp(n,list,buf,pbc_flag,pbc);
+    else if(fw_comm_flag_ == MS_COMM_FW_BSPHERE)
+        return pack_comm_bsphere(n,list,buf,pbc_flag,pbc);
     else error->fix_error(FLERR,this,"FixMultisphere::pack_comm internal error");
     return 0;
 }
@@ -59,6 +59,7 @@
       int pack_comm_v_omega(int, int*, double*, int, int*);
       int pack_comm_f_torque(int, int*, double*, int, int*);
       int pack_comm_temp(int, int*, double*, int, int*);
+      int pack_comm_bsphere(int, int*, double*, int, int*);
 
       void unpack_comm(int, int, double*);
       void unpack_comm_body(int, int, double*);
@@ -66,6 +67,7 @@
       void unpack_comm_v_omega(int, int, double*);
       void unpack_comm_f_torque(int, int, double*);
       void unpack_comm_temp(int, int, double*);
+      void unpack_comm_bsphere(int, int, double*);
 
       int pack_reverse_comm(int, int, double*);
       int pack_reverse_comm_x_v_omega(int, int, double*);
@@ -73,11 +75,13 @@
       int pack_reverse_comm_image(int n, int first, double *buf);
       int pack_reverse_comm_displace(int n, int first, double *buf);
       int pack_reverse_comm_temp(int n, int first, double *buf);
+      int pack_reverse_comm_bsphere(int n, int first, double *buf);
       void unpack_reverse_comm(int, int*, double*);
       void unpack_reverse_comm_x_v_omega(int, int*, double*);
       void unpack_reverse_comm_v_omega(int, int*, double*);
       void unpack_reverse_comm_image(int n, int *list, double *buf);
       void unpack_reverse_comm_displace(int n, int *list, double *buf);
       void unpack_reverse_comm_temp(int n, int *list, double *buf);
+      void unpack_reverse_comm_bsphere(int n, int *list, double *buf);
 
 #endif
@@ -61,6 +61,9 @@
 #include "force.h"
 #include "error.h"
 #include "domain.h" 
+#include "modify.h"
+#include "comm.h"
+#include "fix_gravity.h"
 //
 #include "global_properties.h"
 //
@@ -79,12 +82,14 @@ FixNVESphere::FixNVESphere(LAMMPS *lmp, int narg, char **arg) :
   FixNVE(lmp, narg, arg),
   useAM_(false),
   CAddRhoFluid_(0.0),
+  onePlusCAddRhoFluid_(1.0),
 //
   useCGMethod_(false),
   CoeffCGMethod_(1.0),
 //
-  onePlusCAddRhoFluid_(1.0)
-
+  fuseGravity_(false),
+  nfused_(0),
+  fix_gravity_(NULL)
 {
   if (narg < 3) error->all(FLERR,"Illegal fix nve/sphere command");
 
@@ -124,6 +129,12 @@ FixNVESphere::FixNVESphere(LAMMPS *lmp, int narg, char **arg) :
 //
       else error->all(FLERR,"Illegal fix nve/sphere command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"fuse_gravity") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix nve/sphere command");
+      if (strcmp(arg[iarg+1],"yes") == 0) fuseGravity_ = true;
+      else if (strcmp(arg[iarg+1],"no") == 0) fuseGravity_ = false;
+      else error->all(FLERR,"Illegal fix nve/sphere command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal fix nve/sphere command");
   }
 
@@ -137,10 +148,35 @@ FixNVESphere::FixNVESphere(LAMMPS *lmp, int narg, char **arg) :
 
 /* ---------------------------------------------------------------------- */
 
+FixNVESphere::~FixNVESphere()
+{
+  delete [] fix_gravity_;
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixNVESphere::init()
 {
   FixNVE::init();
 
+  // collect the gravity fixes that leave their acceleration to this fix
+  // fix gravity makes the same decision in its own init()
+
+  delete [] fix_gravity_;
+  fix_gravity_ = NULL;
+  nfused_ = 0;
+
+  if (fuseGravity_) {
+    int ngravity = modify->n_fixes_style("gravity");
+    if (ngravity) fix_gravity_ = new FixGravity*[ngravity];
+    for (int ig = 0; ig < ngravity; ig++) {
+      FixGravity *fg = static_cast<FixGravity*>(modify->find_fix_style("gravity",ig));
+      if (fg->fusable(this)) fix_gravity_[nfused_++] = fg;
+      else if (comm->me == 0)
+        error->warning(FLERR,"Fix nve/sphere can not fuse fix gravity, it is applied as a force");
+    }
+  }
+
   // check that all particles are finite-size spheres
   // no point particles allowed
 
@@ -154,6 +190,28 @@ void FixNVESphere::init()
         error->one(FLERR,"Fix nve/sphere requires extended particles");
 }
 
+/* ----------------------------------------------------------------------
+   velocity increment over a half step due to the fused gravity fixes
+------------------------------------------------------------------------- */
+
+void FixNVESphere::fused_velocity_increment(double *dv)
+{
+  dv[0] = dv[1] = dv[2] = 0.0;
+
+  double grav[3];
+  for (int ig = 0; ig < nfused_; ig++) {
+    fix_gravity_[ig]->get_gravity(grav);
+    dv[0] += grav[0];
+    dv[1] += grav[1];
+    dv[2] += grav[2];
+  }
+
+  const double dtg = dtf / onePlusCAddRhoFluid_;
+  dv[0] *= dtg;
+  dv[1] *= dtg;
+  dv[2] *= dtg;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixNVESphere::initial_integrate(int vflag)
@@ -178,6 +236,13 @@ void FixNVESphere::initial_integrate(int vflag)
   if (domain->dimension == 2) dtfrotate = dtf / 0.5; // for discs the formula is I=0.5*Mass*Radius^2
   else dtfrotate  = dtf / INERTIA;
 
+  // kcg^2 scales the angular acceleration in the coarse grained method
+  // the fused gravity is a constant velocity increment
+
+  const double cg2 = CoeffCGMethod_*CoeffCGMethod_;
+  double dvg[3];
+  fused_velocity_increment(dvg);
+
   // update 1/2 step for v and omega, and full step for  x for all particles
   // d_omega/dt = torque / inertia
 
@@ -187,9 +252,9 @@ void FixNVESphere::initial_integrate(int vflag)
       // velocity update for 1/2 step
       dtfm = dtf / (rmass[i]*onePlusCAddRhoFluid_);
 
-      v[i][0] += dtfm * f[i][0];
-      v[i][1] += dtfm * f[i][1];
-      v[i][2] += dtfm * f[i][2];
+      v[i][0] += dtfm * f[i][0] + dvg[0];
+      v[i][1] += dtfm * f[i][1] + dvg[1];
+      v[i][2] += dtfm * f[i][2] + dvg[2];
 
       // position update
       x[i][0] += dtv * v[i][0];
@@ -199,9 +264,9 @@ void FixNVESphere::initial_integrate(int vflag)
       // rotation update
       dtirotate = dtfrotate / (radius[i]*radius[i]*rmass[i]);
 //kcg mod
-      omega[i][0] += pow(CoeffCGMethod_, 2) * dtirotate * torque[i][0];
-      omega[i][1] += pow(CoeffCGMethod_, 2) * dtirotate * torque[i][1];
-      omega[i][2] += pow(CoeffCGMethod_, 2) * dtirotate * torque[i][2];
+      omega[i][0] += cg2 * dtirotate * torque[i][0];
+      omega[i][1] += cg2 * dtirotate * torque[i][1];
+      omega[i][2] += cg2 * dtirotate * torque[i][2];
 //
     }
   }
@@ -249,6 +314,10 @@ void FixNVESphere::final_integrate()
   if (domain->dimension == 2) dtfrotate = dtf / 0.5; // for discs the formula is I=0.5*Mass*Radius^2
   else dtfrotate  = dtf / INERTIA;
 
+  const double cg2 = CoeffCGMethod_*CoeffCGMethod_;
+  double dvg[3];
+  fused_velocity_increment(dvg);
+
   // update 1/2 step for v,omega for all particles
   // d_omega/dt = torque / inertia
 
@@ -258,16 +327,16 @@ void FixNVESphere::final_integrate()
       // velocity update for 1/2 step
       dtfm = dtf / (rmass[i]*onePlusCAddRhoFluid_);
 
-      v[i][0] += dtfm * f[i][0];
-      v[i][1] += dtfm * f[i][1];
-      v[i][2] += dtfm * f[i][2];
+      v[i][0] += dtfm * f[i][0] + dvg[0];
+      v[i][1] += dtfm * f[i][1] + dvg[1];
+      v[i][2] += dtfm * f[i][2] + dvg[2];
  
       // rotation update
       dtirotate = dtfrotate / (radius[i]*radius[i]*rmass[i]);
 //kcg mod
-      omega[i][0] += pow(CoeffCGMethod_, 2) * dtirotate * torque[i][0];
-      omega[i][1] += pow(CoeffCGMethod_, 2) * dtirotate * torque[i][1];
-      omega[i][2] += pow(CoeffCGMethod_, 2) * dtirotate * torque[i][2];
+      omega[i][0] += cg2 * dtirotate * torque[i][0];
+      omega[i][1] += cg2 * dtirotate * torque[i][1];
+      omega[i][2] += cg2 * dtirotate * torque[i][2];
 //
     }
 }
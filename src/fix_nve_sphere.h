@@ -65,11 +65,14 @@ namespace LAMMPS_NS {
 class FixNVESphere : public FixNVE {
  public:
   FixNVESphere(class LAMMPS *, int, char **);
-  virtual ~FixNVESphere() {}
+  virtual ~FixNVESphere();
   void init();
   virtual void initial_integrate(int);
   virtual void final_integrate();
 
+  bool fuse_gravity() const
+  { return fuseGravity_; }
+
  protected:
   int extra;
 
@@ -81,6 +84,13 @@ class FixNVESphere : public FixNVE {
   bool   useCGMethod_;
   double CoeffCGMethod_;    //kcg in coarse grained DEM method
 //
+
+  // constant gravity applied in the velocity update instead of via f
+  bool fuseGravity_;
+  int nfused_;
+  class FixGravity **fix_gravity_;
+
+  void fused_velocity_increment(double *dv);
 };
 
 }
@@ -108,4 +118,10 @@ E: Fix nve/sphere requires extended particles
 
 This fix can only be used for particles of a finite size.
 
+W: Fix nve/sphere can not fuse fix gravity, it is applied as a force
+
+Fusing requires a constant gravity acting on the same group, no other
+time integration fix, no fix multisphere or relax and no fix that
+overwrites forces. Otherwise fix gravity adds its force as usual.
+
 */
@@ -0,0 +1,403 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+#include "fix_nve_sphere_subcycle.h"
+#include "fix_wall_gran.h"
+#include "fix_property_atom.h"
+#include "atom.h"
+#include "update.h"
+#include "force.h"
+#include "domain.h"
+#include "modify.h"
+#include "memory.h"
+#include "error.h"
+#include "vector_liggghts.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define INERTIA 0.4          // moment of inertia prefactor for sphere
+
+/* ----------------------------------------------------------------------
+   the keywords of fix nve/sphere are not passed on
+------------------------------------------------------------------------- */
+
+FixNVESphereSubcycle::FixNVESphereSubcycle(LAMMPS *lmp, int narg, char **arg) :
+  FixNVESphere(lmp, 3, arg),
+  nsub_(0),
+  nwall_(0),
+  wall_id_(NULL),
+  wall_(NULL),
+  fix_fast_(NULL),
+  nmax_(0),
+  near_(NULL),
+  nnear_(0),
+  nearlist_(NULL),
+  ffast_(NULL),
+  tfast_(NULL)
+{
+  int iarg = 3;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"nsub") == 0) {
+      if (iarg+2 > narg) error->fix_error(FLERR,this,"not enough arguments for 'nsub'");
+      nsub_ = force->inumeric(FLERR,arg[iarg+1]);
+      if (nsub_ < 1) error->fix_error(FLERR,this,"'nsub' must be > 0");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"walls") == 0) {
+      if (iarg+2 > narg) error->fix_error(FLERR,this,"not enough arguments for 'walls'");
+      if (wall_id_) error->fix_error(FLERR,this,"'walls' may only be used once");
+      nwall_ = force->inumeric(FLERR,arg[iarg+1]);
+      if (nwall_ < 1) error->fix_error(FLERR,this,"number of walls must be > 0");
+      if (iarg+2+nwall_ > narg) error->fix_error(FLERR,this,"not enough arguments for 'walls'");
+      wall_id_ = new char*[nwall_];
+      for (int w = 0; w < nwall_; w++) {
+        wall_id_[w] = new char[strlen(arg[iarg+2+w])+1];
+        strcpy(wall_id_[w],arg[iarg+2+w]);
+      }
+      iarg += 2+nwall_;
+    } else error->fix_error(FLERR,this,"unknown keyword");
+  }
+
+  if (!nsub_) error->fix_error(FLERR,this,"expecting keyword 'nsub'");
+  if (!nwall_) error->fix_error(FLERR,this,"expecting keyword 'walls'");
+
+  wall_ = new FixWallGran*[nwall_];
+  for (int w = 0; w < nwall_; w++) wall_[w] = NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixNVESphereSubcycle::~FixNVESphereSubcycle()
+{
+  for (int w = 0; w < nwall_; w++) delete [] wall_id_[w];
+  delete [] wall_id_;
+  delete [] wall_;
+
+  memory->destroy(near_);
+  memory->destroy(nearlist_);
+  memory->destroy(ffast_);
+  memory->destroy(tfast_);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::post_create()
+{
+  // register storage for the wall force and torque of the last substep
+
+  if (!fix_fast_) {
+    char *fast_name = new char[strlen(id)+1+15];
+    sprintf(fast_name,"subcycle_force_%s",id);
+    const char *fixarg[14];
+    fixarg[0] = fast_name;
+    fixarg[1] = "all";
+    fixarg[2] = "property/atom";
+    fixarg[3] = fast_name;
+    fixarg[4] = "vector";
+    fixarg[5] = "no";    // restart
+    fixarg[6] = "no";    // communicate ghost
+    fixarg[7] = "no";    // communicate rev
+    for (int k = 8; k < 14; k++) fixarg[k] = "0.";
+    modify->add_fix(14,const_cast<char**>(fixarg));
+    fix_fast_ =
+        static_cast<FixPropertyAtom*>(modify->find_fix_property(fast_name,"property/atom","vector",6,0,style));
+    delete [] fast_name;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::pre_delete(bool unfixflag)
+{
+  if (unfixflag && fix_fast_)
+    modify->delete_fix(fix_fast_->id);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::init()
+{
+  FixNVESphere::init();
+
+  if (strstr(update->integrate_style,"respa"))
+    error->fix_error(FLERR,this,"does not support run_style respa");
+
+  const int me = modify->find_fix(id);
+  for (int w = 0; w < nwall_; w++) {
+    const int ifix = modify->find_fix(wall_id_[w]);
+    if (ifix < 0)
+      error->fix_error(FLERR,this,"could not find the wall fix to subcycle");
+    if (strncmp(modify->fix[ifix]->style,"wall/gran",9) != 0)
+      error->fix_error(FLERR,this,"can only subcycle fixes of style wall/gran");
+    wall_[w] = static_cast<FixWallGran*>(modify->fix[ifix]);
+    if (wall_[w]->is_mesh_wall() || wall_[w]->is_moving())
+      error->fix_error(FLERR,this,"can only subcycle primitive walls that do not move");
+    if (ifix > me)
+      error->fix_error(FLERR,this,"must be defined after the walls it subcycles");
+    if (igroup != 0 && wall_[w]->igroup != igroup)
+      error->fix_error(FLERR,this,"requires the walls to act on its group");
+  }
+
+  fix_fast_ = static_cast<FixPropertyAtom*>
+    (modify->find_fix_property(fix_fast_->id,"property/atom","vector",6,0,style));
+}
+
+/* ----------------------------------------------------------------------
+   true if the contact forces of wall fix are computed by this fix
+------------------------------------------------------------------------- */
+
+bool FixNVESphereSubcycle::subcycles(FixWallGran *wall) const
+{
+  for (int w = 0; w < nwall_; w++)
+    if (strcmp(wall->id,wall_id_[w]) == 0) return true;
+  return false;
+}
+
+/* ----------------------------------------------------------------------
+   wall forces at the start of the run, the walls do not update
+   their contact history during setup
+------------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::setup(int vflag)
+{
+  // heat transfer is set up in the setup of the walls, which comes first
+
+  for (int w = 0; w < nwall_; w++)
+    if (wall_[w]->heattransfer_flag())
+      error->fix_error(FLERR,this,"does not support heat transfer of subcycled walls");
+
+  grow_scratch();
+  flag_near();
+  compute_fast(true);
+  clear_far();
+}
+
+/* ----------------------------------------------------------------------
+   impulse multiple time-stepping
+   the slow forces in f (pair and all other fixes) are applied as a kick
+   of dt/2 at the start and end of the step, the forces of the subcycled
+   walls are integrated with velocity Verlet and dt/nsub in between
+   only particles in the neighbor lists of the walls are subcycled,
+   all others do the full step drift
+------------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::initial_integrate(int vflag)
+{
+  double dtfm,dtirotate;
+
+  double **x = atom->x;
+  double **v = atom->v;
+  double **f = atom->f;
+  double **omega = atom->omega;
+  double **torque = atom->torque;
+  double *radius = atom->radius;
+  double *rmass = atom->rmass;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  if (igroup == atom->firstgroup) nlocal = atom->nfirst;
+
+  double dtfrotate;
+  if (domain->dimension == 2) dtfrotate = dtf / 0.5;
+  else dtfrotate = dtf / INERTIA;
+
+  const double cg2 = CoeffCGMethod_*CoeffCGMethod_;
+
+  grow_scratch();
+  flag_near();
+
+  // update 1/2 step for v and omega with the slow forces
+  // full step for x of particles away from the walls
+
+  for (int i = 0; i < nlocal; i++) {
+    if (mask[i] & groupbit) {
+      dtfm = dtf / rmass[i];
+      v[i][0] += dtfm * f[i][0];
+      v[i][1] += dtfm * f[i][1];
+      v[i][2] += dtfm * f[i][2];
+
+      dtirotate = dtfrotate / (radius[i]*radius[i]*rmass[i]);
+      omega[i][0] += cg2 * dtirotate * torque[i][0];
+      omega[i][1] += cg2 * dtirotate * torque[i][1];
+      omega[i][2] += cg2 * dtirotate * torque[i][2];
+
+      if (!near_[i]) {
+        x[i][0] += dtv * v[i][0];
+        x[i][1] += dtv * v[i][1];
+        x[i][2] += dtv * v[i][2];
+      }
+    }
+  }
+
+  // substeps with the wall forces for particles near the walls
+
+  double **fast = fix_fast_->array_atom;
+  const double dtfsub = dtf / nsub_;
+  const double dtvsub = dtv / nsub_;
+  const double dtfrotsub = dtfrotate / nsub_;
+
+  for (int isub = 0; isub < nsub_; isub++) {
+
+    for (int ii = 0; ii < nnear_; ii++) {
+      const int i = nearlist_[ii];
+      if (mask[i] & groupbit) {
+        dtfm = dtfsub / rmass[i];
+        v[i][0] += dtfm * fast[i][0];
+        v[i][1] += dtfm * fast[i][1];
+        v[i][2] += dtfm * fast[i][2];
+
+        dtirotate = dtfrotsub / (radius[i]*radius[i]*rmass[i]);
+        omega[i][0] += cg2 * dtirotate * fast[i][3];
+        omega[i][1] += cg2 * dtirotate * fast[i][4];
+        omega[i][2] += cg2 * dtirotate * fast[i][5];
+
+        x[i][0] += dtvsub * v[i][0];
+        x[i][1] += dtvsub * v[i][1];
+        x[i][2] += dtvsub * v[i][2];
+      }
+    }
+
+    compute_fast(isub == nsub_-1);
+
+    for (int ii = 0; ii < nnear_; ii++) {
+      const int i = nearlist_[ii];
+      if (mask[i] & groupbit) {
+        dtfm = dtfsub / rmass[i];
+        v[i][0] += dtfm * fast[i][0];
+        v[i][1] += dtfm * fast[i][1];
+        v[i][2] += dtfm * fast[i][2];
+
+        dtirotate = dtfrotsub / (radius[i]*radius[i]*rmass[i]);
+        omega[i][0] += cg2 * dtirotate * fast[i][3];
+        omega[i][1] += cg2 * dtirotate * fast[i][4];
+        omega[i][2] += cg2 * dtirotate * fast[i][5];
+      }
+    }
+  }
+
+  clear_far();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::grow_scratch()
+{
+  if (atom->nmax <= nmax_) return;
+
+  nmax_ = atom->nmax;
+  memory->destroy(near_);
+  memory->destroy(nearlist_);
+  memory->destroy(ffast_);
+  memory->destroy(tfast_);
+  memory->create(near_,nmax_,"nve/sphere/subcycle:near");
+  memory->create(nearlist_,nmax_,"nve/sphere/subcycle:nearlist");
+  memory->create(ffast_,nmax_,3,"nve/sphere/subcycle:ffast");
+  memory->create(tfast_,nmax_,3,"nve/sphere/subcycle:tfast");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::flag_near()
+{
+  const int nlocal = atom->nlocal;
+
+  vectorZeroizeN(near_,nlocal);
+  for (int w = 0; w < nwall_; w++)
+    wall_[w]->flag_neighbors(near_);
+
+  nnear_ = 0;
+  for (int i = 0; i < nlocal; i++)
+    if (near_[i]) nearlist_[nnear_++] = i;
+}
+
+/* ----------------------------------------------------------------------
+   wall force and torque on the particles near the walls
+   the walls write to f and torque of atom, which point to scratch
+   arrays meanwhile, and see dt/nsub as the time-step for the
+   contact history
+------------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::compute_fast(bool capture)
+{
+  double **fast = fix_fast_->array_atom;
+
+  for (int ii = 0; ii < nnear_; ii++) {
+    const int i = nearlist_[ii];
+    vectorZeroize3D(ffast_[i]);
+    vectorZeroize3D(tfast_[i]);
+  }
+
+  double **f = atom->f;
+  double **torque = atom->torque;
+  const double dt = update->dt;
+
+  atom->f = ffast_;
+  atom->torque = tfast_;
+  update->dt = dt / nsub_;
+
+  for (int w = 0; w < nwall_; w++)
+    wall_[w]->post_force_subcycle(capture);
+
+  update->dt = dt;
+  atom->f = f;
+  atom->torque = torque;
+
+  for (int ii = 0; ii < nnear_; ii++) {
+    const int i = nearlist_[ii];
+    vectorCopy3D(ffast_[i],&fast[i][0]);
+    vectorCopy3D(tfast_[i],&fast[i][3]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   particles away from the walls carry no wall force into the next step
+------------------------------------------------------------------------- */
+
+void FixNVESphereSubcycle::clear_far()
+{
+  const int nlocal = atom->nlocal;
+  double **fast = fix_fast_->array_atom;
+
+  for (int i = 0; i < nlocal; i++)
+    if (!near_[i]) vectorZeroizeN(fast[i],6);
+}
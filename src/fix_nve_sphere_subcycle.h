@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(nve/sphere/subcycle,FixNVESphereSubcycle)
+
+#else
+
+#ifndef LMP_FIX_NVE_SPHERE_SUBCYCLE_H
+#define LMP_FIX_NVE_SPHERE_SUBCYCLE_H
+
+#include "fix_nve_sphere.h"
+
+namespace LAMMPS_NS {
+
+class FixNVESphereSubcycle : public FixNVESphere {
+ public:
+  FixNVESphereSubcycle(class LAMMPS *, int, char **);
+  ~FixNVESphereSubcycle();
+  void post_create();
+  void pre_delete(bool unfixflag);
+  void init();
+  void setup(int);
+  virtual void initial_integrate(int);
+
+  bool subcycles(class FixWallGran *) const;
+
+ protected:
+  int nsub_;
+
+  // walls whose contact forces are integrated with dt/nsub
+  int nwall_;
+  char **wall_id_;
+  class FixWallGran **wall_;
+
+  // wall force and torque of the last substep, migrates with the atoms
+  class FixPropertyAtom *fix_fast_;
+
+  // flag and list of particles in the neighbor list of a wall, scratch
+  // force and torque that the walls write to during a substep
+  int nmax_;
+  int *near_;
+  int nnear_;
+  int *nearlist_;
+  double **ffast_,**tfast_;
+
+  void grow_scratch();
+  void flag_near();
+  void compute_fast(bool capture);
+  void clear_far();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Fix nve/sphere/subcycle does not support run_style respa
+
+The substeps are done within a Verlet step.
+
+E: Fix nve/sphere/subcycle can only subcycle fixes of style wall/gran
+
+Self-explanatory.
+
+E: Fix nve/sphere/subcycle can only subcycle primitive walls that do not move
+
+Mesh walls and walls with the shear keyword are not supported.
+
+E: Fix nve/sphere/subcycle must be defined after the walls it subcycles
+
+The wall neighbor lists are set up in the setup of the walls, which
+must come first.
+
+E: Fix nve/sphere/subcycle does not support heat transfer of subcycled walls
+
+The heat flux would be added once per substep.
+
+E: Fix nve/sphere/subcycle requires the walls to act on its group
+
+Use group all for this fix or the same group for this fix and the walls.
+
+*/
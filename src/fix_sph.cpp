@@ -76,6 +76,8 @@ FixSph::FixSph(LAMMPS *lmp, int narg, char **arg) :
   fppaSlType = NULL;
   sl = NULL;
   slComType = NULL;
+
+  pairSph_ = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -98,16 +100,41 @@ int FixSph::setmask()
 
 /* ---------------------------------------------------------------------- */
 
+double FixSph::kernel(double s, double h, double hinv)
+{
+  if (pairSph_) return pairSph_->kernel(kernel_id,s,h,hinv);
+  return SPH_KERNEL_NS::sph_kernel(kernel_id,s,h,hinv);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixSph::kernel_der(double s, double h, double hinv)
+{
+  if (pairSph_) return pairSph_->kernel_der(kernel_id,s,h,hinv);
+  return SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,h,hinv);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixSph::init()
 {
   mass_type = atom->avec->mass_type;
   int ntypes = atom->ntypes;
   // need a half neighbor list, built when ever re-neighboring occurs
+  // with pair sph, request the same kind of list as the pair does, so the
+  // list is a copy of the pair list and the kernel cache of the pair applies
+
+  pairSph_ = dynamic_cast<PairSph*>(force->pair);
 
   int irequest = neighbor->request((void *) this);
   neighbor->requests[irequest]->pair = 0;
   neighbor->requests[irequest]->fix = 1;
+  if (!mass_type && pairSph_) {
+    neighbor->requests[irequest]->half = 0;
+    neighbor->requests[irequest]->gran = 1;
+  }
 
+  nlevels_respa = 0;
   if (strcmp(update->integrate_style,"respa") == 0)
     nlevels_respa = ((Respa *) update->integrate)->nlevels;
 
@@ -63,6 +63,11 @@ class FixSph : public Fix {
  protected:
   inline double interpDist(double disti, double distj) {return 0.5*(disti+distj);};
 
+  // kernel and derivative, evaluated by pair sph if present so that
+  // a tabulated kernel of the pair style is used by the fixes as well
+  double kernel(double s, double h, double hinv);
+  double kernel_der(double s, double h, double hinv);
+
   class FixPropertyAtom* fppaSl; //smoothing length
   class FixPropertyGlobal* fppaSlType; //per type smoothing length
   double *sl;         // per atom smoothing length
@@ -75,6 +80,9 @@ class FixSph : public Fix {
   class NeighList *list;
   int nlevels_respa;
 
+  // pair style holding the per-pair kernel cache, NULL if not pair sph
+  class PairSph *pairSph_;
+
   int mass_type; // flag defined in atom_vec*
 
 };
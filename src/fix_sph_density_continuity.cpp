@@ -241,7 +241,7 @@ void FixSphDensityContinuity::pre_force_eval(int vflag)
       delVDotDelR = rinv * ( delx*(v[i][0]-v[j][0]) + dely*(v[i][1]-v[j][1]) + delz*(v[i][2]-v[j][2]) );
 
       // calculate value for magnitude of grad W
-      gradWmag = SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,slCom,slComInv);
+      gradWmag = kernel_der(s,slCom,slComInv);
 
       // add contribution of neighbor
       // have a half neigh list, so do it for both if necessary
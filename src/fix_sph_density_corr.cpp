@@ -54,6 +54,7 @@
 #include "memory.h"
 #include "error.h"
 #include "sph_kernels.h"
+#include "pair_sph.h"
 #include "fix_property_atom.h"
 #include "timer.h"
 
@@ -222,15 +223,25 @@ void FixSphDensityCorr::pre_force_eval()
 
   updatePtrs(); // get sl, quantity
 
-  timer->stamp();
-  comm->forward_comm();
-  if (!MASSFLAG) fppaSl->do_forward_comm();
-  timer->stamp(TIME_COMM);
+  // ghost positions and rho are current at pre_force
+  // (regular communication or borders directly precede it)
 
   ago++;
   if (ago % every == 0) {
     ago = 0;
 
+    if (!MASSFLAG) {
+      timer->stamp();
+      fppaSl->do_forward_comm();
+      timer->stamp(TIME_COMM);
+    }
+
+    // both sweeps below use the same W, take it from the pair if possible
+
+    const bool cached = pairSph_ && pairSph_->kernel_cache_request(list,kernel_id);
+    const double * const kcR = cached ? pairSph_->kernel_cache_r() : NULL;
+    const double * const kcW = cached ? pairSph_->kernel_cache_W() : NULL;
+
     // kernel normalization
 
     for (i = 0; i < nlocal; i++)
@@ -249,7 +260,7 @@ void FixSphDensityCorr::pre_force_eval()
 
         // this gets a value for W at self, perform error check
 
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+        W = kernel(0.,sli,sliInv);
         if (W < 0.)
         {
           fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -291,34 +302,44 @@ void FixSphDensityCorr::pre_force_eval()
         if (MASSFLAG) {
           jtype = type[j];
           jmass = mass[jtype];
-          slCom = slComType[itype][jtype];
         } else {
           jmass = rmass[j];
-          slj = sl[j];
-          slCom = interpDist(sli,slj);
         }
 
-        cut = slCom*kernel_cut;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-
-        if (rsq >= cut*cut) continue;
-
-        // calculate distance
-        r = sqrt(rsq);
-        slComInv = 1./slCom;
-        s = r*slComInv;
-
-        // this gets a value for W at self, perform error check
-
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
-        if (W < 0.)
-        {
-          fprintf(screen,"s = %f, W = %f\n",s,W);
-          error->one(FLERR,"Illegal kernel used, W < 0");
+        if (cached) {
+          const int kp = pairSph_->kernel_cache_offset(ii) + jj;
+          if (kcR[kp] < 0.) continue;
+          W = kcW[kp];
+        } else {
+          if (MASSFLAG) {
+            slCom = slComType[itype][jtype];
+          } else {
+            slj = sl[j];
+            slCom = interpDist(sli,slj);
+          }
+
+          cut = slCom*kernel_cut;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+
+          if (rsq >= cut*cut) continue;
+
+          // calculate distance
+          r = sqrt(rsq);
+          slComInv = 1./slCom;
+          s = r*slComInv;
+
+          // this gets a value for W at self, perform error check
+
+          W = kernel(s,slCom,slComInv);
+          if (W < 0.)
+          {
+            fprintf(screen,"s = %f, W = %f\n",s,W);
+            error->one(FLERR,"Illegal kernel used, W < 0");
+          }
         }
 
         // add contribution of neighbor
@@ -346,7 +367,7 @@ void FixSphDensityCorr::pre_force_eval()
 
         // this gets a value for W at self, perform error check
 
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+        W = kernel(0.,sli,sliInv);
         if (W < 0.)
         {
           fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -358,12 +379,9 @@ void FixSphDensityCorr::pre_force_eval()
       }
     }
 
-    // need updated ghost positions and self contributions
-    timer->stamp();
-    comm->forward_comm();
-    timer->stamp(TIME_COMM);
-
     // loop over neighbors of my atoms
+    // ghost rho is only accumulated into here and overwritten below,
+    // so no communication of the self contributions is needed
     inum = list->inum;
     ilist = list->ilist;
     numneigh = list->numneigh;
@@ -393,34 +411,44 @@ void FixSphDensityCorr::pre_force_eval()
         if (MASSFLAG) {
           jtype = type[j];
           jmass = mass[jtype];
-          slCom = slComType[itype][jtype];
         } else {
           jmass = rmass[j];
-          slj = sl[j];
-          slCom = interpDist(sli,slj);
         }
 
-        cut = slCom*kernel_cut;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-
-        if (rsq >= cut*cut) continue;
-
-        // calculate distance
-        r = sqrt(rsq);
-        slComInv = 1./slCom;
-        s = r*slComInv;
-
-        // this gets a value for W at self, perform error check
-
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
-        if (W < 0.)
-        {
-          fprintf(screen,"s = %f, W = %f\n",s,W);
-          error->one(FLERR,"Illegal kernel used, W < 0");
+        if (cached) {
+          const int kp = pairSph_->kernel_cache_offset(ii) + jj;
+          if (kcR[kp] < 0.) continue;
+          W = kcW[kp];
+        } else {
+          if (MASSFLAG) {
+            slCom = slComType[itype][jtype];
+          } else {
+            slj = sl[j];
+            slCom = interpDist(sli,slj);
+          }
+
+          cut = slCom*kernel_cut;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+
+          if (rsq >= cut*cut) continue;
+
+          // calculate distance
+          r = sqrt(rsq);
+          slComInv = 1./slCom;
+          s = r*slComInv;
+
+          // this gets a value for W at self, perform error check
+
+          W = kernel(s,slCom,slComInv);
+          if (W < 0.)
+          {
+            fprintf(screen,"s = %f, W = %f\n",s,W);
+            error->one(FLERR,"Illegal kernel used, W < 0");
+          }
         }
 
         // add contribution of neighbor
@@ -56,6 +56,7 @@
 #include "memory.h"
 #include "error.h"
 #include "sph_kernels.h"
+#include "pair_sph.h"
 #include "fix_property_atom.h"
 #include "timer.h"
 
@@ -190,7 +191,7 @@ void FixSPHDensitySum::post_integrate_eval()
 
     // this gets a value for W at self, perform error check
 
-    W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+    W = kernel(0.,sli,sliInv);
     if (W < 0.)
     {
       fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -207,6 +208,13 @@ void FixSPHDensitySum::post_integrate_eval()
 
   timer->stamp(TIME_COMM);
 
+  // use pair-aligned kernel values if the list is shared with pair sph
+  // first sph stage of the step fills the cache, later ones reuse it
+
+  const bool cached = pairSph_ && pairSph_->kernel_cache_request(list,kernel_id);
+  const double * const kcR = cached ? pairSph_->kernel_cache_r() : NULL;
+  const double * const kcW = cached ? pairSph_->kernel_cache_W() : NULL;
+
   // loop over neighbors of my atoms
 
   inum = list->inum;
@@ -240,9 +248,25 @@ void FixSPHDensitySum::post_integrate_eval()
       if (MASSFLAG) {
         jtype = type[j];
         jmass = mass[jtype];
-        slCom = slComType[itype][jtype];
       } else {
         jmass = rmass[j];
+      }
+
+      if (cached) {
+        const int kp = pairSph_->kernel_cache_offset(ii) + jj;
+        if (kcR[kp] < 0.) continue;
+        W = kcW[kp];
+
+        rho[i] += W * jmass;
+
+        if (newton_pair || j < nlocal)
+          rho[j] += W * imass;
+        continue;
+      }
+
+      if (MASSFLAG) {
+        slCom = slComType[itype][jtype];
+      } else {
         slj = sl[j];
         slCom = interpDist(sli,slj);
       }
@@ -264,7 +288,7 @@ void FixSPHDensitySum::post_integrate_eval()
 
       // this gets a value for W at self, perform error check
 
-      W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
+      W = kernel(s,slCom,slComInv);
       if (W < 0.)
       {
         fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -282,8 +306,13 @@ void FixSPHDensitySum::post_integrate_eval()
   }
 
   // rho is now correct, send to ghosts
-  timer->stamp();
-  comm->forward_comm();
-  timer->stamp(TIME_COMM);
+  // with verlet, this is done by the regular communication
+  // (or exchange + borders) directly following post_integrate
+
+  if (nlevels_respa > 0) {
+    timer->stamp();
+    comm->forward_comm();
+    timer->stamp(TIME_COMM);
+  }
 
 }
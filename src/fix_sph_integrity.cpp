@@ -238,7 +238,7 @@ void FixSphIntegrity::post_integrate_eval()
 
     // this gets a value for W at self, perform error check
 
-    W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+    W = kernel(0.,sli,sliInv);
     if (W < 0.)
     {
       fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -313,7 +313,7 @@ void FixSphIntegrity::post_integrate_eval()
 
       // this gets a value for W at self, perform error check
 
-      W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
+      W = kernel(s,slCom,slComInv);
       if (W < 0.)
       {
         fprintf(screen,"s = %f, W = %f\n",s,W);
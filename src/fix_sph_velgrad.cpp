@@ -56,6 +56,7 @@
 #include "memory.h"
 #include "error.h"
 #include "sph_kernels.h"
+#include "pair_sph.h"
 #include "fix_property_atom.h"
 #include "timer.h"
 
@@ -268,10 +269,12 @@ void FixSphVelgrad::pre_force_eval(int vflag)
       dvdz_[i][2] = 0;
     }
 
-    // need updated ghost positions and self contributions
-    timer->stamp();
-    comm->forward_comm();
-    timer->stamp(TIME_COMM);
+    // ghost positions, vest and rho are current at pre_force
+    // (regular communication or borders directly precede it)
+
+    const bool cached = pairSph_ && pairSph_->kernel_cache_request(list,kernel_id);
+    const double * const kcR = cached ? pairSph_->kernel_cache_r() : NULL;
+    const double * const kcDW = cached ? pairSph_->kernel_cache_dW() : NULL;
 
     // loop over neighbors of my atoms
 
@@ -307,31 +310,42 @@ void FixSphVelgrad::pre_force_eval(int vflag)
         if (MASSFLAG) {
           jtype = type[j];
           jmass = mass[jtype];
-          slCom = slComType[itype][jtype];
         } else {
           jmass = rmass[j];
-          slj = sl[j];
-          slCom = interpDist(sli,slj);
         }
 
         jrho = rho[j];
-        slComInv = 1./slCom;
-        cut = slCom*kernel_cut;
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
         delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
 
-        if (rsq >= cut*cut) continue;
-        // calculate distance and normalized distance
+        if (cached) {
+          const int kp = pairSph_->kernel_cache_offset(ii) + jj;
+          r = kcR[kp];
+          if (r < 0.) continue;
+          gradWmag = kcDW[kp];
+        } else {
+          if (MASSFLAG) {
+            slCom = slComType[itype][jtype];
+          } else {
+            slj = sl[j];
+            slCom = interpDist(sli,slj);
+          }
+
+          cut = slCom*kernel_cut;
+          rsq = delx*delx + dely*dely + delz*delz;
 
-        r = sqrt(rsq);
-        slComInv = 1./slCom;
-        s = r*slComInv;
+          if (rsq >= cut*cut) continue;
+          // calculate distance and normalized distance
 
-        // calculate value for magnitude of grad W
-        gradWmag = SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,slCom,slComInv);
+          r = sqrt(rsq);
+          slComInv = 1./slCom;
+          s = r*slComInv;
+
+          // calculate value for magnitude of grad W
+          gradWmag = kernel_der(s,slCom,slComInv);
+        }
 
         m_rhoGradWmag_r = jmass / jrho * gradWmag / r;
 
@@ -371,10 +385,5 @@ void FixSphVelgrad::pre_force_eval(int vflag)
         dvdz_[j][2] += m_rhoGradWmag_r * delvz * delz;
       }
     }
-
-    // dvdx, dvdy, dvdz are now correct, send to ghosts
-    timer->stamp();
-    comm->forward_comm();
-    timer->stamp(TIME_COMM);
   }
 }
@@ -75,6 +75,7 @@
 #include "contact_interface.h"
 #include "fix_property_global.h"
 #include "domain_wedge.h"
+#include "fix_nve_sphere_subcycle.h"
 #include <vector>
 
 #ifdef SUPERQUADRIC_ACTIVE_FLAG
@@ -142,6 +143,8 @@ FixWallGran::FixWallGran(LAMMPS *lmp, int narg, char **arg) :
     addflag_ = 0;
     cwl_ = NULL;
 
+    subcycled_ = false;
+
     computeflag_ = 1;
 
     meshwall_ = -1;
@@ -641,6 +644,17 @@ void FixWallGran::init()
         (
             modify->find_fix_property("sum_normal_force_","property/atom","scalar",0,0,style, false)
         );
+
+    // leave the contact forces to an integrator that subcycles this wall
+
+    subcycled_ = false;
+    const int nsubcycle = modify->n_fixes_style("nve/sphere/subcycle");
+    for (int ifix = 0; ifix < nsubcycle; ifix++)
+    {
+        FixNVESphereSubcycle *fsub = static_cast<FixNVESphereSubcycle*>(modify->find_fix_style("nve/sphere/subcycle",ifix));
+        if (fsub->subcycles(this))
+            subcycled_ = true;
+    }
 }
 
 void FixWallGran::createMulticontactData()
@@ -735,13 +749,64 @@ void FixWallGran::pre_force(int vflag)
 
 void FixWallGran::post_force(int vflag)
 {
+    if(subcycled_)
+        return;
+
     computeflag_ = 1;
     shearupdate_ = 1;
     if (update->setupflag) shearupdate_ = 0;
     addflag_ = 0;
 
+    // if compute wall/gran/local is invoked on this step,
+    // store the contacts now instead of re-computing them at output
+
+    if(cwl_ && cwl_->capture_step())
+    {
+        cwl_->begin_capture();
+        addflag_ = 1;
+    }
+
     post_force_wall(vflag);
 
+    if(addflag_)
+        cwl_->pair_finalize();
+}
+
+/* ----------------------------------------------------------------------
+   force on each atom for one substep of fix nve/sphere/subcycle
+   capture the contacts for compute wall/gran/local on the last substep
+------------------------------------------------------------------------- */
+
+void FixWallGran::post_force_subcycle(bool capture)
+{
+    computeflag_ = 1;
+    shearupdate_ = 1;
+    if (update->setupflag) shearupdate_ = 0;
+    addflag_ = 0;
+
+    if(capture && cwl_ && cwl_->capture_step())
+    {
+        cwl_->begin_capture();
+        addflag_ = 1;
+    }
+
+    post_force_wall(0);
+
+    if(addflag_)
+        cwl_->pair_finalize();
+}
+
+/* ----------------------------------------------------------------------
+   flag the local particles in the neighbor list of a primitive wall
+------------------------------------------------------------------------- */
+
+void FixWallGran::flag_neighbors(int *flag)
+{
+    int *neighborList;
+    const int nNeigh = primitiveWall_->getNeighbors(neighborList);
+
+    for (int iCont = 0; iCont < nNeigh; iCont++)
+        flag[neighborList[iCont]] = 1;
 }
 
 /* ----------------------------------------------------------------------
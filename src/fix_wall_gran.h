@@ -124,6 +124,13 @@ class FixWallGran : public Fix, public LIGGGHTS::IContactHistorySetup {
   inline bool is_mesh_wall() const
   { return 1 == meshwall_; }
 
+  // contact forces are computed by fix nve/sphere/subcycle instead of post_force
+  inline bool subcycled() const
+  { return subcycled_; }
+
+  void post_force_subcycle(bool capture);
+  void flag_neighbors(int *flag);
+
   inline int computeflag() const
   { return computeflag_; }
 
@@ -220,6 +227,8 @@ class FixWallGran : public Fix, public LIGGGHTS::IContactHistorySetup {
   int addflag_;
   ComputePairGranLocal *cwl_;
 
+  bool subcycled_;
+
   double dt_;
   int shearupdate_;
 
@@ -156,8 +156,8 @@ public:
     double *omega = atom->omega[ip];
     double mass = atom->rmass[ip];
 //
-    double *Lwx = atom->Lwx[ip];
-    double *Lwx2 = atom->Lwx2[ip];
+    double *Lwx = atom->Lwx ? atom->Lwx[ip] : NULL;
+    double *Lwx2 = atom->Lwx2 ? atom->Lwx2[ip] : NULL;
 //
     int *type = atom->type;
 
@@ -199,10 +199,12 @@ public:
     sidata.meff = mass;
     sidata.mi = mass;
 //
-    sidata.rhof = Lwx[0];
-    sidata.nuf = Lwx[1];
-
-    sidata.alphas = Lwx2[0];
+    if (Lwx) {
+      sidata.rhof = Lwx[0];
+      sidata.nuf = Lwx[1];
+      sidata.alphas = Lwx2[0];
+    } else
+      sidata.rhof = sidata.nuf = sidata.alphas = 0.0;
 //
 
     sidata.computeflag = wg->computeflag();
@@ -293,7 +295,7 @@ public:
        // if there is a surface touch, there will always be a force
        sidata.has_force_update = true;
 //
-       Lwx[2] = 1;
+       if (Lwx) Lwx[2] = 1;
 //
     }
     // surfacesClose is not supported for convex particles
@@ -62,6 +62,9 @@
 #include "modify.h"
 #include "compute.h"
 #include "fix.h"
+#include "fix_mesh.h"
+#include "custom_value_tracker.h"
+#include "container.h"
 #include "comm.h"
 #include "memory.h"
 #include "error.h"
@@ -186,6 +189,8 @@ void *lammps_extract_global(void *ptr, const char *name)
   if (strcmp(name,"mylocx") == 0) return (void *) &lmp->comm->myloc[0];
   if (strcmp(name,"mylocy") == 0) return (void *) &lmp->comm->myloc[1];
   if (strcmp(name,"mylocz") == 0) return (void *) &lmp->comm->myloc[2];
+  if (strcmp(name,"me") == 0) return (void *) &lmp->comm->me;
+  if (strcmp(name,"nprocs") == 0) return (void *) &lmp->comm->nprocs;
   if (strcmp(name,"natoms") == 0) return (void *) &lmp->atom->natoms;
   if (strcmp(name,"nlocal") == 0) return (void *) &lmp->atom->nlocal;
   if (strcmp(name,"nghost") == 0) return (void *) &lmp->atom->nghost;
@@ -587,3 +592,268 @@ void lammps_scatter_atoms(void *ptr, const char *name,
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   return the number of atoms owned by this processor
+   per-atom data returned by the lammps_extract_*_local() functions
+     has one row for each of these atoms
+------------------------------------------------------------------------- */
+
+int lammps_get_nlocal(void *ptr)
+{
+  LAMMPS *lmp = (LAMMPS *) ptr;
+  return lmp->atom->nlocal;
+}
+
+/* ----------------------------------------------------------------------
+   extract a pointer to the storage of a per-atom property of owned atoms
+   name = desired quantity, e.g. x or radius, see Atom::extract()
+   type = returned as 0 for integer values, 1 for double values
+   nrow,ncol = returned shape of the data, nrow = # of owned atoms
+   returns a pointer to the first value, values of one atom are
+     contiguous and consecutive atoms are ncol values apart
+     e.g. x[0][0],x[0][1],x[0][2],x[1][0],...
+   no data is copied, the pointer is valid until atoms are
+     re-allocated or migrate, i.e. until the next run or re-neighboring
+   returns a NULL if the property does not exist or nrow = 0
+------------------------------------------------------------------------- */
+
+void *lammps_extract_atom_local(void *ptr, const char *name,
+                                int *type, int *nrow, int *ncol)
+{
+  LAMMPS *lmp = (LAMMPS *) ptr;
+
+  *type = 1;
+  *nrow = 0;
+  *ncol = 0;
+
+  int len;
+  void *vptr = lmp->atom->extract(name,len);
+  if (!vptr || len < 1) return NULL;
+
+  if (strcmp(name,"id") == 0 || strcmp(name,"type") == 0 ||
+      strcmp(name,"mask") == 0 || strcmp(name,"image") == 0 ||
+      strcmp(name,"molecule") == 0)
+    *type = 0;
+
+  *nrow = lmp->atom->nlocal;
+  *ncol = len;
+  if (*nrow == 0) return NULL;
+
+  // per-atom arrays are allocated contiguously by Memory::create()
+
+  if (len == 1) return vptr;
+  if (*type == 0) return (void *) &((int **) vptr)[0][0];
+  return (void *) &((double **) vptr)[0][0];
+}
+
+/* ----------------------------------------------------------------------
+   extract a pointer to the per-atom data of a fix for owned atoms
+   id = fix ID, e.g. of a fix property/atom
+   type, nrow, ncol and the returned pointer as in lammps_extract_atom_local
+   values are returned as they are stored by the fix, the fix is not invoked
+   returns a NULL if id is not recognized or the fix has no per-atom data
+------------------------------------------------------------------------- */
+
+void *lammps_extract_fix_local(void *ptr, const char *id,
+                               int *type, int *nrow, int *ncol)
+{
+  LAMMPS *lmp = (LAMMPS *) ptr;
+
+  *type = 1;
+  *nrow = 0;
+  *ncol = 0;
+
+  int ifix = lmp->modify->find_fix(id);
+  if (ifix < 0) return NULL;
+  Fix *fix = lmp->modify->fix[ifix];
+  if (!fix->peratom_flag) return NULL;
+
+  *nrow = lmp->atom->nlocal;
+  if (fix->size_peratom_cols == 0) {
+    *ncol = 1;
+    if (*nrow == 0 || !fix->vector_atom) return NULL;
+    return (void *) fix->vector_atom;
+  }
+
+  *ncol = fix->size_peratom_cols;
+  if (*nrow == 0 || !fix->array_atom) return NULL;
+  return (void *) &fix->array_atom[0][0];
+}
+
+/* ----------------------------------------------------------------------
+   extract a pointer to per-element data of the owned elements of a mesh
+   id = ID of a fix mesh
+   name = node for the node positions of each element, otherwise the
+     name of an element property of the mesh, e.g. v for a moving mesh
+   type, nrow, ncol and the returned pointer as in lammps_extract_atom_local
+     with nrow = # of owned elements of the mesh
+     e.g. for node of a tri mesh ncol = 9 and the values of one element
+     are node0x,node0y,node0z,node1x,...
+   returns a NULL if id or name is not recognized
+------------------------------------------------------------------------- */
+
+void *lammps_extract_mesh_local(void *ptr, const char *id, const char *name,
+                                int *type, int *nrow, int *ncol)
+{
+  LAMMPS *lmp = (LAMMPS *) ptr;
+
+  *type = 1;
+  *nrow = 0;
+  *ncol = 0;
+
+  int ifix = lmp->modify->find_fix(id);
+  if (ifix < 0) return NULL;
+  FixMesh *fix = dynamic_cast<FixMesh*>(lmp->modify->fix[ifix]);
+  if (!fix) return NULL;
+  AbstractMesh *mesh = fix->mesh();
+
+  int nlocal = mesh->sizeLocal();
+
+  if (strcmp(name,"node") == 0) {
+    *nrow = nlocal;
+    *ncol = 3*mesh->numNodes();
+    if (nlocal == 0) return NULL;
+    return (void *) mesh->nodeData();
+  }
+
+  // element properties are stored by containers allocated via Memory
+
+  CustomValueTracker &prop = mesh->prop();
+  ScalarContainer<double> *sd;
+  ScalarContainer<int> *si;
+  VectorContainer<double,3> *vd;
+  MultiVectorContainer<double,3,3> *md;
+  void *vptr = NULL;
+
+  if ((sd = prop.getElementProperty<ScalarContainer<double> >(name))) {
+    *ncol = 1;
+    if (nlocal) vptr = (void *) sd->begin();
+  } else if ((si = prop.getElementProperty<ScalarContainer<int> >(name))) {
+    *type = 0;
+    *ncol = 1;
+    if (nlocal) vptr = (void *) si->begin();
+  } else if ((vd = prop.getElementProperty<VectorContainer<double,3> >(name))) {
+    *ncol = 3;
+    if (nlocal) vptr = (void *) &vd->begin()[0][0];
+  } else if ((md = prop.getElementProperty<MultiVectorContainer<double,3,3> >(name))) {
+    *ncol = 9;
+    if (nlocal) vptr = (void *) &md->begin()[0][0][0];
+  } else return NULL;
+
+  *nrow = nlocal;
+  return vptr;
+}
+
+/* ----------------------------------------------------------------------
+   gather the named atom-based entity to processor 0, ordered by atom ID
+   name, type, count and layout of data as in lammps_gather_atoms()
+   data must be pre-allocated to count*natoms values on processor 0,
+     it is ignored on all other processors
+   in contrast to lammps_gather_atoms(), only processor 0 stores the
+     full data set, each other processor sends its owned values to
+     processor 0 only, point-to-point as done by Dump::write()
+------------------------------------------------------------------------- */
+
+void lammps_gather_atoms_root(void *ptr, const char *name,
+                              int type, int count, void *data)
+{
+  LAMMPS *lmp = (LAMMPS *) ptr;
+
+  // error if tags are not defined or not consecutive
+
+  int flag = 0;
+  if (lmp->atom->tag_enable == 0 || lmp->atom->tag_consecutive() == 0) flag = 1;
+  if (lmp->atom->natoms > MAXSMALLINT) flag = 1;
+  if (flag) {
+    if (lmp->comm->me == 0)
+      lmp->error->warning(FLERR,"Library error in lammps_gather_atoms_root");
+    return;
+  }
+
+  // all procs must agree on the checks before entering the gather,
+  // a proc without atoms may not have allocated the property yet,
+  // data is only used on proc 0
+
+  int i,j,m,offset,len;
+  void *vptr = lmp->atom->extract(name,len);
+  if (len < 1) flag = 1;
+  else if (vptr == NULL && lmp->atom->nlocal > 0) flag = 1;
+  else if (lmp->comm->me == 0 && data == NULL) flag = 2;
+
+  int flag_all;
+  MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_MAX,lmp->world);
+  if (flag_all) {
+    if (lmp->comm->me == 0) {
+      if (flag_all == 1)
+        lmp->error->warning(FLERR,"lammps_gather_atoms_root: "
+                            "unknown property name");
+      else
+        lmp->error->warning(FLERR,"lammps_gather_atoms_root: "
+                            "NULL data buffer");
+    }
+    return;
+  }
+
+  int *tag = lmp->atom->tag;
+  int nlocal = lmp->atom->nlocal;
+  int me = lmp->comm->me;
+  int nprocs = lmp->comm->nprocs;
+  int size_one = count+1;
+
+  int nmax;
+  MPI_Allreduce(&nlocal,&nmax,1,MPI_INT,MPI_MAX,lmp->world);
+
+  // buf = atom ID followed by count values for each owned atom
+  // integer values are exact in doubles
+
+  double *buf;
+  lmp->memory->create(buf,MAX(nmax,1)*size_one,"lib/gather:buf");
+
+  m = 0;
+  for (i = 0; i < nlocal; i++) {
+    buf[m++] = tag[i];
+    if (type == 0) {
+      if (count == 1) buf[m++] = ((int *) vptr)[i];
+      else for (j = 0; j < count; j++) buf[m++] = ((int **) vptr)[i][j];
+    } else {
+      if (count == 1) buf[m++] = ((double *) vptr)[i];
+      else for (j = 0; j < count; j++) buf[m++] = ((double **) vptr)[i][j];
+    }
+  }
+
+  // proc 0 pings each proc, receives its data and inserts it by atom ID
+  // other procs wait for ping from proc 0, then send their data
+
+  int tmp,n;
+  MPI_Status status;
+  MPI_Request request;
+
+  if (me == 0) {
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      if (iproc) {
+        MPI_Irecv(buf,nmax*size_one,MPI_DOUBLE,iproc,0,lmp->world,&request);
+        MPI_Send(&tmp,0,MPI_INT,iproc,0,lmp->world);
+        MPI_Wait(&request,&status);
+        MPI_Get_count(&status,MPI_DOUBLE,&n);
+        n /= size_one;
+      } else n = nlocal;
+
+      m = 0;
+      for (i = 0; i < n; i++) {
+        offset = count*(static_cast<int> (buf[m++]) - 1);
+        if (type == 0)
+          for (j = 0; j < count; j++)
+            ((int *) data)[offset++] = static_cast<int> (buf[m++]);
+        else
+          for (j = 0; j < count; j++)
+            ((double *) data)[offset++] = buf[m++];
+      }
+    }
+  } else {
+    MPI_Recv(&tmp,0,MPI_INT,0,0,lmp->world,&status);
+    MPI_Rsend(buf,nlocal*size_one,MPI_DOUBLE,0,0,lmp->world);
+  }
+
+  lmp->memory->destroy(buf);
+}
@@ -73,6 +73,13 @@ int lammps_get_natoms(void *);
 void lammps_gather_atoms(void *, const char *, int, int, void *);
 void lammps_scatter_atoms(void *, const char *, int, int, void *);
 
+int lammps_get_nlocal(void *);
+void *lammps_extract_atom_local(void *, const char *, int *, int *, int *);
+void *lammps_extract_fix_local(void *, const char *, int *, int *, int *);
+void *lammps_extract_mesh_local(void *, const char *, const char *,
+                                int *, int *, int *);
+void lammps_gather_atoms_root(void *, const char *, int, int, void *);
+
 #ifdef __cplusplus
 }
 #endif
@@ -90,4 +97,19 @@ This library function cannot be used if atom IDs are not defined or
 are not consecutively numbered, or if no atom map is defined.  See the
 atom_modify command for details about atom maps.
 
+W: Library error in lammps_gather_atoms_root
+
+This library function cannot be used if atom IDs are not defined
+or are not consecutively numbered.
+
+W: lammps_gather_atoms_root: unknown property name
+
+The requested per-atom property does not exist for the current
+atom style.  No data is gathered.
+
+W: lammps_gather_atoms_root: NULL data buffer
+
+Processor 0 must pass a buffer for count*natoms values.  No data is
+gathered.
+
 */
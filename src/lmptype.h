@@ -195,6 +195,16 @@ typedef int bigint;
 
 #endif
 
+// storage type of granular pair contact history
+// single precision halves the history memory of neighbor list and fix
+// contacthistory, contact models still compute in double precision
+
+#ifdef LIGGGHTS_FLOAT_HISTORY
+typedef float histtype;
+#else
+typedef double histtype;
+#endif
+
 }
 
 // settings to enable LAMMPS to build under Windows
@@ -713,47 +713,48 @@ double calc_F_new(Superquadric *particle1, Superquadric *particle2, double *x1,
   return sqrt(F[0]*F[0] + F[1]*F[1] + F[2]*F[2] + F[3]*F[3] + F[4]*F[4]);
 }
 
-double invf(int i,int j,const double* m){
-
-    int o = 2+(j-i);
-
-    i += 4+o;
-    j += 4-o;
-
-    #define e(a,b) m[ ((j+b)%4)*4 + ((i+a)%4) ]
-
-    double inv =
-     + e(+1,-1)*e(+0,+0)*e(-1,+1)
-     + e(+1,+1)*e(+0,-1)*e(-1,+0)
-     + e(-1,-1)*e(+1,+0)*e(+0,+1)
-     - e(-1,-1)*e(+0,+0)*e(+1,+1)
-     - e(-1,+1)*e(+0,-1)*e(+1,+0)
-     - e(+1,-1)*e(-1,+0)*e(+0,+1);
-
-    return (o%2)?inv : -inv;
-
-    #undef e
-}
-
+//closed form inverse by cofactors, returns the determinant
 double inverseMatrix4x4(const double *m, double *out)
 {
+    const double s0 = m[0]*m[5] - m[4]*m[1];
+    const double s1 = m[0]*m[6] - m[4]*m[2];
+    const double s2 = m[0]*m[7] - m[4]*m[3];
+    const double s3 = m[1]*m[6] - m[5]*m[2];
+    const double s4 = m[1]*m[7] - m[5]*m[3];
+    const double s5 = m[2]*m[7] - m[6]*m[3];
+
+    const double c5 = m[10]*m[15] - m[14]*m[11];
+    const double c4 = m[9]*m[15] - m[13]*m[11];
+    const double c3 = m[9]*m[14] - m[13]*m[10];
+    const double c2 = m[8]*m[15] - m[12]*m[11];
+    const double c1 = m[8]*m[14] - m[12]*m[10];
+    const double c0 = m[8]*m[13] - m[12]*m[9];
+
+    const double D = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
 
-    double inv[16];
-
-    for(int i = 0;i < 4; i++)
-        for(int j = 0; j < 4; j++)
-            inv[j*4+i] = invf(i,j,m);
+    if (D == 0) return D;
 
-    double D = 0;
+    const double D_inv = 1.0 / D;
 
-    for(int k = 0; k < 4; k++) D += m[k] * inv[k*4];
+    out[0]  = ( m[5]*c5 - m[6]*c4 + m[7]*c3) * D_inv;
+    out[1]  = (-m[1]*c5 + m[2]*c4 - m[3]*c3) * D_inv;
+    out[2]  = ( m[13]*s5 - m[14]*s4 + m[15]*s3) * D_inv;
+    out[3]  = (-m[9]*s5 + m[10]*s4 - m[11]*s3) * D_inv;
 
-    if (D == 0) return D;
+    out[4]  = (-m[4]*c5 + m[6]*c2 - m[7]*c1) * D_inv;
+    out[5]  = ( m[0]*c5 - m[2]*c2 + m[3]*c1) * D_inv;
+    out[6]  = (-m[12]*s5 + m[14]*s2 - m[15]*s1) * D_inv;
+    out[7]  = ( m[8]*s5 - m[10]*s2 + m[11]*s1) * D_inv;
 
-    double D_inv = 1.0 / D;
+    out[8]  = ( m[4]*c4 - m[5]*c2 + m[7]*c0) * D_inv;
+    out[9]  = (-m[0]*c4 + m[1]*c2 - m[3]*c0) * D_inv;
+    out[10] = ( m[12]*s4 - m[13]*s2 + m[15]*s0) * D_inv;
+    out[11] = (-m[8]*s4 + m[9]*s2 - m[11]*s0) * D_inv;
 
-    for (int i = 0; i < 16; i++)
-        out[i] = inv[i] * D_inv;
+    out[12] = (-m[4]*c3 + m[5]*c1 - m[6]*c0) * D_inv;
+    out[13] = ( m[0]*c3 - m[1]*c1 + m[2]*c0) * D_inv;
+    out[14] = (-m[12]*s3 + m[13]*s1 - m[14]*s0) * D_inv;
+    out[15] = ( m[8]*s3 - m[9]*s1 + m[10]*s0) * D_inv;
 
     return D;
 }
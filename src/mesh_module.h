@@ -70,6 +70,7 @@ namespace LAMMPS_NS
         virtual void final_integrate_pre_comm() {}
         virtual void final_integrate() {}
         virtual void end_of_step() {}
+        virtual void reset_dt() {}
         virtual double compute_vector(int n) { return 0.0; }
         virtual void add_particle_contribution(int ip, double *frc, double *delta, int iTri, double *v_wall) {}
         virtual int modify_param(int narg, char **arg) { return 0; }
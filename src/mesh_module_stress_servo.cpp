@@ -111,6 +111,8 @@ MeshModuleStressServo::MeshModuleStressServo(LAMMPS *lmp, int &iarg_, int narg,
     int_flag_( true),
     mode_flag_(false),
     ctrl_style_(NONE),
+    dtf_(0.),
+    dtv_(0.),
     mod_andrew_(new ModifiedAndrew(lmp))
 {
     mm_stress = static_cast<MeshModuleStress*>(fix_mesh->get_module("stress"));
@@ -362,11 +364,6 @@ void MeshModuleStressServo::init()
             break;
     }
 
-    // check maximal velocity
-    const double skin = neighbor->skin;
-    if(vel_max_ >= skin/(2.*dtv_))
-        error->one(FLERR,"vel_max < skin/(2.*dt) required");
-
     // compute global number of contacts
     fix_mesh->meshNeighlist()->enableTotalNumContacts(true);
 }
@@ -601,8 +598,23 @@ void MeshModuleStressServo::set_v_node_rotate()
 
 void MeshModuleStressServo::reset_dt()
 {
+    // minimum velocity is a fraction of the smallest radius per step,
+    // rescale it if the time step changes during a run (fix dt/adapt/gran)
+
+    if(dtv_ > 0.)
+    {
+        const double ratio = dtv_/update->dt;
+        vel_min_ *= ratio;
+        ctrl_op_min_ *= ratio;
+    }
+
     dtv_ = update->dt;
     dtf_ = 0.5 * update->dt * force->ftm2v;
+
+    // check maximal velocity
+    const double skin = neighbor->skin;
+    if(vel_max_ >= skin/(2.*dtv_))
+        error->one(FLERR,"vel_max < skin/(2.*dt) required");
 }
 
 /* ----------------------------------------------------------------------
@@ -49,6 +49,7 @@
 #include "update.h"
 #include "min.h"
 #include "finish.h"
+#include "output.h"
 #include "timer.h"
 #include "error.h"
 #include "force.h"
@@ -88,6 +89,7 @@ void Minimize::command(int narg, char **arg)
   timer->init();
   timer->barrier_start(TIME_LOOP);
   update->minimize->run(update->nsteps);
+  output->wait_restart();
   timer->barrier_stop(TIME_LOOP);
 
   update->minimize->cleanup();
@@ -61,8 +61,12 @@ Multisphere::Multisphere(LAMMPS *lmp) :
 
   nbody_(0),
   nbody_all_(0),
-  mapTagMax_(0), 
-  mapArray_(0),
+  mapTagMax_(0),
+  mapSize_(0),
+  mapShift_(0),
+  mapUsed_(0),
+  mapKey_(0),
+  mapValue_(0),
 
   id_ (*customValues_.addElementProperty< ScalarContainer<int> >("id_multisphere","comm_exchange_borders"/*ID does never change*/,"frame_invariant","restart_yes")),
 
@@ -111,7 +115,7 @@ Multisphere::~Multisphere()
     delete &customValues_;
 
     // deallocate map memory if exists
-    if(mapArray_) clear_map();
+    clear_map();
 }
 
 /* ----------------------------------------------------------------------
@@ -399,37 +403,145 @@ void Multisphere::id_extend_body_extend(int *body)
 void Multisphere::clear_map()
 {
     // deallocate old memory
-    memory->destroy(mapArray_);
-    mapArray_ = NULL;
+    memory->destroy(mapKey_);
+    memory->destroy(mapValue_);
+    mapKey_ = mapValue_ = NULL;
+    mapSize_ = mapUsed_ = 0;
 }
 
 void Multisphere::generate_map()
 {
     int idmax, idmax_all;
 
-    // deallocate old memory if exists
-    if(mapArray_) clear_map();
-
     if(nbody_all_ == 0)
+    {
+        clear_map();
         return;
+    }
 
     // get max ID of all proc
+    // only needed for new IDs and global lengths, map does not depend on it
     idmax = id_.max();
     MPI_Max_Scalar(idmax,idmax_all,world);
     mapTagMax_ = std::max(mapTagMax_,idmax_all);
 
-    // alocate and initialize new array
-    // IDs start at 1, have to go up to (inclusive) mapTagMax_
-    
-    memory->create(mapArray_,mapTagMax_+1,"Multisphere:mapArray_");
-    for(int i = 0; i < mapTagMax_+1; i++)
-        mapArray_[i] = -1;
+    // (re-)allocate for local bodies and clear
+    // also discards deleted slots
+
+    map_grow(nbody_);
 
     // build map
     for (int i = nbody_-1; i >= 0; i--)
     {
-        
-        mapArray_[id_(i)] = i;
+        map_set(id_(i),i);
+    }
+}
+
+/* ----------------------------------------------------------------------
+   make map empty and large enough to hold n bodies at load factor <= 1/2
+------------------------------------------------------------------------- */
+
+void Multisphere::map_grow(int n)
+{
+    int size = 64, shift = 26;
+    while(size < 2*(n+1))
+    {
+        size *= 2;
+        shift--;
+    }
+
+    if(size != mapSize_)
+    {
+        memory->destroy(mapKey_);
+        memory->destroy(mapValue_);
+        memory->create(mapKey_,size,"Multisphere:mapKey_");
+        memory->create(mapValue_,size,"Multisphere:mapValue_");
+        mapSize_ = size;
+        mapShift_ = shift;
+    }
+
+    for(int i = 0; i < mapSize_; i++)
+        mapKey_[i] = MAP_EMPTY;
+    mapUsed_ = 0;
+}
+
+/* ----------------------------------------------------------------------
+   insert or update map entry
+   table is rebuilt from scratch if it fills up with bodies and deleted
+   slots, which is cheap because it only holds local bodies, and only
+   grows if the bodies themselves need the space
+------------------------------------------------------------------------- */
+
+void Multisphere::map_set(int _tag, int ibody_local)
+{
+    if(_tag <= 0) return;
+
+    if(2*(mapUsed_+1) > mapSize_)
+    {
+        // keep entries, drop deleted slots
+        // if deleted slots outnumber the entries, the current size is
+        // large enough, else double it
+        int *key = mapKey_, *value = mapValue_;
+        const int size = mapSize_;
+        int nlive = 0;
+        for(int i = 0; i < size; i++)
+            if(key[i] > 0) nlive++;
+        const int ndeleted = mapUsed_ - nlive;
+        mapKey_ = mapValue_ = NULL;
+        mapSize_ = 0;
+
+        if(ndeleted > nlive)
+            map_grow(std::max(nbody_,size/2-1));
+        else
+            map_grow(std::max(nbody_,size/2));
+        for(int i = 0; i < size; i++)
+            if(key[i] > 0) map_set(key[i],value[i]);
+
+        memory->destroy(key);
+        memory->destroy(value);
+    }
+
+    const int mask = mapSize_-1;
+    int slot = -1;
+    int h = map_slot(_tag);
+
+    for(; ; h = (h+1) & mask)
+    {
+        if(mapKey_[h] == _tag)
+        {
+            mapValue_[h] = ibody_local;
+            return;
+        }
+        if(mapKey_[h] == MAP_DELETED && slot < 0)
+            slot = h;
+        if(mapKey_[h] == MAP_EMPTY)
+            break;
+    }
+
+    // re-use deleted slot if one was passed
+    if(slot < 0)
+    {
+        slot = h;
+        mapUsed_++;
+    }
+    mapKey_[slot] = _tag;
+    mapValue_[slot] = ibody_local;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Multisphere::map_erase(int _tag)
+{
+    if(!mapSize_ || _tag <= 0) return;
+
+    const int mask = mapSize_-1;
+    for(int h = map_slot(_tag); mapKey_[h] != MAP_EMPTY; h = (h+1) & mask)
+    {
+        if(mapKey_[h] == _tag)
+        {
+            mapKey_[h] = MAP_DELETED;
+            return;
+        }
     }
 }
 
@@ -84,6 +84,7 @@ namespace LAMMPS_NS {
 
       int calc_n_steps(int iatom,int body,double *p_ref,double *normalvec,double *v_normal);
       void recalc_n_steps(double dt_ratio);
+      void set_start_step(int body, int step);
       void release(int iatom,int body,double *v_toInsert,double *omega_toInsert);
 
       double max_r_bound();
@@ -115,14 +116,24 @@ namespace LAMMPS_NS {
       inline int tag_max_body()
       { return mapTagMax_; }
 
-      inline int map(int ibody_local)
-      { return mapArray_?mapArray_[ibody_local]:-1; }
+      // global-local lookup via open-addressing hash, -1 if not owned
+
+      inline int map(int _tag)
+      {
+        if(!mapSize_ || _tag <= 0) return -1;
+        const int mask = mapSize_-1;
+        for(int h = map_slot(_tag); ; h = (h+1) & mask)
+        {
+            if(mapKey_[h] == _tag) return mapValue_[h];
+            if(mapKey_[h] == MAP_EMPTY) return -1;
+        }
+      }
 
       inline int tag(int ibody_local)
       { return id_(ibody_local); }
 
       inline bool has_tag(int _tag)
-      { return mapArray_[_tag] == -1 ? false : true;}
+      { return map(_tag) >= 0; }
 
       inline int atomtype(int ibody_local)
       { return atomtype_(ibody_local); }
@@ -212,8 +223,28 @@ namespace LAMMPS_NS {
       int nbody_, nbody_all_;
 
       // global-local lookup
+      // hash table of size mapSize_ (power of 2) with linear probing
+      // mapUsed_ counts occupied and deleted slots
+      // size is proportional to # of local bodies, not to mapTagMax_
+
+      enum { MAP_EMPTY = 0, MAP_DELETED = -1 };
+
       int mapTagMax_;
-      int *mapArray_;
+      int mapSize_;
+      int mapShift_;
+      int mapUsed_;
+      int *mapKey_;
+      int *mapValue_;
+
+      // multiplicative hashing, the slot is taken from the high bits
+      // of the product so tags with power-of-two strides spread out
+
+      inline int map_slot(int _tag) const
+      { return static_cast<int>((static_cast<unsigned int>(_tag)*2654435761u) >> mapShift_); }
+
+      void map_grow(int n);
+      void map_set(int _tag, int ibody_local);
+      void map_erase(int _tag);
 
       // ID of rigid body
       
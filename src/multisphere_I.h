@@ -64,7 +64,7 @@ inline void Multisphere::copy_body(int from_local, int to_local)
 
     customValues_.copyElement(from_local, to_local);
 
-    mapArray_[tag_from] = to_local;
+    map_set(tag_from,to_local);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -72,8 +72,8 @@ inline void Multisphere::copy_body(int from_local, int to_local)
 inline void Multisphere::remove_body(int ilocal)
 {
     
-    mapArray_[id_(ilocal)] = -1;
-    if(nbody_ > 1) mapArray_[id_(nbody_-1)] = ilocal;
+    map_erase(id_(ilocal));
+    if(nbody_ > 1 && ilocal != nbody_-1) map_set(id_(nbody_-1),ilocal);
 
     /*if(ilocal < nbody_-1)
         copy_body(nbody_-1,ilocal);*/
@@ -146,6 +146,17 @@ inline void Multisphere::recalc_n_steps(double dt_ratio)
   }
 }
 
+/* ----------------------------------------------------------------------
+   set release step of a body that is not yet released
+------------------------------------------------------------------------- */
+
+inline void Multisphere::set_start_step(int body, int step)
+{
+    const int ibody = map(body);
+    if(ibody >= 0 && start_step_(ibody) > update->ntimestep)
+        start_step_(ibody) = step;
+}
+
 /* ---------------------------------------------------------------------- */
 
 inline void Multisphere::release(int iatom,int body,double *v_toInsert,double *omega_toInsert)
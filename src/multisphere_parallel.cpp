@@ -208,6 +208,11 @@ void MultisphereParallel::exchange()
 /* ----------------------------------------------------------------------
    restart functionality - write all required data into restart buffer
    executed on all processes, but only proc 0 writes into writebuf
+   body data is received and written one proc at a time, so proc 0 only
+   needs a buffer for the largest per-proc section
+   writing is still serialized through proc 0 and O(# of global bodies),
+   since bodies are a global fix section of the restart header and not
+   part of the per-proc chunks of an MPI-IO restart file
 ------------------------------------------------------------------------- */
 
 void MultisphereParallel::writeRestart(FILE *fp)
@@ -218,12 +223,12 @@ void MultisphereParallel::writeRestart(FILE *fp)
     double nba = static_cast<double>(n_body_all());
 
     int sizeLocal = n_body() * (customValues_.elemBufSize(OPERATION_RESTART, NULL, dummy,dummy,dummy) + 4);
-    int sizeGlobal = 0, sizeOne = 0;
+    int sizeGlobal = 0, sizeMax = 0, sizeOne = 0;
 
     // allocate send buffer and pack element data
     // all local elements are in list
     
-    memory->create(sendbuf,sizeLocal,"MultiNodeMeshParallel::writeRestart:sendbuf");
+    memory->create(sendbuf,sizeLocal > 0 ? sizeLocal : 1,"MultisphereParallel::writeRestart:sendbuf");
     sizeLocal = 0;
     for(int i = 0; i < n_body(); i++)
     {
@@ -237,11 +242,16 @@ void MultisphereParallel::writeRestart(FILE *fp)
         sizeLocal += (sizeOne+4);
     }
 
-    // gather the per-element data
-    
-    sizeGlobal = MPI_Gather0_Vector(sendbuf,sizeLocal,recvbuf,world);
+    MPI_Sum_Scalar(sizeLocal,sizeGlobal,world);
+    MPI_Max_Scalar(sizeLocal,sizeMax,world);
+
+    // write data to file, proc by proc in rank order
+    // handshake with each proc before it sends, as in Dump::write()
+
+    int tmp, nrecv;
+    MPI_Status status;
+    MPI_Request request;
 
-    // write data to file
     if(comm->me == 0)
     {
         
@@ -255,20 +265,35 @@ void MultisphereParallel::writeRestart(FILE *fp)
         fwrite(&nba,sizeof(double),1,fp);
 
         // write per-element data
-        fwrite(recvbuf,sizeof(double),sizeGlobal,fp);
+        fwrite(sendbuf,sizeof(double),sizeLocal,fp);
+
+        memory->create(recvbuf,sizeMax > 0 ? sizeMax : 1,"MultisphereParallel::writeRestart:recvbuf");
+        for(int iproc = 1; iproc < comm->nprocs; iproc++)
+        {
+            MPI_Irecv(recvbuf,sizeMax,MPI_DOUBLE,iproc,0,world,&request);
+            MPI_Send(&tmp,0,MPI_INT,iproc,0,world);
+            MPI_Wait(&request,&status);
+            MPI_Get_count(&status,MPI_DOUBLE,&nrecv);
+            fwrite(recvbuf,sizeof(double),nrecv,fp);
+        }
+        memory->destroy(recvbuf);
+    }
+    else
+    {
+        MPI_Recv(&tmp,0,MPI_INT,0,0,world,&status);
+        MPI_Rsend(sendbuf,sizeLocal,MPI_DOUBLE,0,0,world);
     }
 
     // clean up
 
     memory->destroy(sendbuf);
-    
-    if(recvbuf)
-      delete []recvbuf;
 }
 
 /* ----------------------------------------------------------------------
    restart functionality - read all required data from restart buffer
    executed on all processes
+   the global fix section is broadcast to all procs, so each proc scans
+   all bodies and keeps those inside its sub-domain, O(# of global bodies)
 ------------------------------------------------------------------------- */
 
 void MultisphereParallel::restart(double *list)
@@ -261,7 +261,7 @@ void Neighbor::skip_from_granular(NeighList *list)
 {
   int i,j,ii,jj,n,nn,itype,jnum,joriginal;
   int *neighptr,*jlist,*contact_flag_ptr,*contact_flag_ptr_skip;
-  double *contact_hist_ptr,*contact_hist_ptr_skip;
+  histtype *contact_hist_ptr,*contact_hist_ptr_skip;
 
   int *type = atom->type;
 
@@ -275,7 +275,7 @@ void Neighbor::skip_from_granular(NeighList *list)
   int *numneigh_skip = list->listskip->numneigh;
   int **firstneigh_skip = list->listskip->firstneigh;
   int **first_contact_flag_skip = list->listskip->listgranhistory->firstneigh;
-  double **first_contact_hist_skip = list->listskip->listgranhistory->firstdouble;
+  histtype **first_contact_hist_skip = list->listskip->listgranhistory->firstdouble;
   int inum_skip = list->listskip->inum;
 
   int *iskip = list->iskip;
@@ -283,9 +283,9 @@ void Neighbor::skip_from_granular(NeighList *list)
 
   NeighList *listgranhistory = list->listgranhistory;
   int **first_contact_flag = listgranhistory->firstneigh;
-  double **first_contact_hist = listgranhistory->firstdouble;
+  histtype **first_contact_hist = listgranhistory->firstdouble;
   MyPage<int> *ipage_contact_flag = listgranhistory->ipage;
-  MyPage<double> *dpage_contact_hist = listgranhistory->dpage;
+  MyPage<histtype> *dpage_contact_hist = listgranhistory->dpage;
 
   int inum = 0;
   ipage->reset();
@@ -73,15 +73,14 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
   int *neighptr,*contact_flag_ptr = NULL;
-  double *contact_hist_ptr = NULL;
+  histtype *contact_hist_ptr = NULL;
 
   NeighList *listgranhistory;
   int *npartner = NULL,**partner = NULL;
-  double **contacthistory = NULL; 
   int **first_contact_flag;
-  double **first_contact_hist;
+  histtype **first_contact_hist;
   MyPage<int> *ipage_contact_flag = NULL;
-  MyPage<double> *dpage_contact_hist = NULL;
+  MyPage<histtype> *dpage_contact_hist = NULL;
   int dnum = 0; 
 
   double **x = atom->x;
@@ -106,7 +105,6 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
   if (fix_history) {
     npartner = fix_history->npartner_; 
     partner = fix_history->partner_; 
-    contacthistory = fix_history->contacthistory_; 
     listgranhistory = list->listgranhistory;
     first_contact_flag = listgranhistory->firstneigh;
     first_contact_hist = listgranhistory->firstdouble;
@@ -159,9 +157,8 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
               if (partner[i][m] == tag[j]) break;
             if (m < npartner[i]) {
               contact_flag_ptr[n] = 1;
-              for (d = 0; d < dnum; d++) {  
-                contact_hist_ptr[nn++] = contacthistory[i][m*dnum+d];
-              }
+              fix_history->partner_history(i,m,&contact_hist_ptr[nn]);
+              nn += dnum;
             } else {
               contact_flag_ptr[n] = 0;
               for (d = 0; d < dnum; d++) {  
@@ -195,6 +192,10 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
   }
 
   list->inum = inum;
+
+  // list now holds the current history, fix may take over its pages again
+
+  if (fix_history) fix_history->adopted_ = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -302,20 +303,21 @@ void Neighbor::granular_nsq_newton(NeighList *list)
 
 void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
 {
+  int jbody = -1;
+  bool jbody_apart = false;
   int i,j,k,m,n,nn=0,ibin,d;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   int xbin,ybin,zbin,xbin2,ybin2,zbin2;
   double radi,radsum,cutsq;
   int *neighptr,*contact_flag_ptr = NULL;
-  double *contact_hist_ptr = NULL;
+  histtype *contact_hist_ptr = NULL;
 
   NeighList *listgranhistory;
   int *npartner = NULL,**partner = NULL;
-  double **contacthistory = NULL;
   int **first_contact_flag = NULL;
-  double **first_contact_hist = NULL;
+  histtype **first_contact_hist = NULL;
   MyPage<int> *ipage_contact_flag = NULL;
-  MyPage<double> *dpage_contact_hist = NULL;
+  MyPage<histtype> *dpage_contact_hist = NULL;
   int dnum = 0; 
 
   // bin local & ghost atoms
@@ -345,7 +347,6 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
   if (fix_history) {
     npartner = fix_history->npartner_; 
     partner = fix_history->partner_; 
-    contacthistory = fix_history->contacthistory_; 
     listgranhistory = list->listgranhistory;
     first_contact_flag = listgranhistory->firstneigh;
     first_contact_hist = listgranhistory->firstdouble;
@@ -385,9 +386,17 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
       ibin = coord2bin(x[i]);
 
       for (k = 0; k < nstencil; k++) {
+        jbody = -1;
         for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
           if (j <= i) continue;
           if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+          if (bsphere && molecule[j] >= 0) {
+            if (molecule[j] != jbody) {
+              jbody = molecule[j];
+              jbody_apart = body_spheres_apart(i,j,x);
+            }
+            if (jbody_apart) continue;
+          }
 
           delx = xtmp - x[j][0];
           dely = ytmp - x[j][1];
@@ -406,9 +415,8 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
                   if (partner[i][m] == tag[j]) break;
                 if (m < npartner[i]) {
                   contact_flag_ptr[n] = 1;
-                  for (d = 0; d < dnum; d++) { 
-                    contact_hist_ptr[nn++] = contacthistory[i][m*dnum+d];
-                  }
+                  fix_history->partner_history(i,m,&contact_hist_ptr[nn]);
+                  nn += dnum;
                 } else {
                    contact_flag_ptr[n] = 0;
                    for (d = 0; d < dnum; d++) { 
@@ -436,10 +444,18 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
         if (xbin2 < 0 || xbin2 >= mbinx ||
             ybin2 < 0 || ybin2 >= mbiny ||
             zbin2 < 0 || zbin2 >= mbinz) continue;
+        jbody = -1;
         for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
           if (j <= i) continue;
 
           if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+          if (bsphere && molecule[j] >= 0) {
+            if (molecule[j] != jbody) {
+              jbody = molecule[j];
+              jbody_apart = body_spheres_apart(i,j,x);
+            }
+            if (jbody_apart) continue;
+          }
 
           delx = xtmp - x[j][0];
           dely = ytmp - x[j][1];
@@ -471,6 +487,10 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
   }
 
   list->inum = inum;
+
+  // list now holds the current history, fix may take over its pages again
+
+  if (fix_history) fix_history->adopted_ = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -484,19 +504,20 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
 
 void Neighbor::granular_bin_no_newton(NeighList *list)
 {
+  int jbody = -1;
+  bool jbody_apart = false;
   int i,j,k,m,n,nn=0,ibin,d;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
   int *neighptr,*contact_flag_ptr = NULL;
-  double *contact_hist_ptr = NULL;
+  histtype *contact_hist_ptr = NULL;
 
   NeighList *listgranhistory;
   int *npartner = NULL,**partner = NULL;
-  double **contacthistory = NULL;
   int **first_contact_flag = NULL;
-  double **first_contact_hist = NULL;
+  histtype **first_contact_hist = NULL;
   MyPage<int> *ipage_contact_flag = NULL;
-  MyPage<double> *dpage_contact_hist = NULL;
+  MyPage<histtype> *dpage_contact_hist = NULL;
   int dnum = 0; 
 
   // bin local & ghost atoms
@@ -525,7 +546,6 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
   if (fix_history) {
     npartner = fix_history->npartner_; 
     partner = fix_history->partner_; 
-    contacthistory = fix_history->contacthistory_; 
     listgranhistory = list->listgranhistory;
     first_contact_flag = listgranhistory->firstneigh;
     first_contact_hist = listgranhistory->firstdouble;
@@ -566,11 +586,19 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
 
     for (k = 0; k < nstencil; k++) {
       
+      jbody = -1;
       for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
         
         if (j <= i) continue;
         
         if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+        if (bsphere && molecule[j] >= 0) {
+          if (molecule[j] != jbody) {
+            jbody = molecule[j];
+            jbody_apart = body_spheres_apart(i,j,x);
+          }
+          if (jbody_apart) continue;
+        }
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
@@ -593,9 +621,9 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
               if (m < npartner[i]) {
                 contact_flag_ptr[n] = 1;
                 
-                for (d = 0; d < dnum; d++) { 
-                  contact_hist_ptr[nn++] = contacthistory[i][m*dnum+d];
-                }
+                fix_history->partner_history(i,m,&contact_hist_ptr[nn]);
+                
+                nn += dnum;
               } else {
                  
                  contact_flag_ptr[n] = 0;
@@ -636,6 +664,10 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
   }
 
   list->inum = inum;
+
+  // list now holds the current history, fix may take over its pages again
+
+  if (fix_history) fix_history->adopted_ = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -648,6 +680,8 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
 
 void Neighbor::granular_bin_newton(NeighList *list)
 {
+  int jbody = -1;
+  bool jbody_apart = false;
   int i,j,k,n,ibin;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
@@ -691,6 +725,7 @@ void Neighbor::granular_bin_newton(NeighList *list)
     // if j is owned atom, store it, since j is beyond i in linked list
     // if j is ghost, only store if j coords are "above and to the right" of i
 
+    jbody = -1;
     for (j = bins[i]; j >= 0; j = bins[j]) {
       if (j >= nlocal) {
         if (x[j][2] < ztmp) continue;
@@ -701,6 +736,13 @@ void Neighbor::granular_bin_newton(NeighList *list)
       }
 
       if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+      if (bsphere && molecule[j] >= 0) {
+        if (molecule[j] != jbody) {
+          jbody = molecule[j];
+          jbody_apart = body_spheres_apart(i,j,x);
+        }
+        if (jbody_apart) continue;
+      }
 
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
@@ -716,8 +758,16 @@ void Neighbor::granular_bin_newton(NeighList *list)
 
     ibin = coord2bin(x[i]);
     for (k = 0; k < nstencil; k++) {
+      jbody = -1;
       for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
         if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+        if (bsphere && molecule[j] >= 0) {
+          if (molecule[j] != jbody) {
+            jbody = molecule[j];
+            jbody_apart = body_spheres_apart(i,j,x);
+          }
+          if (jbody_apart) continue;
+        }
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
@@ -751,6 +801,8 @@ void Neighbor::granular_bin_newton(NeighList *list)
 
 void Neighbor::granular_bin_newton_tri(NeighList *list)
 {
+  int jbody = -1;
+  bool jbody_apart = false;
   int i,j,k,n,ibin;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
@@ -798,6 +850,7 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
 
     ibin = coord2bin(x[i]);
     for (k = 0; k < nstencil; k++) {
+      jbody = -1;
       for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
         if (x[j][2] < ztmp) continue;
         if (x[j][2] == ztmp) {
@@ -809,6 +862,13 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
         }
 
         if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+        if (bsphere && molecule[j] >= 0) {
+          if (molecule[j] != jbody) {
+            jbody = molecule[j];
+            jbody_apart = body_spheres_apart(i,j,x);
+          }
+          if (jbody_apart) continue;
+        }
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
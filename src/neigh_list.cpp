@@ -163,7 +163,7 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller,
     ipage[i].init(oneatom,pgsize,PGDELTA);
 
   if (dnum) {
-    dpage = new MyPage<double>[nmypage];
+    dpage = new MyPage<histtype>[nmypage];
     for (int i = 0; i < nmypage; i++)
       dpage[i].init(dnum*oneatom,dnum*pgsize,PGDELTA);
   }
@@ -194,7 +194,7 @@ void NeighList::grow(int nmax)
                                         "neighlist:firstneigh");
 
   if (dnum)
-    firstdouble = (double **) memory->smalloc(maxatoms*sizeof(double *),
+    firstdouble = (histtype **) memory->smalloc(maxatoms*sizeof(histtype *),
                                               "neighlist:firstdouble");
 }
 
@@ -344,7 +344,7 @@ bigint NeighList::memory_usage()
 
   if (dnum && dpage) {
     for (int i = 0; i < nmypage; i++) {
-      bytes += maxatoms * sizeof(double *);
+      bytes += maxatoms * sizeof(histtype *);
       bytes += dpage[i].size();
     }
   }
@@ -75,13 +75,13 @@ class NeighList : protected Pointers {
   int *ilist;                      // local indices of I atoms
   int *numneigh;                   // # of J neighbors for each I atom
   int **firstneigh;                // ptr to 1st J int value of each I atom
-  double **firstdouble;            // ptr to 1st J double value of each I atom
+  histtype **firstdouble;          // ptr to 1st J history value of each I atom
 
   int pgsize;                      // size of each page
   int oneatom;                     // max size for one atom
-  int dnum;                        // # of doubles per neighbor, 0 if none
+  int dnum;                        // # of history values per neighbor, 0 if none
   MyPage<int> *ipage;              // pages of neighbor indices
-  MyPage<double> *dpage;           // pages of neighbor doubles, if dnum > 0
+  MyPage<histtype> *dpage;         // pages of neighbor history, if dnum > 0
 
   // atom types to skip when building list
   // iskip,ijskip are just ptrs to corresponding request
@@ -120,6 +120,7 @@ Neighbor::Neighbor(LAMMPS *lmp) : Pointers(lmp)
   every = 1;
   delay = 10;
   contactDistanceFactor = 1.0; 
+  bsphere = NULL;
   dist_check = 1;
   pgsize = 100000;
   oneatom = 2000;
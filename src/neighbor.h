@@ -141,6 +141,14 @@ class Neighbor : protected Pointers {
   void register_contact_dist_factor(double cdf)
   { contactDistanceFactor = std::max(contactDistanceFactor,cdf); }
 
+  // per-atom bounding sphere of the multisphere body an atom belongs to,
+  // set by fix multisphere before each build and whenever it reallocates
+  // the array: offset from atom to sphere center (3 values) and sphere
+  // radius (< 0 if not known)
+
+  void set_body_spheres(double **bs)
+  { bsphere = bs; }
+
  protected:
   int me,nprocs;
 
@@ -243,6 +251,26 @@ class Neighbor : protected Pointers {
   int exclusion(int, int, int,
                 int, int *, int *) const;  // test for pair exclusion
 
+  double **bsphere;                // body bounding spheres, see above
+
+  // true if the bounding spheres of the bodies of i and j are further
+  // apart than the neighbor cutoff, so no atom pair of the two bodies
+  // can be in range
+  // granular bin builds keep the result for consecutive atoms of the same
+  // body within one bin, periodic images of a body cannot share a bin
+
+  inline bool body_spheres_apart(int i, int j, double **x) const
+  {
+    const double * const bi = bsphere[i];
+    const double * const bj = bsphere[j];
+    if (bi[3] < 0. || bj[3] < 0.) return false;
+    const double delx = x[i][0] + bi[0] - x[j][0] - bj[0];
+    const double dely = x[i][1] + bi[1] - x[j][1] - bj[1];
+    const double delz = x[i][2] + bi[2] - x[j][2] - bj[2];
+    const double cut = (bi[3] + bj[3]) * contactDistanceFactor + skin;
+    return delx*delx + dely*dely + delz*delz > cut*cut;
+  }
+
   virtual void choose_build(int, class NeighRequest *);
   void choose_stencil(int, class NeighRequest *);
 
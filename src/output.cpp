@@ -417,6 +417,7 @@ void Output::write(bigint ntimestep)
         if (!has_restart)
             restart = new WriteRestart(lmp);
         restart->write(file);
+        restart->wait();
         if (!has_restart)
         {
             delete restart;
@@ -753,6 +754,7 @@ void Output::create_restart(int narg, char **arg)
     restart_flag = restart_flag_single = restart_flag_double = false;
     last_restart = -1;
 
+    if (restart) restart->wait();
     delete restart;
     restart = NULL;
     delete [] restart1;
@@ -766,6 +768,30 @@ void Output::create_restart(int narg, char **arg)
     return;
   }
 
+  // optional keywords follow the file name(s)
+
+  int nfile = narg;
+  for (int iarg = 1; iarg < narg; iarg++)
+    if (strcmp(arg[iarg],"async") == 0 || strcmp(arg[iarg],"async_memory") == 0) {
+      nfile = iarg;
+      break;
+    }
+
+  int asyncflag = 0;
+  double async_memory = 512.0;
+  for (int iarg = nfile; iarg < narg; iarg += 2) {
+    if (iarg+2 > narg) error->all(FLERR,"Illegal restart command");
+    if (strcmp(arg[iarg],"async") == 0) {
+      if (strcmp(arg[iarg+1],"yes") == 0) asyncflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) asyncflag = 0;
+      else error->all(FLERR,"Illegal restart command");
+    } else if (strcmp(arg[iarg],"async_memory") == 0) {
+      async_memory = force->numeric(FLERR,arg[iarg+1]);
+      if (async_memory < 0.0) error->all(FLERR,"Illegal restart command");
+    } else error->all(FLERR,"Illegal restart command");
+  }
+  narg = nfile;
+
   if (narg != 2 && narg != 3) error->all(FLERR,"Illegal restart command");
 
   if (narg == 2) {
@@ -806,6 +832,17 @@ void Output::create_restart(int narg, char **arg)
   }
 
   if (restart == NULL) restart = new WriteRestart(lmp);
+  restart->set_async(asyncflag,async_memory);
+}
+
+/* ----------------------------------------------------------------------
+   wait for restart file still being written in background
+   called at end of run/minimize
+------------------------------------------------------------------------- */
+
+void Output::wait_restart()
+{
+  if (restart) restart->wait();
 }
 
 /* ----------------------------------------------------------------------
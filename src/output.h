@@ -94,6 +94,8 @@ class Output : protected Pointers {
 
   void request_restart(const bigint);   // requests a restart write in the next step (for use in Min)
 
+  void wait_restart();                  // wait for background restart write
+
  private:
   bool restart_flag;           // true if any restart files are written
   bool restart_flag_single;    // true if single restart files are written
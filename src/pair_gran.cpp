@@ -103,6 +103,13 @@ PairGran::PairGran(LAMMPS *lmp) : Pair(lmp)
 
   nmax = 0;
 
+  pair_cache_flag_ = 0;
+  pair_cache_vary_ = 0;
+  pair_cache_ncalls_ = -1;
+  pair_cache_ = NULL;
+  pair_cache_offset_ = NULL;
+  pair_cache_max_ = pair_cache_nmax_ = 0;
+
   cpl_enable = 1;
   cpl_ = NULL;
 
@@ -162,6 +169,9 @@ PairGran::~PairGran()
 
   if(fix_dnum) delete []fix_dnum;
   if(dnum_index) delete []dnum_index;
+
+  memory->destroy(pair_cache_);
+  memory->destroy(pair_cache_offset_);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -236,6 +246,18 @@ void PairGran::init_style()
   if(0 == comm->me && 0 != neighbor->delay)
     error->warning(FLERR,"It is heavily recommended to use 'neigh_modify delay 0' with granular pair styles");
 
+  // masses, rigid bodies or the freeze group may have changed since the
+  // last run, so rebuild the per-pair cache with the next neighbor list
+
+  pair_cache_ncalls_ = -1;
+
+  // fixes like fix adapt rewrite radius and mass without reneighboring,
+  // atom->radvary_flag is only set by the sphere atom styles
+
+  pair_cache_vary_ = 0;
+  for (i = 0; i < modify->nfix; i++)
+    if (modify->fix[i]->rad_mass_vary_flag) pair_cache_vary_ = 1;
+
   if(strcmp(update->unit_style,"metal") ==0 || strcmp(update->unit_style,"real") == 0)
     error->all(FLERR,"Cannot use a non-consistent unit system with pair gran. Please use si,cgs or lj.");
 
@@ -662,11 +684,24 @@ void PairGran::compute(int eflag, int vflag)
     comm->forward_comm_pair(this);
   }
 
+   if (neighbor->ncalls != pair_cache_ncalls_)
+     build_pair_cache();
+
    computeflag_ = 1;
    shearupdate_ = 1;
    if (update->setupflag) shearupdate_ = 0;
 
-   compute_force(eflag,vflag,0);
+   // if compute pair/gran/local is invoked on this step,
+   // store the contacts now instead of re-computing them at output
+
+   int addflag = 0;
+   if (cpl_ && cpl_->capture_step())
+   {
+       cpl_->begin_capture();
+       addflag = 1;
+   }
+
+   compute_force(eflag,vflag,addflag);
 }
 
 /* ----------------------------------------------------------------------
@@ -696,6 +731,9 @@ void PairGran::compute_pgl(int eflag, int vflag)
     comm->forward_comm_pair(this);
   }
 
+  if (neighbor->ncalls != pair_cache_ncalls_)
+    build_pair_cache();
+
   bool reset_computeflag = (computeflag_ == 1) ? true : false;
 
   computeflag_ = 0;
@@ -781,6 +819,84 @@ void *PairGran::extract(const char *str, int &dim)
   return NULL;
 }
 
+/* ----------------------------------------------------------------------
+   store meff, mi, mj of all pairs of the neighbor list
+   these only change on reneighboring unless radius and mass vary
+   (atom->radvary_flag or a fix with rad_mass_vary_flag) or the contact
+   radius is modified per contact (multicontact), rigid body masses are
+   refreshed on reneighboring anyway
+   fixes that change mass only occasionally call reset_pair_cache()
+------------------------------------------------------------------------- */
+
+void PairGran::build_pair_cache()
+{
+  pair_cache_ncalls_ = neighbor->ncalls;
+  pair_cache_flag_ = 0;
+  if (!list || atom->radvary_flag || pair_cache_vary_ || store_multicontact_data_)
+    return;
+
+  const int inum = list->inum;
+  const int * const ilist = list->ilist;
+  const int * const numneigh = list->numneigh;
+  int ** const firstneigh = list->firstneigh;
+
+  if (atom->nmax > pair_cache_nmax_) {
+    memory->destroy(pair_cache_offset_);
+    pair_cache_nmax_ = atom->nmax;
+    memory->create(pair_cache_offset_,pair_cache_nmax_,"pair:pair_cache_offset");
+  }
+
+  int n = 0;
+  for (int ii = 0; ii < inum; ii++) {
+    pair_cache_offset_[ilist[ii]] = n;
+    n += 3*numneigh[ilist[ii]];
+  }
+
+  if (n > pair_cache_max_ || !pair_cache_) {
+    memory->destroy(pair_cache_);
+    pair_cache_max_ = n > 0 ? n : 1;
+    memory->create(pair_cache_,pair_cache_max_,"pair:pair_cache");
+  }
+
+  const double * const rmass = atom->rmass;
+  const double * const mass = atom->mass;
+  const int * const type = atom->type;
+  const int * const mask = atom->mask;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int * const jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    double * const cache = &pair_cache_[pair_cache_offset_[i]];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int j = jlist[jj] & NEIGHMASK;
+
+      // same as in the pair loop: if I or J part of rigid body, use body
+      // mass, if I or J is frozen, meff is other particle
+
+      double mi = rmass ? rmass[i] : mass[type[i]];
+      double mj = rmass ? rmass[j] : mass[type[j]];
+      if (fix_rigid) {
+        if (mass_rigid[i] > 0.0) mi = mass_rigid[i];
+        if (mass_rigid[j] > 0.0) mj = mass_rigid[j];
+      }
+
+      double meff = mi * mj / (mi + mj);
+      if (mask[i] & freeze_group_bit_)
+        meff = mj;
+      if (mask[j] & freeze_group_bit_)
+        meff = mi;
+
+      cache[3*jj] = meff;
+      cache[3*jj+1] = mi;
+      cache[3*jj+2] = mj;
+    }
+  }
+
+  pair_cache_flag_ = 1;
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local atom-based arrays
 ------------------------------------------------------------------------- */
@@ -788,6 +904,8 @@ void *PairGran::extract(const char *str, int &dim)
 double PairGran::memory_usage()
 {
   double bytes = nmax * sizeof(double);
+  bytes += pair_cache_max_ * sizeof(double);
+  bytes += pair_cache_nmax_ * sizeof(int);
   return bytes;
 }
 
@@ -157,6 +157,15 @@ public:
   double relax(int i)
   { return (fix_relax_ ? fix_relax_->factor_relax(i) : 1.); }
 
+  // meff, mi, mj of the neighbors of atom i, NULL if not cached
+  inline const double * pair_cache(int i) const
+  { return pair_cache_flag_ ? &pair_cache_[pair_cache_offset_[i]] : NULL; }
+
+  // rebuild the per-pair cache before the next force computation,
+  // to be called by fixes that change radius or mass between reneighborings
+  inline void reset_pair_cache()
+  { pair_cache_ncalls_ = -1; }
+
   virtual double stressStrainExponent() = 0;
 
   int fix_extra_dnum_index(class Fix *fix);
@@ -266,6 +275,19 @@ public:
   double *mass_rigid;        // rigid mass for owned+ghost atoms
   int nmax;                  // allocated size of mass_rigid
 
+  // per-pair invariants of the neighbor list, i.e. the effective mass and
+  // the (rigid body) masses of both partners, rebuilt whenever the list is
+  // rebuilt, not cached if particle radius and mass vary with time
+
+  void build_pair_cache();
+  int pair_cache_flag_;      // 1 if pair_cache_ is valid for the list
+  int pair_cache_vary_;      // 1 if a fix varies radius and mass every step
+  bigint pair_cache_ncalls_; // neighbor build the cache belongs to
+  double *pair_cache_;       // 3 values per neighbor
+  int *pair_cache_offset_;   // offset of the 1st neighbor of each I atom
+  int pair_cache_max_;       // allocated size of pair_cache_
+  int pair_cache_nmax_;      // allocated size of pair_cache_offset_
+
   double dt;
   int freeze_group_bit_;
 
@@ -218,9 +218,14 @@ public:
 
     int ** firstneigh = pg->list->firstneigh;
     int ** first_contact_flag = pg->listgranhistory ? pg->listgranhistory->firstneigh : NULL;
-    double ** first_contact_hist = pg->listgranhistory ? pg->listgranhistory->firstdouble : NULL;
+    histtype ** first_contact_hist = pg->listgranhistory ? pg->listgranhistory->firstdouble : NULL;
 
     const int dnum = pg->dnum();
+#ifdef LIGGGHTS_FLOAT_HISTORY
+    // contact models operate on double, single precision history values
+    // are widened into this buffer and narrowed back after the pair
+    std::vector<double> contact_hist_buf(dnum > 0 ? dnum : 1);
+#endif
     const bool store_contact_forces = pg->storeContactForces();
     const bool store_contact_forces_stress = pg->storeContactForcesStress();
     const int freeze_group_bit = pg->freeze_group_bit();
@@ -263,7 +268,8 @@ public:
       const double ztmp = x[i][2];
       double radi = radius[i];
       int * const contact_flags = first_contact_flag ? first_contact_flag[i] : NULL;
-      double * const all_contact_hist = first_contact_hist ? first_contact_hist[i] : NULL;
+      const double * const pair_cache = pg->pair_cache(i);
+      histtype * const all_contact_hist = first_contact_hist ? first_contact_hist[i] : NULL;
       int * const jlist = firstneigh[i];
       const int jnum = numneigh[i];
 
@@ -287,16 +293,18 @@ public:
         double radj = radius[j];
 
         // In case of multicontact models use the computed delta_ij and delta_ji to expand the radius (on a per contact basis)
+        // the position of the contact in the partner lists was stored with it,
+        // only ghost partner lists come from another proc and need a search
         if (pg->storeSumDelta()) {
             FixContactPropertyAtom* mcFix = pg->fix_store_multicontact_delta();
-            const int cj = mcFix->has_partner(i, tag[j]);
+            const int cj = mcFix->pair_slot_i(i, jj);
             radi = radius[i];
             if (cj != -1)
             {
                 const double * const dataI = mcFix->contacthistory(i, cj);
                 radi += dataI[3];
             }
-            const int ci = mcFix->has_partner(j, tag[i]);
+            const int ci = j < nlocal ? mcFix->pair_slot_j(i, jj) : mcFix->has_partner(j, tag[i]);
             if (ci != -1)
             {
                 const double * const dataJ = mcFix->contacthistory(j, ci);
@@ -321,11 +329,24 @@ public:
         sidata.rsq = rsq;
         sidata.radsum = radsum;
         sidata.contact_flags = contact_flags ? &contact_flags[jj] : NULL;
+#ifdef LIGGGHTS_FLOAT_HISTORY
+        histtype * const pair_hist = all_contact_hist ? &all_contact_hist[dnum*jj] : NULL;
+        if (pair_hist) {
+          for (int d = 0; d < dnum; d++)
+            contact_hist_buf[d] = pair_hist[d];
+          sidata.contact_history = &contact_hist_buf[0];
+        } else
+          sidata.contact_history = NULL;
+#else
         sidata.contact_history = all_contact_hist ? &all_contact_hist[dnum*jj] : NULL;
+#endif
 //
-        sidata.rhof = Lwx[i][0];
-        sidata.nuf = Lwx[i][1];   
-        sidata.alphas = Lwx2[i][0];
+        // not all atom styles carry Lwx, Lwx2 (e.g. superquadric)
+        if (Lwx) {
+          sidata.rhof = Lwx[i][0];
+          sidata.nuf = Lwx[i][1];
+          sidata.alphas = Lwx2[i][0];
+        }
 //
 
         if (!fix_insert.empty())
@@ -375,26 +396,33 @@ public:
           // meff = effective mass of pair of particles
           // if I or J part of rigid body, use body mass
           // if I or J is frozen, meff is other particle
-          double mi, mj;
+          // taken from the per-pair cache if it was built for this list
+          double mi, mj, meff;
 
-          if (rmass) {
-            mi = rmass[i];
-            mj = rmass[j];
+          if (pair_cache) {
+            meff = pair_cache[3*jj];
+            mi = pair_cache[3*jj+1];
+            mj = pair_cache[3*jj+2];
           } else {
-            mi = mass[itype];
-            mj = mass[jtype];
-          }
-          if (pg->fr_pair()) {
-            const double * mass_rigid = pg->mr_pair();
-            if (mass_rigid[i] > 0.0) mi = mass_rigid[i];
-            if (mass_rigid[j] > 0.0) mj = mass_rigid[j];
-          }
+            if (rmass) {
+              mi = rmass[i];
+              mj = rmass[j];
+            } else {
+              mi = mass[itype];
+              mj = mass[jtype];
+            }
+            if (pg->fr_pair()) {
+              const double * mass_rigid = pg->mr_pair();
+              if (mass_rigid[i] > 0.0) mi = mass_rigid[i];
+              if (mass_rigid[j] > 0.0) mj = mass_rigid[j];
+            }
 
-          double meff = mi * mj / (mi + mj);
-          if (mask[i] & freeze_group_bit)
-            meff = mj;
-          if (mask[j] & freeze_group_bit)
-            meff = mi;
+            meff = mi * mj / (mi + mj);
+            if (mask[i] & freeze_group_bit)
+              meff = mj;
+            if (mask[j] & freeze_group_bit)
+              meff = mi;
+          }
 
           // copy collision data to struct (compiler can figure out a better way to
           // interleave these stores with the double calculations above.
@@ -419,7 +447,7 @@ public:
           // if there is a surface touch, there will always be a force
           sidata.has_force_update = true;
 //
-          Lwx[i][2] = 1;
+          if (Lwx) Lwx[i][2] = 1;
 //
 
         // surfacesClose is not supported for convex particles
@@ -430,6 +458,12 @@ public:
         } else
           sidata.has_force_update = false;
 
+#ifdef LIGGGHTS_FLOAT_HISTORY
+        if (pair_hist)
+          for (int d = 0; d < dnum; d++)
+            pair_hist[d] = static_cast<histtype>(contact_hist_buf[d]);
+#endif
+
         if(sidata.has_force_update) {
           if (sidata.computeflag) {
 
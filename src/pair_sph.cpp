@@ -60,6 +60,7 @@
 #include "memory.h"
 #include "error.h"
 #include "sph_kernels.h"
+#include "sph_kernel_table.h"
 #include "fix_property_atom.h"
 #include "fix_property_global.h"
 #include "timer.h"
@@ -78,6 +79,9 @@ PairSph::PairSph(LAMMPS *lmp) : Pair(lmp)
 
     kernel_style = NULL;
 
+    kernelTableN_ = 0;
+    kernelTable_ = NULL;
+
     fppaSl = NULL;
     fppaSlType = NULL;
     sl = NULL;
@@ -85,6 +89,13 @@ PairSph::PairSph(LAMMPS *lmp) : Pair(lmp)
 
     fix_fgradP_ = NULL;
 
+    kcOffset_ = NULL;
+    kcR_ = kcW_ = kcDW_ = NULL;
+    kcS_ = kcH_ = kcHinv_ = NULL;
+    kcOffsetMax_ = kcMax_ = 0;
+    kcStep_ = kcNcalls_ = -1;
+    kcRespa_ = false;
+
     mass_type = atom->avec->mass_type; // get flag for mass per type
 
     const char *fixarg[11];
@@ -116,10 +127,19 @@ PairSph::~PairSph()
   delete [] onerad;
 
   if(kernel_style) delete []kernel_style;
+  delete kernelTable_;
   if(fppaSl) modify->delete_fix("sl");
 //  if(fppaSlType) modify->delete_fix("sl");
 
   if(fix_fgradP_) modify->delete_fix(fix_fgradP_->id);
+
+  memory->destroy(kcOffset_);
+  memory->destroy(kcR_);
+  memory->destroy(kcW_);
+  memory->destroy(kcDW_);
+  memory->destroy(kcS_);
+  memory->destroy(kcH_);
+  memory->destroy(kcHinv_);
 }
 
 /* ----------------------------------------------------------------------
@@ -325,6 +345,22 @@ void PairSph::init_style()
     MPI_Allreduce(&onerad[1],&maxrad[1],atom->ntypes,MPI_DOUBLE,MPI_MAX,world);
   }
 
+  // positions change between rRESPA levels, so the kernel cache
+  // is only used with a single-level integrator
+
+  kcRespa_ = (strcmp(update->integrate_style,"respa") == 0);
+  kcStep_ = kcNcalls_ = -1;
+
+  // tabulate kernel if requested
+
+  delete kernelTable_;
+  kernelTable_ = NULL;
+  if (kernelTableN_ > 0) {
+    kernelTable_ = new SPH_KERNEL_NS::SPHKernelTable();
+    if (!kernelTable_->build(kernel_id,kernelTableN_))
+      error->all(FLERR,"Pair sph: kernel can not be tabulated, use analytic evaluation");
+  }
+
   // proceed with initialisation of the substyle
   init_substyle();
 
@@ -395,3 +431,168 @@ double PairSph::interpDist(double disti, double distj)
   return 0.5*(disti+distj);
 }
 */
+
+/* ----------------------------------------------------------------------
+   kernel of id kid, from the lookup table if it tabulates this kernel
+------------------------------------------------------------------------- */
+
+double PairSph::kernel(int kid, double s, double h, double hinv)
+{
+  if (kernelTable_ && kid == kernel_id) {
+    double W,dW;
+    kernelTable_->eval(s,hinv,W,dW);
+    return W;
+  }
+  return SPH_KERNEL_NS::sph_kernel(kid,s,h,hinv);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairSph::kernel_der(int kid, double s, double h, double hinv)
+{
+  if (kernelTable_ && kid == kernel_id) {
+    double W,dW;
+    kernelTable_->eval(s,hinv,W,dW);
+    return dW;
+  }
+  return SPH_KERNEL_NS::sph_kernel_der(kid,s,h,hinv);
+}
+
+/* ----------------------------------------------------------------------
+   give access to the per-pair kernel cache
+   only valid if lst shares the pair neighbor list (i.e. is a copy of it)
+   and uses the same kernel, cache is re-built once per step and after
+   each re-neighboring
+------------------------------------------------------------------------- */
+
+bool PairSph::kernel_cache_request(NeighList *lst, int kid)
+{
+  if (kcRespa_ || !list || !lst || kid != kernel_id) return false;
+  if (lst->ilist != list->ilist || lst->firstneigh != list->firstneigh) return false;
+
+  if (kcStep_ != update->ntimestep || kcNcalls_ != neighbor->ncalls)
+  {
+    if (mass_type) kernel_cache_build<1>();
+    else kernel_cache_build<0>();
+
+    kcStep_ = update->ntimestep;
+    kcNcalls_ = neighbor->ncalls;
+  }
+
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate distance, W and dW/ds for all pairs of the neighbor list
+   ghost positions and smoothing lengths must be current
+------------------------------------------------------------------------- */
+
+template <int MASSFLAG>
+void PairSph::kernel_cache_build()
+{
+  double sli = 0.,slCom;
+
+  double **x = atom->x;
+  int *type = atom->type;
+
+  const int inum = list->inum;
+  int * const ilist = list->ilist;
+  int * const numneigh = list->numneigh;
+  int ** const firstneigh = list->firstneigh;
+
+  const double kernel_cut = SPH_KERNEL_NS::sph_kernel_cut(kernel_id);
+
+  updatePtrs(); // get sl
+
+  // offsets of each i into the pair-aligned arrays
+
+  if (inum+1 > kcOffsetMax_) {
+    kcOffsetMax_ = inum+1;
+    memory->grow(kcOffset_,kcOffsetMax_,"pair:kcOffset");
+  }
+
+  kcOffset_[0] = 0;
+  for (int ii = 0; ii < inum; ii++)
+    kcOffset_[ii+1] = kcOffset_[ii] + numneigh[ilist[ii]];
+
+  const int npairs = kcOffset_[inum];
+  if (npairs > kcMax_) {
+    kcMax_ = npairs;
+    memory->grow(kcR_,kcMax_,"pair:kcR");
+    memory->grow(kcW_,kcMax_,"pair:kcW");
+    memory->grow(kcDW_,kcMax_,"pair:kcDW");
+    memory->grow(kcS_,kcMax_,"pair:kcS");
+    memory->grow(kcH_,kcMax_,"pair:kcH");
+    memory->grow(kcHinv_,kcMax_,"pair:kcHinv");
+  }
+
+  // pass 1: distances and normalized distances
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+    int * const jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    const int offset = kcOffset_[ii];
+
+    if (!MASSFLAG) sli = sl[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int j = jlist[jj];
+      const int kp = offset + jj;
+
+      if (MASSFLAG) slCom = slComType[itype][type[j]];
+      else slCom = interpDist(sli,sl[j]);
+
+      const double cut = slCom*kernel_cut;
+      const double delx = xtmp - x[j][0];
+      const double dely = ytmp - x[j][1];
+      const double delz = ztmp - x[j][2];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq >= cut*cut) {
+        // dummy values, pair is skipped by all users of the cache
+        kcR_[kp] = -1.;
+        kcS_[kp] = 0.;
+        kcH_[kp] = kcHinv_[kp] = 1.;
+        continue;
+      }
+
+      const double slComInv = 1./slCom;
+      const double r = sqrt(rsq);
+
+      kcR_[kp] = r;
+      kcS_[kp] = r*slComInv;
+      kcH_[kp] = slCom;
+      kcHinv_[kp] = slComInv;
+    }
+  }
+
+  // pass 2: kernel and derivative, either from the table or with
+  // the kernel functor inlined into a batch loop
+
+  if (kernelTable_) {
+    for (int kp = 0; kp < npairs; kp++)
+      kernelTable_->eval(kcS_[kp],kcHinv_[kp],kcW_[kp],kcDW_[kp]);
+  }
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(kid,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == kid) \
+    SPH_KERNEL_NS::sph_kernel_batch< SPH_KERNEL_NS::SPHKernelSpec<kid> >(npairs,kcS_,kcH_,kcHinv_,kcW_,kcDW_);
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+
+  // error check
+
+  for (int kp = 0; kp < npairs; kp++) {
+    if (kcR_[kp] >= 0. && kcW_[kp] < 0.)
+    {
+      fprintf(screen,"s = %f, W = %f\n",kcS_[kp],kcW_[kp]);
+      error->one(FLERR,"Illegal kernel used, W < 0");
+    }
+  }
+}
@@ -49,6 +49,10 @@
 
 #include "pair.h"
 
+namespace SPH_KERNEL_NS {
+  class SPHKernelTable;
+}
+
 namespace LAMMPS_NS {
 
 class PairSph : public Pair {
@@ -81,6 +85,27 @@ class PairSph : public Pair {
   int returnPairStyle(){return pairStyle_; };
   double returnViscosity() {return viscosity_; };
 
+  /* KERNEL EVALUATION */
+
+  // kernel and derivative dW/ds as evaluated by this pair style, i.e. from
+  // the lookup table if the kernel is tabulated; all users of kernel kid
+  // go through these so that tabulated and analytic values are not mixed
+
+  double kernel(int kid, double s, double h, double hinv);
+  double kernel_der(int kid, double s, double h, double hinv);
+
+  /* PER-PAIR KERNEL CACHE */
+
+  // distance, kernel and kernel derivative of every pair in the neighbor
+  // list, evaluated once per time-step and shared by the sph fixes
+  // using the same list and kernel; r < 0 marks pairs outside the cutoff
+
+  bool kernel_cache_request(class NeighList *, int);
+  inline int kernel_cache_offset(int ii) {return kcOffset_[ii];}
+  inline const double *kernel_cache_r() {return kcR_;}
+  inline const double *kernel_cache_W() {return kcW_;}
+  inline const double *kernel_cache_dW() {return kcDW_;}
+
  protected:
 
   void allocate();
@@ -98,6 +123,10 @@ class PairSph : public Pair {
   int kernel_id;
   char *kernel_style;
 
+  // optional lookup table for the kernel, 0 = analytic evaluation
+  int kernelTableN_;
+  SPH_KERNEL_NS::SPHKernelTable *kernelTable_;
+
   double *onerad;
   double *maxrad;
 
@@ -109,6 +138,17 @@ class PairSph : public Pair {
   // storage for force part caused by pressure gradient (grad P / rho):
   class FixPropertyAtom* fix_fgradP_;
   double **fgradP_;
+
+ private:
+
+  template <int MASSFLAG> void kernel_cache_build();
+
+  int *kcOffset_;
+  double *kcR_, *kcW_, *kcDW_;
+  double *kcS_, *kcH_, *kcHinv_; // scratch for batched kernel evaluation
+  int kcOffsetMax_, kcMax_;
+  bigint kcStep_, kcNcalls_;
+  bool kcRespa_;
 };
 
 }
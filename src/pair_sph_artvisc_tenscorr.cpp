@@ -147,6 +147,12 @@ void PairSphArtviscTenscorr::settings(int narg, char **arg)
       if (iarg+1 > narg) error->all(FLERR, "Illegal pair_style sph command");
       tensCorr_flag = 1;
       iarg += 1;
+    } else if (strcmp(arg[iarg],"tabulate") == 0) {
+      // number of intervals for kernel lookup table
+      if (iarg+2 > narg) error->all(FLERR, "Illegal pair_style sph command");
+      kernelTableN_ = force->inumeric(FLERR,arg[iarg+1]);
+      if (kernelTableN_ < 1) error->all(FLERR, "Illegal pair_style sph command, tabulate expects a positive number");
+      iarg += 2;
     } else error->all(FLERR, "Illegal pair_style sph command");
   }
 }
@@ -205,7 +211,7 @@ void PairSphArtviscTenscorr::init_substyle()
 
         const double slCom = slComType[i][j];
         const double slComInv = 1./slCom;
-        wDeltaPTypeinv[i][j] = 1./SPH_KERNEL_NS::sph_kernel(kernel_id,meanDeltaP * slComInv,slCom,slComInv);
+        wDeltaPTypeinv[i][j] = 1./kernel(kernel_id,meanDeltaP * slComInv,slCom,slComInv);
       }
     }
   }
@@ -373,6 +379,13 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
     updatePtrs(); // get sl
   }
 
+  // kernel values of this step may already be known from the sph fixes
+
+  const bool cached = kernel_cache_request(list,kernel_id);
+  const double * const kcR = cached ? kernel_cache_r() : NULL;
+  const double * const kcW = cached ? kernel_cache_W() : NULL;
+  const double * const kcDW = cached ? kernel_cache_dW() : NULL;
+
   for (int ii = 0; ii < inum; ii++) {
     const int i = ilist[ii];
     const int itype = type[i];
@@ -405,12 +418,14 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
       const double delz = ztmp - x[j][2];
       const double rsq = delx*delx + dely*dely + delz*delz;
 
+      const int kp = cached ? kernel_cache_offset(ii) + jj : 0;
+
       if (!MASSFLAG) {
         const double radj = radius[j];
         rcom = interpDist(radi,radj);
       }
 
-      if ((MASSFLAG && rsq < cutsq[itype][jtype]) || (!MASSFLAG && rsq < rcom*rcom)) {
+      if (cached ? (kcR[kp] >= 0.) : ((MASSFLAG && rsq < cutsq[itype][jtype]) || (!MASSFLAG && rsq < rcom*rcom))) {
 
         if (MASSFLAG) {
           jmass = mass[jtype];
@@ -427,7 +442,7 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
         //cut = slCom*SPH_KERNEL_NS::sph_kernel_cut(kernel_id);
 
         // get distance and normalized distance
-        const double r = sqrt(rsq);
+        const double r = cached ? kcR[kp] : sqrt(rsq);
         if (r == 0.) {
           printf("Particle %i and %i are at same position (%f, %f, %f)",i,j,xtmp,ytmp,ztmp);
           error->one(FLERR,"Zero distance between SPH particles!");
@@ -436,7 +451,7 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
         const double s = r * slComInv;
 
         // calculate value for magnitude of grad W
-        const double gradWmag = SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,slCom,slComInv);
+        const double gradWmag = cached ? kcDW[kp] : kernel_der(kernel_id,s,slCom,slComInv);
 
         // artificial viscosity
         artVisc = 0.0;
@@ -477,11 +492,11 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
           } else {
             // assumption that deltaP = sl / 1.2
             const double deltaPOne = slCom/1.2;
-            wDeltaPinv = 1./SPH_KERNEL_NS::sph_kernel(kernel_id,deltaPOne * slComInv,slCom,slComInv);
+            wDeltaPinv = 1./kernel(kernel_id,deltaPOne * slComInv,slCom,slComInv);
           }
 
           //TODO: Is fAB4 in this form ok?!
-          const double fAB =  SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv) * wDeltaPinv;
+          const double fAB = (cached ? kcW[kp] : kernel(kernel_id,s,slCom,slComInv)) * wDeltaPinv;
           const double fAB2 = fAB * fAB;
           fAB4 = fAB2 * fAB2;
         }
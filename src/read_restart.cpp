@@ -71,6 +71,7 @@
 #include "universe.h"
 #include "memory.h"
 #include "error.h"
+#include "restart_mpiio.h"
 
 using namespace LAMMPS_NS;
 
@@ -133,6 +134,9 @@ void ReadRestart::command(int narg, char **arg)
   if (strchr(file,'%')) multiproc = 1;
   else multiproc = 0;
 
+  int mpiio = 0;
+  if (!multiproc && RestartMPIIO::is_mpiio(file)) mpiio = 1;
+
   // open single restart file or base file for multiproc case
   // auto-detect whether byte swapping needs to be done as file is read
 
@@ -190,6 +194,11 @@ void ReadRestart::command(int narg, char **arg)
   atom->nextra_store = nextra;
   memory->create(atom->extra,n,nextra,"atom:extra");
 
+  // MPI-IO file:
+  // nprocs_file = # of chunks in file
+  // each proc reads only the chunks whose bounding box overlaps its
+  //   sub-domain and unpacks the atoms inside it, closes file when done
+
   // single file:
   // nprocs_file = # of chunks in file
   // proc 0 reads chunks one at a time and bcasts it to other procs
@@ -203,7 +212,12 @@ void ReadRestart::command(int narg, char **arg)
   double *buf = NULL;
   int m;
 
-  if (multiproc == 0) {
+  if (mpiio) {
+    if (swapflag)
+      error->all(FLERR,"MPI-IO restart files do not support byte swapping");
+    RestartMPIIO(lmp).read(fp,file,nprocs_file);
+
+  } else if (multiproc == 0) {
     int triclinic = domain->triclinic;
     double *x,lamda[3];
     double *coord,*sublo,*subhi;
@@ -107,6 +107,11 @@ E: Cannot open restart file %s
 
 Self-explanatory.
 
+E: MPI-IO restart files do not support byte swapping
+
+An MPI-IO restart file must be read on a machine with the same
+endianness as the one it was written on.
+
 E: Did not assign all atoms correctly
 
 Atoms read in from a data file were not assigned correctly to
@@ -68,6 +68,7 @@
 #include "comm.h"
 
 #define SMALL 1e-8
+#define MAXTRY_RANDOM 1000000
 
 using namespace LAMMPS_NS;
 
@@ -89,6 +90,7 @@ Region::Region(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   lastshape = lastdynamic = -1;
 
   random = NULL;
+  sampleflag = 0;
 
   volume_limit_ = 1.e-10;
 }
@@ -526,15 +528,76 @@ inline void Region::rand_bounds(bool subdomain_flag, double *lo, double *hi)
     
 }
 
+/* ----------------------------------------------------------------------
+   decide whether to sample region directly or by rejection in bbox
+   direct sampling accepts vol(region in subdomain)/vol(region) of the
+   points, rejection vol(region in subdomain)/vol(bbox in subdomain)
+------------------------------------------------------------------------- */
+
+int Region::use_direct_sampling(bool subdomain_flag)
+{
+    if(!sampleflag || !interior) return 0;
+    if(!subdomain_flag || dynamic || !bboxflag) return 1;
+
+    double vol_box = 1.;
+    double lo[3] = {extent_xlo,extent_ylo,extent_zlo};
+    double hi[3] = {extent_xhi,extent_yhi,extent_zhi};
+    for(int dim = 0; dim < 3; dim++)
+        vol_box *= std::max(0.,std::min(hi[dim],domain->subhi[dim]) - std::max(lo[dim],domain->sublo[dim]));
+
+    // empty overlap: let rand_bounds() report it
+    if(vol_box == 0.) return 0;
+
+    return volume() < vol_box;
+}
+
+/* ----------------------------------------------------------------------
+   uniform random point in region, accounting for shape and motion
+------------------------------------------------------------------------- */
+
+void Region::sample_direct(double *pos)
+{
+    if (varshape && update->ntimestep != lastshape) {
+      shape_update();
+      lastshape = update->ntimestep;
+    }
+    sample_uniform(pos);
+    if (dynamic) forward_transform(pos[0],pos[1],pos[2]);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Region::random_fail(const char *what)
+{
+    char str[512];
+    sprintf(str,"Region %s could not generate a random point %s within %d attempts",
+            id,what,MAXTRY_RANDOM);
+    error->one(FLERR,str);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Region::generate_random(double *pos,bool subdomain_flag)
 {
+    int ntry = 0;
+
+    if(use_direct_sampling(subdomain_flag))
+    {
+        do
+        {
+            if(ntry++ == MAXTRY_RANDOM) random_fail("inside the sub-domain");
+            sample_direct(pos);
+        }
+        while(subdomain_flag && !domain->is_in_subdomain(pos));
+        return;
+    }
+
     double lo[3],hi[3],diff[3];
     rand_bounds(subdomain_flag,lo,hi);
     vectorSubtract3D(hi,lo,diff);
     do
     {
+        if(ntry++ == MAXTRY_RANDOM) random_fail("inside the region");
         pos[0] = lo[0] + random->uniform()*diff[0];
         pos[1] = lo[1] + random->uniform()*diff[1];
         pos[2] = lo[2] + random->uniform()*diff[2];
@@ -549,7 +612,19 @@ void Region::generate_random(double *pos,bool subdomain_flag)
 // i.e. generate random point in region "shrunk" by cut
 void Region::generate_random_shrinkby_cut(double *pos,double cut,bool subdomain_flag)
 {
-    
+    int ntry = 0;
+
+    if(use_direct_sampling(subdomain_flag))
+    {
+        do
+        {
+            if(ntry++ == MAXTRY_RANDOM) random_fail("away from the region surface");
+            sample_direct(pos);
+        }
+        while((subdomain_flag && !domain->is_in_subdomain(pos)) || match_cut(pos,cut));
+        return;
+    }
+
     double lo[3],hi[3],diff[3];
     rand_bounds(subdomain_flag,lo,hi);
     vectorSubtract3D(hi,lo,diff);
@@ -562,6 +637,7 @@ void Region::generate_random_shrinkby_cut(double *pos,double cut,bool subdomain_
 
     do
     {
+        if(ntry++ == MAXTRY_RANDOM) random_fail("away from the region surface");
         pos[0] = lo[0] + random->uniform()*diff[0];
         pos[1] = lo[1] + random->uniform()*diff[1];
         pos[2] = lo[2] + random->uniform()*diff[2];
@@ -580,8 +656,10 @@ void Region::generate_random_expandby_cut(double *pos,double cut,bool subdomain_
     rand_bounds(subdomain_flag,lo,hi);
     vectorSubtract3D(hi,lo,diff);
 
+    int ntry = 0;
     do
     {
+        if(ntry++ == MAXTRY_RANDOM) random_fail("near the region");
         pos[0] = lo[0] + random->uniform()*diff[0];
         pos[1] = lo[1] + random->uniform()*diff[1];
         pos[2] = lo[2] + random->uniform()*diff[2];
@@ -636,8 +714,14 @@ void Region::volume_mc(int n_test,bool cutflag,double cut,double &vol_global,dou
     double pos[3],vol_bbox, vol_local_all;
     int n_in_local = 0, n_in_global = 0, n_in_global_all;
 
+    // regions that sample directly only draw points inside the region
+    // and know its exact volume, so only the fractions in the domain and
+    // in the sub-domain are estimated
+
+    int direct = sampleflag && interior;
+
     // impossible to calculate volume if bbox non-existent
-    if(!bboxflag)
+    if(!bboxflag && !direct)
     {
         vol_global = vol_local = 0.;
         error->all(FLERR,"Unable to calculate region volume. Region needs to have existing bounding box");
@@ -646,9 +730,13 @@ void Region::volume_mc(int n_test,bool cutflag,double cut,double &vol_global,dou
 
     for(int i = 0; i < n_test; i++)
     {
-        pos[0] = extent_xlo + random->uniform() * (extent_xhi - extent_xlo);
-        pos[1] = extent_ylo + random->uniform() * (extent_yhi - extent_ylo);
-        pos[2] = extent_zlo + random->uniform() * (extent_zhi - extent_zlo);
+        if(direct) sample_direct(pos);
+        else
+        {
+            pos[0] = extent_xlo + random->uniform() * (extent_xhi - extent_xlo);
+            pos[1] = extent_ylo + random->uniform() * (extent_yhi - extent_ylo);
+            pos[2] = extent_zlo + random->uniform() * (extent_zhi - extent_zlo);
+        }
 
         if(!domain->is_in_domain(pos)) continue;
 
@@ -657,7 +745,7 @@ void Region::volume_mc(int n_test,bool cutflag,double cut,double &vol_global,dou
         
         if(!cutflag)
         {
-            if(match(pos[0],pos[1],pos[2]))
+            if(direct || match(pos[0],pos[1],pos[2]))
             {
                 n_in_global++;
                 if(domain->is_in_subdomain(pos))
@@ -666,7 +754,7 @@ void Region::volume_mc(int n_test,bool cutflag,double cut,double &vol_global,dou
         }
         else
         {
-            if(match(pos[0],pos[1],pos[2]))
+            if(direct || match(pos[0],pos[1],pos[2]))
             {
                 n_in_global++;
                 if(domain->is_in_subdomain(pos) && !match_cut(pos,cut) )
@@ -682,10 +770,13 @@ void Region::volume_mc(int n_test,bool cutflag,double cut,double &vol_global,dou
                          "   (b) particles for insertion are too large when using all_in yes\n"
                          "   (c) region is 2d, but should be 3d");
 
-    vol_bbox = (extent_xhi - extent_xlo) * (extent_yhi - extent_ylo) * (extent_zhi - extent_zlo);
+    if(direct) vol_bbox = volume();
+    else vol_bbox = (extent_xhi - extent_xlo) * (extent_yhi - extent_ylo) * (extent_zhi - extent_zlo);
 
     // return calculated values
+    // exact volume if region is known to lie completely inside domain
     vol_global = static_cast<double>(n_in_global_all)/static_cast<double>(n_test*comm->nprocs) * vol_bbox;
+    if(direct && !dynamic && bboxflag && !bbox_extends_outside_box()) vol_global = vol_bbox;
     vol_local  = static_cast<double>(n_in_local )/static_cast<double>(n_test) * vol_bbox;
 
     MPI_Sum_Scalar(vol_local,vol_local_all,world);
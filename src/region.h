@@ -66,6 +66,7 @@ class Region : protected Pointers {
   double extent_ylo,extent_yhi;
   double extent_zlo,extent_zhi;
   int bboxflag;                     // 1 if bounding box is computable
+  int sampleflag;                   // 1 if region samples points directly
   int varshape;                     // 1 if region shape changes over time
 
   // contact = particle near region surface
@@ -117,6 +118,11 @@ class Region : protected Pointers {
   // volume calculation based on MC
   virtual void volume_mc(int n_test,bool cutflag,double cut,double &vol_global,double &vol_local);
 
+  // uniform random point inside the region shape and exact volume of it
+  // only implemented by regions that set sampleflag
+  virtual void sample_uniform(double *) {}
+  virtual double volume() { return 0.; }
+
   // flag if region bbox extends outside simulation domain
   virtual int bbox_extends_outside_box();
 
@@ -145,6 +151,10 @@ class Region : protected Pointers {
   double dx,dy,dz,theta;
   bigint lastshape,lastdynamic;
 
+  int use_direct_sampling(bool subdomain_flag);
+  void sample_direct(double *);
+  void random_fail(const char *);
+
   void forward_transform(double &, double &, double &);
   void inverse_transform(double &, double &, double &);
   void rotate(double &, double &, double &, const double);
@@ -182,6 +192,13 @@ E: Region cannot have 0 length rotation vector
 
 Self-explanatory.
 
+E: Region %s could not generate a random point within %d attempts
+
+Only a tiny fraction of the candidate points is inside the region,
+typically because the part of the region that lies in the processor's
+sub-domain is very small compared to its bounding box, or the region
+is too small to hold particles of the requested size.
+
 U: Use of region with undefined lattice
 
 If units = lattice (the default) for the region command, then a
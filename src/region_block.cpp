@@ -48,6 +48,7 @@
 #include "region_block.h"
 #include "domain.h"
 #include "error.h"
+#include "random_park.h"
 #include "force.h"
 
 // include last to ensure correct macros
@@ -126,6 +127,9 @@ RegBlock::RegBlock(LAMMPS *lmp, int narg, char **arg) : Region(lmp, narg, arg)
     extent_zhi = zhi;
   } else bboxflag = 0;
 
+  if (interior && xlo > -BIG && xhi < BIG && ylo > -BIG && yhi < BIG &&
+      zlo > -BIG && zhi < BIG) sampleflag = 1;
+
   // particle could be close to all 6 planes
 
   cmax = 6;
@@ -139,6 +143,24 @@ RegBlock::~RegBlock()
   delete [] contact;
 }
 
+/* ----------------------------------------------------------------------
+   uniform random point inside block
+------------------------------------------------------------------------- */
+
+void RegBlock::sample_uniform(double *pos)
+{
+  pos[0] = xlo + random->uniform()*(xhi-xlo);
+  pos[1] = ylo + random->uniform()*(yhi-ylo);
+  pos[2] = zlo + random->uniform()*(zhi-zlo);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double RegBlock::volume()
+{
+  return (xhi-xlo)*(yhi-ylo)*(zhi-zlo);
+}
+
 /* ----------------------------------------------------------------------
    inside = 1 if x,y,z is inside or on surface
    inside = 0 if x,y,z is outside and not on surface
@@ -65,6 +65,8 @@ class RegBlock : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void sample_uniform(double *);
+  double volume();
 
  private:
   double xlo,xhi,ylo,yhi,zlo,zhi;
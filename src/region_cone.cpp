@@ -53,6 +53,7 @@
 #include "region_cone.h"
 #include "domain.h"
 #include "error.h"
+#include "random_park.h"
 #include "force.h"
 
 // include last to ensure correct macros
@@ -178,6 +179,8 @@ RegCone::RegCone(LAMMPS *lmp, int narg, char **arg) :
     }
   } else bboxflag = 0;
 
+  if (interior && lo > -BIG && hi < BIG) sampleflag = 1;
+
   // particle could be contact cone surface and 2 ends
 
   cmax = 3;
@@ -191,6 +194,49 @@ RegCone::~RegCone()
   delete [] contact;
 }
 
+/* ----------------------------------------------------------------------
+   uniform random point inside cone
+   axial position from inverse of cumulative distribution ~ r(a)^3
+------------------------------------------------------------------------- */
+
+void RegCone::sample_uniform(double *pos)
+{
+  double t = random->uniform();
+  double dr = radiushi - radiuslo;
+  if (fabs(dr) > 1.e-6*maxradius) {
+    double rlo3 = radiuslo*radiuslo*radiuslo;
+    double rhi3 = radiushi*radiushi*radiushi;
+    t = (pow(rlo3 + t*(rhi3-rlo3),1./3.) - radiuslo) / dr;
+  }
+
+  double a = lo + t*(hi-lo);
+  double r = (radiuslo + t*dr)*sqrt(random->uniform());
+  double phi = 2.*M_PI*random->uniform();
+  double del1 = r*cos(phi);
+  double del2 = r*sin(phi);
+
+  if (axis == 'x') {
+    pos[0] = a;
+    pos[1] = c1 + del1;
+    pos[2] = c2 + del2;
+  } else if (axis == 'y') {
+    pos[0] = c1 + del1;
+    pos[1] = a;
+    pos[2] = c2 + del2;
+  } else {
+    pos[0] = c1 + del1;
+    pos[1] = c2 + del2;
+    pos[2] = a;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double RegCone::volume()
+{
+  return M_PI/3.*(hi-lo)*(radiuslo*radiuslo + radiuslo*radiushi + radiushi*radiushi);
+}
+
 /* ----------------------------------------------------------------------
    inside = 1 if x,y,z is inside or on surface
    inside = 0 if x,y,z is outside and not on surface
@@ -63,6 +63,8 @@ class RegCone : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void sample_uniform(double *);
+  double volume();
 
  private:
   char axis;
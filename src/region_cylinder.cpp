@@ -52,6 +52,7 @@
 #include "input.h"
 #include "variable.h"
 #include "error.h"
+#include "random_park.h"
 #include "force.h"
 
 // include last to ensure correct macros
@@ -183,6 +184,8 @@ RegCylinder::RegCylinder(LAMMPS *lmp, int narg, char **arg) :
     }
   } else bboxflag = 0;
 
+  if (interior && lo > -BIG && hi < BIG) sampleflag = 1;
+
   // particle could be contact cylinder surface and 2 ends
 
   cmax = 3;
@@ -205,6 +208,40 @@ void RegCylinder::init()
   if (rstr) variable_check();
 }
 
+/* ----------------------------------------------------------------------
+   uniform random point inside cylinder
+------------------------------------------------------------------------- */
+
+void RegCylinder::sample_uniform(double *pos)
+{
+  double a = lo + random->uniform()*(hi-lo);
+  double r = radius*sqrt(random->uniform());
+  double phi = 2.*M_PI*random->uniform();
+  double del1 = r*cos(phi);
+  double del2 = r*sin(phi);
+
+  if (axis == 'x') {
+    pos[0] = a;
+    pos[1] = c1 + del1;
+    pos[2] = c2 + del2;
+  } else if (axis == 'y') {
+    pos[0] = c1 + del1;
+    pos[1] = a;
+    pos[2] = c2 + del2;
+  } else {
+    pos[0] = c1 + del1;
+    pos[1] = c2 + del2;
+    pos[2] = a;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double RegCylinder::volume()
+{
+  return M_PI*radius*radius*(hi-lo);
+}
+
 /* ----------------------------------------------------------------------
    inside = 1 if x,y,z is inside or on surface
    inside = 0 if x,y,z is outside and not on surface
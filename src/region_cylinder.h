@@ -66,6 +66,8 @@ class RegCylinder : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void sample_uniform(double *);
+  double volume();
   void shape_update();
 
  private:
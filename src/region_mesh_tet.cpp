@@ -113,6 +113,9 @@ RegTetMesh::RegTetMesh(LAMMPS *lmp, int narg, char **arg) :
 
   volume = NULL;
   acc_volume = NULL;
+  nTetLocal = -1;
+  tetLocal = NULL;
+  acc_volume_local = NULL;
   nTet = 0;
   nTetMax = 0;
   total_volume = 0.;
@@ -153,6 +156,8 @@ RegTetMesh::~RegTetMesh()
   memory->destroy(center);
   memory->sfree(volume);
   memory->sfree(acc_volume);
+  memory->destroy(tetLocal);
+  memory->destroy(acc_volume_local);
 }
 
 /* ----------------------------------------------------------------------
@@ -211,17 +216,24 @@ void RegTetMesh::generate_random(double *pos,bool subdomain_flag)
 {
     if(!interior) error->all(FLERR,"Impossible to generate random points on tet mesh region with side = out");
 
+    if(!subdomain_flag)
+    {
+        mesh_randpos(pos);
+        return;
+    }
+
     int ntry = 0;
 
     do
     {
-        mesh_randpos(pos);
+        local_randpos(pos);
         ntry++;
     }
-    while(ntry < 10000 && (!subdomain_flag || !domain->is_in_subdomain(pos)));
+    while(ntry < 10000 && !domain->is_in_subdomain(pos));
 
     if(10000 == ntry)
-        error->one(FLERR,"internal error");
+        error->one(FLERR,"Impossible to generate random points on tet mesh region in this sub-domain, "
+                         "the tets overlapping the sub-domain lie almost completely outside of it");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -234,16 +246,11 @@ void RegTetMesh::generate_random_shrinkby_cut(double *pos,double cut,bool subdom
     bool is_near_surface = false;
     int barysign = -1;
 
-    for(int i = 0; i < nTet; i++)
-    {
-        
-    }
-
     do
     {
        ntry++;
        
-       int iTetChosen = mesh_randpos(pos);
+       int iTetChosen = subdomain_flag ? local_randpos(pos) : mesh_randpos(pos);
        is_near_surface = false;
        double delta[3];
 
@@ -299,11 +306,12 @@ void RegTetMesh::generate_random_shrinkby_cut(double *pos,double cut,bool subdom
        }
     }
     // pos has to be within region, and within cut of region surface
-    while(ntry < 10000 && (is_near_surface || (!subdomain_flag || !domain->is_in_subdomain(pos))));
+    while(ntry < 10000 && (is_near_surface || (subdomain_flag && !domain->is_in_subdomain(pos))));
 
     if(10000 == ntry)
     {
-        error->one(FLERR,"internal error");
+        error->one(FLERR,"Impossible to generate random points on tet mesh region away from its surface "
+                         "in this sub-domain, the region may be too small for the particles");
     }
 }
 
@@ -769,6 +777,76 @@ inline int RegTetMesh::mesh_randpos(double *pos)
 
 /* ---------------------------------------------------------------------- */
 
+/* ----------------------------------------------------------------------
+   collect tets whose bounding box overlaps my sub-domain
+   rebuilt whenever the sub-domain has changed
+------------------------------------------------------------------------- */
+
+void RegTetMesh::update_local_tets()
+{
+    if(nTetLocal >= 0 &&
+       sublo_local[0] == domain->sublo[0] && subhi_local[0] == domain->subhi[0] &&
+       sublo_local[1] == domain->sublo[1] && subhi_local[1] == domain->subhi[1] &&
+       sublo_local[2] == domain->sublo[2] && subhi_local[2] == domain->subhi[2])
+        return;
+
+    vectorCopy3D(domain->sublo,sublo_local);
+    vectorCopy3D(domain->subhi,subhi_local);
+
+    memory->destroy(tetLocal);
+    memory->destroy(acc_volume_local);
+    memory->create(tetLocal,nTet,"RegTetMesh:tetLocal");
+    memory->create(acc_volume_local,nTet,"RegTetMesh:acc_volume_local");
+
+    nTetLocal = 0;
+    double acc = 0.;
+
+    for(int iTet = 0; iTet < nTet; iTet++)
+    {
+        bool overlap = true;
+        for(int dim = 0; dim < 3; dim++)
+        {
+            double lo = node[iTet][0][dim], hi = node[iTet][0][dim];
+            for(int iNode = 1; iNode < 4; iNode++)
+            {
+                lo = std::min(lo,node[iTet][iNode][dim]);
+                hi = std::max(hi,node[iTet][iNode][dim]);
+            }
+            if(hi < sublo_local[dim] || lo >= subhi_local[dim])
+                overlap = false;
+        }
+        if(!overlap) continue;
+
+        acc += volume[iTet];
+        tetLocal[nTetLocal] = iTet;
+        acc_volume_local[nTetLocal] = acc;
+        nTetLocal++;
+    }
+}
+
+/* ----------------------------------------------------------------------
+   random point in a tet overlapping my sub-domain, tet chosen by volume
+------------------------------------------------------------------------- */
+
+int RegTetMesh::local_randpos(double *pos)
+{
+    update_local_tets();
+
+    if(nTetLocal == 0)
+        error->one(FLERR,"Impossible to generate random points on tet mesh region, "
+                         "no tet overlaps this sub-domain");
+
+    double rd = acc_volume_local[nTetLocal-1] * random->uniform();
+    int i = std::upper_bound(acc_volume_local,acc_volume_local+nTetLocal,rd) - acc_volume_local;
+    if(i == nTetLocal) i--;
+
+    int iTet = tetLocal[i];
+    tet_randpos(iTet,pos);
+    return iTet;
+}
+
+/* ---------------------------------------------------------------------- */
+
 inline int RegTetMesh::tet_rand_tri()
 {
     //SIMPLISTIC
@@ -97,6 +97,9 @@ class RegTetMesh : public Region {
    int mesh_randpos(double *pos);
    int  tet_rand_tri();
 
+   void update_local_tets();
+   int local_randpos(double *pos);
+
    char *filename;
    double scale_fact;
    double off_fact[3], rot_angle[3];
@@ -121,6 +124,12 @@ class RegTetMesh : public Region {
    double *volume;
    double *acc_volume;
 
+   // tets overlapping my sub-domain, accumulated volume of those
+   int nTetLocal;
+   int *tetLocal;
+   double *acc_volume_local;
+   double sublo_local[3],subhi_local[3];
+
    class BoundingBox &bounding_box_mesh;
 
    class RegionNeighborList<interpolate_no> &neighList;
@@ -54,6 +54,7 @@
 #include "domain.h"
 #include "force.h"
 #include "error.h"
+#include "random_park.h"
 
 // include last to ensure correct macros
 #include "domain_definitions.h"
@@ -149,6 +150,9 @@ RegPrism::RegPrism(LAMMPS *lmp, int narg, char **arg) : Region(lmp, narg, arg)
     extent_zhi = zhi;
   } else bboxflag = 0;
 
+  if (interior && xlo > -BIG && xhi < BIG && ylo > -BIG && yhi < BIG &&
+      zlo > -BIG && zhi < BIG) sampleflag = 1;
+
   // particle could contact all 6 planes
 
   cmax = 6;
@@ -260,6 +264,28 @@ RegPrism::~RegPrism()
   delete [] contact;
 }
 
+/* ----------------------------------------------------------------------
+   uniform random point inside prism, uniform in tilt coords
+------------------------------------------------------------------------- */
+
+void RegPrism::sample_uniform(double *pos)
+{
+  double a = random->uniform();
+  double b = random->uniform();
+  double c = random->uniform();
+
+  pos[0] = xlo + h[0][0]*a + h[0][1]*b + h[0][2]*c;
+  pos[1] = ylo + h[1][1]*b + h[1][2]*c;
+  pos[2] = zlo + h[2][2]*c;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double RegPrism::volume()
+{
+  return h[0][0]*h[1][1]*h[2][2];
+}
+
 /* ----------------------------------------------------------------------
    inside = 1 if x,y,z is inside or on surface
    inside = 0 if x,y,z is outside and not on surface
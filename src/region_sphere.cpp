@@ -51,6 +51,7 @@
 #include "input.h"
 #include "variable.h"
 #include "error.h"
+#include "random_park.h"
 #include "force.h"
 
 using namespace LAMMPS_NS;
@@ -100,6 +101,8 @@ RegSphere::RegSphere(LAMMPS *lmp, int narg, char **arg) :
     extent_zhi = zc + radius;
   } else bboxflag = 0;
 
+  if (interior) sampleflag = 1;
+
   cmax = 1;
   contact = new Contact[cmax];
 }
@@ -120,6 +123,30 @@ void RegSphere::init()
   if (rstr) variable_check();
 }
 
+/* ----------------------------------------------------------------------
+   uniform random point inside sphere
+   radius from inverse of cumulative r^3 distribution, uniform direction
+------------------------------------------------------------------------- */
+
+void RegSphere::sample_uniform(double *pos)
+{
+  double r = radius*pow(random->uniform(),1./3.);
+  double cost = 2.*random->uniform() - 1.;
+  double sint = sqrt(1.-cost*cost);
+  double phi = 2.*M_PI*random->uniform();
+
+  pos[0] = xc + r*sint*cos(phi);
+  pos[1] = yc + r*sint*sin(phi);
+  pos[2] = zc + r*cost;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double RegSphere::volume()
+{
+  return 4./3.*M_PI*radius*radius*radius;
+}
+
 /* ----------------------------------------------------------------------
    inside = 1 if x,y,z is inside or on surface
    inside = 0 if x,y,z is outside and not on surface
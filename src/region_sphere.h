@@ -64,6 +64,8 @@ class RegSphere : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void sample_uniform(double *);
+  double volume();
   void shape_update();
 
  private:
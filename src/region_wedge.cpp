@@ -43,6 +43,7 @@
 
 #include "region_wedge.h"
 #include "error.h"
+#include "random_park.h"
 #include "domain.h"
 #include <cmath>
 #include <stdlib.h>
@@ -289,6 +290,8 @@ RegWedge::RegWedge(LAMMPS *lmp, int narg, char **arg) : Region(lmp, narg, arg)
     }
   } else bboxflag = 0;
 
+  if (interior && lo > -BIG && hi < BIG) sampleflag = 1;
+
   // calculate normal vectors of the angular planes of the wedge
   double vec[2];
   // for angle1
@@ -318,6 +321,40 @@ RegWedge::~RegWedge(){
   delete [] contact;
 }
 
+/* -----------------------------------------------------------------------------
+   uniform random point inside wedge
+ -----------------------------------------------------------------------------*/
+
+void RegWedge::sample_uniform(double *pos)
+{
+  double a = lo + random->uniform()*(hi-lo);
+  double r = radius*sqrt(random->uniform());
+  double phi = angle1 + dang*random->uniform();
+  double del0 = r*cos(phi);
+  double del1 = r*sin(phi);
+
+  if (axis == 'x') {
+    pos[0] = a;
+    pos[1] = c1 + del0;
+    pos[2] = c2 + del1;
+  } else if (axis == 'y') {
+    pos[0] = c2 + del1;
+    pos[1] = a;
+    pos[2] = c1 + del0;
+  } else {
+    pos[0] = c1 + del0;
+    pos[1] = c2 + del1;
+    pos[2] = a;
+  }
+}
+
+/* ---------------------------------------------------------------------------*/
+
+double RegWedge::volume()
+{
+  return 0.5*dang*radius*radius*(hi-lo);
+}
+
 /* -----------------------------------------------------------------------------
  inside = 1 if x,y,z is inside or on surface
  inside = 0 if x,y,z is ouside and not on surface
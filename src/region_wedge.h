@@ -82,6 +82,8 @@ class RegWedge : public Region
     int inside(double,double,double);
     int surface_exterior(double *, double);
     int surface_interior(double *, double);
+    void sample_uniform(double *);
+    double volume();
 
   private:
 
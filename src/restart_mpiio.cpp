@@ -0,0 +1,270 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#include "lmptype.h"
+#include <mpi.h>
+#include <string.h>
+#include "restart_mpiio.h"
+#include "atom.h"
+#include "atom_vec.h"
+#include "domain.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+#define MPIIO_MAGIC 0x4d50494f
+#define BIG 1.0e20
+
+/* ---------------------------------------------------------------------- */
+
+RestartMPIIO::RestartMPIIO(LAMMPS *lmp) : Pointers(lmp)
+{
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool RestartMPIIO::is_mpiio(const char *file)
+{
+  const char *suffix = ".mpiio";
+  int n = strlen(file);
+  int ns = strlen(suffix);
+  return n > ns && strcmp(&file[n-ns],suffix) == 0;
+}
+
+/* ----------------------------------------------------------------------
+   bounding box of the atoms packed in buf, in lamda coords for triclinic
+   empty box (lo > hi) if buf holds no atoms
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::bounding_box(double *buf, int n, double *bbox)
+{
+  double lamda[3],*coord;
+
+  bbox[0] = bbox[1] = bbox[2] = BIG;
+  bbox[3] = bbox[4] = bbox[5] = -BIG;
+
+  int m = 0;
+  while (m < n) {
+    if (domain->triclinic) {
+      domain->x2lamda(&buf[m+1],lamda);
+      coord = lamda;
+    } else coord = &buf[m+1];
+
+    for (int d = 0; d < 3; d++) {
+      if (coord[d] < bbox[d]) bbox[d] = coord[d];
+      if (coord[d] > bbox[3+d]) bbox[3+d] = coord[d];
+    }
+    m += static_cast<int> (buf[m]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   called by all procs after proc 0 has written everything but the atoms
+   proc 0 appends the index and closes fp, then all procs write their
+   chunk of per-atom data collectively at their offset
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::write(FILE *fp, const char *file, double *buf, int send_size)
+{
+#ifdef MPI_STUBS
+  error->all(FLERR,"MPI-IO restart files require LIGGGHTS to be built with MPI");
+#else
+  double bbox[6];
+  bounding_box(buf,send_size,bbox);
+
+  int *sizes = NULL;
+  double *bboxes = NULL;
+  if (me == 0) {
+    memory->create(sizes,nprocs,"restart_mpiio:sizes");
+    memory->create(bboxes,6*nprocs,"restart_mpiio:bboxes");
+  }
+  MPI_Gather(&send_size,1,MPI_INT,sizes,1,MPI_INT,0,world);
+  MPI_Gather(bbox,6,MPI_DOUBLE,bboxes,6,MPI_DOUBLE,0,world);
+
+  bigint data_start = 0;
+  if (me == 0) {
+    int magic = MPIIO_MAGIC;
+    fwrite(&magic,sizeof(int),1,fp);
+    fwrite(&nprocs,sizeof(int),1,fp);
+    fwrite(sizes,sizeof(int),nprocs,fp);
+    fwrite(bboxes,sizeof(double),6*nprocs,fp);
+    data_start = ftell(fp);
+    fclose(fp);
+    memory->destroy(sizes);
+    memory->destroy(bboxes);
+  }
+  MPI_Bcast(&data_start,1,MPI_LMP_BIGINT,0,world);
+
+  // offset of my chunk = sum of chunk sizes of lower procs
+
+  bigint nmine = send_size, nupto;
+  MPI_Scan(&nmine,&nupto,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  MPI_Offset offset = data_start + (nupto-nmine)*sizeof(double);
+
+  MPI_File fh;
+  if (MPI_File_open(world,const_cast<char*>(file),MPI_MODE_WRONLY,
+                    MPI_INFO_NULL,&fh) != MPI_SUCCESS) {
+    char str[512];
+    sprintf(str,"Cannot open restart file %s",file);
+    error->all(FLERR,str);
+  }
+
+  MPI_Status status;
+  int flag = MPI_File_write_at_all(fh,offset,buf,send_size,MPI_DOUBLE,&status) != MPI_SUCCESS;
+  int flag_all;
+  MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_MAX,world);
+  MPI_File_close(&fh);
+
+  if (flag_all) error->all(FLERR,"Error writing MPI-IO restart file");
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   called by all procs after proc 0 has read everything but the atoms
+   proc 0 reads the index and closes fp, then each proc reads the chunks
+   overlapping its sub-domain and unpacks the atoms inside it
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::read(FILE *fp, const char *file, int nprocs_file)
+{
+#ifdef MPI_STUBS
+  error->all(FLERR,"MPI-IO restart files require LIGGGHTS to be built with MPI");
+#else
+  int header[2] = {0,0};
+  if (me == 0) fread(header,sizeof(int),2,fp);
+  MPI_Bcast(header,2,MPI_INT,0,world);
+  if (header[0] != MPIIO_MAGIC || header[1] != nprocs_file) {
+    char str[512];
+    sprintf(str,"Restart file %s is not an MPI-IO restart file",file);
+    error->all(FLERR,str);
+  }
+
+  int *sizes;
+  double *bboxes;
+  memory->create(sizes,nprocs_file,"restart_mpiio:sizes");
+  memory->create(bboxes,6*nprocs_file,"restart_mpiio:bboxes");
+
+  bigint data_start = 0;
+  if (me == 0) {
+    fread(sizes,sizeof(int),nprocs_file,fp);
+    fread(bboxes,sizeof(double),6*nprocs_file,fp);
+    data_start = ftell(fp);
+    fclose(fp);
+  }
+  MPI_Bcast(sizes,nprocs_file,MPI_INT,0,world);
+  MPI_Bcast(bboxes,6*nprocs_file,MPI_DOUBLE,0,world);
+  MPI_Bcast(&data_start,1,MPI_LMP_BIGINT,0,world);
+
+  int triclinic = domain->triclinic;
+  double *x,lamda[3];
+  double *coord,*sublo,*subhi;
+  if (triclinic == 0) {
+    sublo = domain->sublo;
+    subhi = domain->subhi;
+  } else {
+    sublo = domain->sublo_lamda;
+    subhi = domain->subhi_lamda;
+  }
+
+  MPI_File fh;
+  if (MPI_File_open(world,const_cast<char*>(file),MPI_MODE_RDONLY,
+                    MPI_INFO_NULL,&fh) != MPI_SUCCESS) {
+    char str[512];
+    sprintf(str,"Cannot open restart file %s",file);
+    error->all(FLERR,str);
+  }
+
+  AtomVec *avec = atom->avec;
+  int maxbuf = 0;
+  double *buf = NULL;
+  MPI_Status status;
+  MPI_Offset offset = data_start;
+
+  for (int ichunk = 0; ichunk < nprocs_file; ichunk++) {
+    int n = sizes[ichunk];
+    double *bbox = &bboxes[6*ichunk];
+
+    if (n > 0 &&
+        bbox[0] < subhi[0] && bbox[3] >= sublo[0] &&
+        bbox[1] < subhi[1] && bbox[4] >= sublo[1] &&
+        bbox[2] < subhi[2] && bbox[5] >= sublo[2]) {
+
+      if (n > maxbuf) {
+        maxbuf = n;
+        memory->destroy(buf);
+        memory->create(buf,maxbuf,"restart_mpiio:buf");
+      }
+
+      int nread = 0;
+      if (MPI_File_read_at(fh,offset,buf,n,MPI_DOUBLE,&status) == MPI_SUCCESS)
+        MPI_Get_count(&status,MPI_DOUBLE,&nread);
+      if (nread != n) error->one(FLERR,"Error reading MPI-IO restart file");
+
+      int m = 0;
+      while (m < n) {
+        x = &buf[m+1];
+        if (triclinic) {
+          domain->x2lamda(x,lamda);
+          coord = lamda;
+        } else coord = x;
+
+        if (coord[0] >= sublo[0] && coord[0] < subhi[0] &&
+            coord[1] >= sublo[1] && coord[1] < subhi[1] &&
+            coord[2] >= sublo[2] && coord[2] < subhi[2]) {
+          m += avec->unpack_restart(&buf[m]);
+        }
+        else m += static_cast<int> (buf[m]);
+      }
+    }
+
+    offset += static_cast<MPI_Offset>(n)*sizeof(double);
+  }
+
+  MPI_File_close(&fh);
+
+  memory->destroy(buf);
+  memory->destroy(sizes);
+  memory->destroy(bboxes);
+#endif
+}
@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if not contributing author is listed, this file has been contributed
+    by the core developer)
+
+    Copyright 2012-     DCS Computing GmbH, Linz
+    Copyright 2009-2012 JKU Linz
+------------------------------------------------------------------------- */
+
+#ifndef LMP_RESTART_MPIIO_H
+#define LMP_RESTART_MPIIO_H
+
+#include <stdio.h>
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+/* ----------------------------------------------------------------------
+   single-file parallel restart via MPI-IO, used if the restart file name
+   ends with ".mpiio"
+
+   file layout:
+     header, groups, type arrays, force field and fix info as in a
+       regular restart file, written by proc 0
+     index written by proc 0:
+       magic, # of chunks P, chunk sizes (P ints, # of doubles),
+       bounding box of the atoms of each chunk (6*P doubles, lamda
+       coords for triclinic boxes)
+     per-atom data of all chunks back to back, written collectively
+
+   on read, each proc only reads the chunks whose bounding box overlaps
+   its sub-domain and keeps the atoms inside it, so no proc reads the
+   whole file and no re-distribution of atoms is needed
+------------------------------------------------------------------------- */
+
+class RestartMPIIO : protected Pointers {
+ public:
+  RestartMPIIO(class LAMMPS *);
+
+  static bool is_mpiio(const char *file);
+
+  void write(FILE *fp, const char *file, double *buf, int send_size);
+  void read(FILE *fp, const char *file, int nprocs_file);
+
+ private:
+  int me,nprocs;
+
+  void bounding_box(double *buf, int n, double *bbox);
+};
+
+}
+
+#endif
+
+/* ERROR/WARNING messages:
+
+E: MPI-IO restart files require LIGGGHTS to be built with MPI
+
+The MPI stubs library does not provide MPI-IO.
+
+E: Cannot open restart file %s
+
+Self-explanatory.
+
+E: Restart file %s is not an MPI-IO restart file
+
+The index of the per-atom data was not found. The file was probably not
+written with a ".mpiio" file name.
+
+E: Error writing MPI-IO restart file
+
+A collective write of the per-atom data failed, e.g. because the file
+system ran out of space.
+
+E: Error reading MPI-IO restart file
+
+The per-atom data of a chunk could not be read completely.
+
+*/
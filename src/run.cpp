@@ -220,6 +220,7 @@ void Run::command(int narg, char **arg, bigint nsteps_input_ext)
     timer->init();
     timer->barrier_start(TIME_LOOP);
     update->integrate->run(nsteps);
+    output->wait_restart();
     timer->barrier_stop(TIME_LOOP);
 
     update->integrate->cleanup();
@@ -264,6 +265,7 @@ void Run::command(int narg, char **arg, bigint nsteps_input_ext)
       timer->init();
       timer->barrier_start(TIME_LOOP);
       update->integrate->run(nsteps);
+      output->wait_restart();
       timer->barrier_stop(TIME_LOOP);
 
       update->integrate->cleanup();
@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------
+    This is the
+
+    ██╗     ██╗ ██████╗  ██████╗  ██████╗ ██╗  ██╗████████╗███████╗
+    ██║     ██║██╔════╝ ██╔════╝ ██╔════╝ ██║  ██║╚══██╔══╝██╔════╝
+    ██║     ██║██║  ███╗██║  ███╗██║  ███╗███████║   ██║   ███████╗
+    ██║     ██║██║   ██║██║   ██║██║   ██║██╔══██║   ██║   ╚════██║
+    ███████╗██║╚██████╔╝╚██████╔╝╚██████╔╝██║  ██║   ██║   ███████║
+    ╚══════╝╚═╝ ╚═════╝  ╚═════╝  ╚═════╝ ╚═╝  ╚═╝   ╚═╝   ╚══════╝®
+
+    DEM simulation engine, released by
+    DCS Computing Gmbh, Linz, Austria
+    http://www.dcs-computing.com, office@dcs-computing.com
+
+    LIGGGHTS® is part of CFDEM®project:
+    http://www.liggghts.com | http://www.cfdem.com
+
+    Core developer and main author:
+    Christoph Kloss, christoph.kloss@dcs-computing.com
+
+    LIGGGHTS® is open-source, distributed under the terms of the GNU Public
+    License, version 2 or later. It is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. You should have
+    received a copy of the GNU General Public License along with LIGGGHTS®.
+    If not, see http://www.gnu.org/licenses . See also top-level README
+    and LICENSE files.
+
+    LIGGGHTS® and CFDEM® are registered trade marks of DCS Computing GmbH,
+    the producer of the LIGGGHTS® software and the CFDEM®coupling software
+    See http://www.cfdem.com/terms-trademark-policy for details.
+
+-------------------------------------------------------------------------
+    Contributing author and copyright for this file:
+    (if no contributing author is listed, this file has been contributed
+    by the core developer)
+
+------------------------------------------------------------------------- */
+
+#ifndef LMP_SPH_KERNEL_TABLE
+#define LMP_SPH_KERNEL_TABLE
+
+#include <cmath>
+#include <stdlib.h>
+#include "sph_kernels.h"
+
+namespace SPH_KERNEL_NS {
+
+/* ----------------------------------------------------------------------
+   lookup table for an sph kernel and its derivative
+   linear interpolation in the normalized distance s
+   the kernel must be of the form W(s,h) = hinv^dim * f(s)
+   (true for all kernels in sph_kernel_*.h), so one table serves all h
+------------------------------------------------------------------------- */
+
+class SPHKernelTable
+{
+  public:
+
+    SPHKernelTable() :
+      n_(0),
+      dim_(0),
+      dsInv_(0.),
+      W_(NULL),
+      dW_(NULL)
+    {}
+
+    ~SPHKernelTable()
+    {
+      delete [] W_;
+      delete [] dW_;
+    }
+
+    // tabulate kernel kernel_id with n intervals on [0,cut]
+    // returns false if the kernel does not scale like hinv^dim
+
+    bool build(int kernel_id,int n)
+    {
+      if (n < 1) return false;
+
+      // detect dimension from W(0,2h) = W(0,h) / 2^dim
+
+      const double w1 = sph_kernel(kernel_id,0.,1.,1.);
+      const double w2 = sph_kernel(kernel_id,0.,2.,0.5);
+      if (w1 <= 0. || w2 <= 0.) return false;
+      const int dim = static_cast<int>(log(w1/w2)/log(2.) + 0.5);
+      if (dim < 1 || dim > 3) return false;
+
+      // check the scaling assumption for kernel and derivative
+
+      const double cut = sph_kernel_cut(kernel_id);
+      const double s = 0.37*cut;
+      const double scale = pow(0.5,dim);
+      if (fabs(sph_kernel(kernel_id,s,2.,0.5) - scale*sph_kernel(kernel_id,s,1.,1.)) > 1e-10*fabs(w1) ||
+          fabs(sph_kernel_der(kernel_id,s,2.,0.5) - 0.5*scale*sph_kernel_der(kernel_id,s,1.,1.)) > 1e-10*fabs(w1))
+        return false;
+
+      delete [] W_;
+      delete [] dW_;
+
+      n_ = n;
+      dim_ = dim;
+      dsInv_ = n/cut;
+      W_ = new double[n+2];
+      dW_ = new double[n+2];
+
+      for (int k = 0; k <= n; k++)
+      {
+        const double sk = k/dsInv_;
+        W_[k] = sph_kernel(kernel_id,sk,1.,1.);
+        dW_[k] = sph_kernel_der(kernel_id,sk,1.,1.);
+      }
+      W_[n+1] = dW_[n+1] = 0.;
+
+      return true;
+    }
+
+    inline bool built() const
+    { return n_ > 0; }
+
+    // W and dW/ds for normalized distance s and inverse smoothing length hinv
+
+    inline void eval(double s,double hinv,double &W,double &dW) const
+    {
+      const double t = s*dsInv_;
+      const int k = static_cast<int>(t);
+
+      if (k >= n_)
+      {
+        W = dW = 0.;
+        return;
+      }
+
+      const double frac = t - k;
+
+      double hd = hinv;
+      if (dim_ > 1) hd *= hinv;
+      if (dim_ > 2) hd *= hinv;
+
+      W = hd * (W_[k] + frac*(W_[k+1]-W_[k]));
+      dW = hd*hinv * (dW_[k] + frac*(dW_[k+1]-dW_[k]));
+    }
+
+  private:
+
+    SPHKernelTable(const SPHKernelTable &);
+    SPHKernelTable &operator=(const SPHKernelTable &);
+
+    int n_;
+    int dim_;
+    double dsInv_;
+    double *W_;
+    double *dW_;
+};
+
+}
+
+#endif
@@ -48,6 +48,12 @@ namespace SPH_KERNEL_NS {
   inline double sph_kernel(int id,double s,double h,double hinv);
   inline double sph_kernel_der(int id,double s,double h,double hinv);
   inline double sph_kernel_cut(int id);
+
+  // compile-time specialisation of each kernel style by its id
+  template<int KERNEL_ID> struct SPHKernelSpec;
+
+  template<class K>
+  inline void sph_kernel_batch(int n,const double *s,const double *h,const double *hinv,double *W,double *dW);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -129,4 +135,41 @@ inline double SPH_KERNEL_NS::sph_kernel_cut(int id)
   return 0.;
 }
 
+/* ----------------------------------------------------------------------
+   kernel functors specialised by kernel id, to be used as template
+   parameter so the kernel can be inlined into the calling loop
+------------------------------------------------------------------------- */
+
+#define SPH_KERNEL_CLASS
+#define SPHKernel(kernel_id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+namespace SPH_KERNEL_NS { \
+  template<> struct SPHKernelSpec<kernel_id> \
+  { \
+    static inline double W(double s,double h,double hinv) \
+    { return SPHKernelCalculation(s,h,hinv); } \
+    static inline double der(double s,double h,double hinv) \
+    { return SPHKernelCalculationDer(s,h,hinv); } \
+    static inline double cut() \
+    { return SPHKernelCalculationCut(); } \
+  }; \
+}
+#include "style_sph_kernel.h"
+#undef SPH_KERNEL_CLASS
+#undef SPHKernel
+
+/* ----------------------------------------------------------------------
+   evaluate kernel and derivative for n contiguous (s,h,hinv) triples
+   no branches besides the ones in the kernel, so the loop vectorises
+------------------------------------------------------------------------- */
+
+template<class K>
+inline void SPH_KERNEL_NS::sph_kernel_batch(int n,const double *s,const double *h,const double *hinv,double *W,double *dW)
+{
+  for (int k = 0; k < n; k++)
+  {
+    W[k] = K::W(s[k],h[k],hinv[k]);
+    dW[k] = K::der(s[k],h[k],hinv[k]);
+  }
+}
+
 #endif
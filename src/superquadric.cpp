@@ -93,17 +93,7 @@ void Superquadric::set(double *center_, double *quat_, double *shape_, double *b
     shape_inv[1] = 1.0 / shape[1];
     shape_inv[2] = 1.0 / shape[2];
   }
-  isEllipsoid = MathExtraLiggghts::compDouble(blockiness[0], 2.0, 1e-2) and MathExtraLiggghts::compDouble(blockiness[1], 2.0, 1e-2);
-  isCylinder = !MathExtraLiggghts::compDouble(blockiness[0], 2.0, 1e-2) and MathExtraLiggghts::compDouble(blockiness[1], 2.0, 1e-2);
-
-  if(isEllipsoid)
-    useIntBlockiness = true;
-  else {
-    if(MathExtraLiggghtsNonspherical::isInteger(blockiness[0]) and MathExtraLiggghtsNonspherical::isInteger(blockiness[1]))
-      useIntBlockiness = true;
-    else
-      useIntBlockiness = false;
-  }
+  calc_blockiness_flags();
 }
 
 //value of the particle shape function at x in local reference frame
@@ -113,8 +103,6 @@ double Superquadric::shape_function_local(const double *input_coord)
   const double n2 = blockiness[1];
   double f;
   if(useIntBlockiness) {
-    const int n1_int = floor(blockiness[0] + 1e-2);
-    const int n2_int = floor(blockiness[1] + 1e-2);
     if(n1_int == n2_int) {
       f =  MathExtraLiggghtsNonspherical::pow_abs_int(input_coord[0]* shape_inv[0], n2_int) +
            MathExtraLiggghtsNonspherical::pow_abs_int(input_coord[1]* shape_inv[1], n2_int) +
@@ -152,8 +140,6 @@ void Superquadric::shape_function_gradient_local(const double *input_coord, doub
 
   double xan21, ybn21, zcn11;
   if(useIntBlockiness) {
-    const int n1_int = floor(n1 + 1e-2);
-    const int n2_int = floor(n2 + 1e-2);
     xan21 = MathExtraLiggghtsNonspherical::pow_abs_int(xa, n2_int - 1);
     ybn21 = MathExtraLiggghtsNonspherical::pow_abs_int(yb, n2_int - 1);
     zcn11 = MathExtraLiggghtsNonspherical::pow_abs_int(zc, n1_int - 1);
@@ -163,7 +149,7 @@ void Superquadric::shape_function_gradient_local(const double *input_coord, doub
     zcn11 = MathExtraLiggghtsNonspherical::pow_abs(zc, n1 - 1.0);
   }
 
-  if(MathExtraLiggghts::compDouble(n1, n2, 1e-2)) {
+  if(equalBlockiness) {
     result[0] = n1 * (koef * a) * MathExtraLiggghtsNonspherical::sign(xa) * xan21;
     result[1] = n1 * (koef * b) * MathExtraLiggghtsNonspherical::sign(yb) * ybn21;
     result[2] = n1 * (koef * c) * MathExtraLiggghtsNonspherical::sign(zc) * zcn11;
@@ -193,8 +179,6 @@ void Superquadric::shape_function_hessian_local(const double *input_coord, doubl
 //straightforward calculation of the 2nd derivatives
   double xan22, ybn22, zcn12;
   if(useIntBlockiness) {
-    const int n1_int = floor(n1 + 1e-2);
-    const int n2_int = floor(n2 + 1e-2);
     xan22 = MathExtraLiggghtsNonspherical::pow_abs_int(xa, n2_int - 2);
     ybn22 = MathExtraLiggghtsNonspherical::pow_abs_int(yb, n2_int - 2);
     zcn12 = MathExtraLiggghtsNonspherical::pow_abs_int(zc, n1_int - 2);
@@ -206,7 +190,7 @@ void Superquadric::shape_function_hessian_local(const double *input_coord, doubl
   const double xan21 = xan22 * fabs(xa);  // = MathExtraLiggghtsNonspherical::pow_abs(xa, n2 - 1.0)
   const double ybn21 = ybn22 * fabs(yb);  // = MathExtraLiggghtsNonspherical::pow_abs(yb, n2 - 1.0)
 
-  if(MathExtraLiggghts::compDouble(n1, n2, 1e-2)) { //MathExtraLiggghtsNonspherical::pow_abs(xy_term, n1/n2 - 1.0);
+  if(equalBlockiness) { //MathExtraLiggghtsNonspherical::pow_abs(xy_term, n1/n2 - 1.0);
     result[0] = (koef * a) * (n1 * (n2 - 1.0) * xan22) * a;
     result[4] = (koef * b) * (n1 * (n2 - 1.0) * ybn22) * b;
     result[8] = (koef * c) * (n1 * (n1 - 1.0) * zcn12) * c;
@@ -247,10 +231,27 @@ void Superquadric::shape_function_props_local(const double *input_coord, double
   const double yb = input_coord[1] * b;
   const double zc = input_coord[2] * c;
 
+  if(useIntBlockiness && equalBlockiness && n1_int == 2 && n2_int == 2) {
+    //ellipsoid fast path: same arithmetic as below with all exponents n - 2 = 0
+    const double xan21 = fabs(xa);
+    const double ybn21 = fabs(yb);
+    const double zcn11 = fabs(zc);
+    *f = koef * (xan21 * xan21 + ybn21 * ybn21 + zcn11 * zcn11 - 1.0);
+    grad[0] = koef * a * n1 * MathExtraLiggghtsNonspherical::sign(xa) * xan21;
+    grad[1] = koef * b * n1 * MathExtraLiggghtsNonspherical::sign(yb) * ybn21;
+    grad[2] = koef * c * n1 * MathExtraLiggghtsNonspherical::sign(zc) * zcn11;
+
+    if(hess != NULL) {
+      hess[0] = (koef * a) * (n1 * (n2 - 1.0)) * a;
+      hess[4] = (koef * b) * (n1 * (n2 - 1.0)) * b;
+      hess[8] = (koef * c) * (n1 * (n1 - 1.0)) * c;
+      hess[1] = hess[3] = hess[2] = hess[6] = hess[5] = hess[7] = 0.0;
+    }
+    return;
+  }
+
   double xan22, ybn22, zcn12;
   if(useIntBlockiness) {
-    const int n1_int = floor(n1 + 1e-2);
-    const int n2_int = floor(n2 + 1e-2);
     xan22 = MathExtraLiggghtsNonspherical::pow_abs_int(xa, n2_int - 2);
     ybn22 = MathExtraLiggghtsNonspherical::pow_abs_int(yb, n2_int - 2);
     zcn12 = MathExtraLiggghtsNonspherical::pow_abs_int(zc, n1_int - 2);
@@ -266,7 +267,7 @@ void Superquadric::shape_function_props_local(const double *input_coord, double
   const double ybn2 = ybn21 * fabs(yb);  // = MathExtraLiggghtsNonspherical::pow_abs(yb, n2)
   const double zcn1 = zcn11 * fabs(zc);  // = MathExtraLiggghtsNonspherical::pow_abs(zc, n1)
 
-  if(MathExtraLiggghts::compDouble(n1, n2, 1e-2)) { //MathExtraLiggghtsNonspherical::pow_abs(xy_term, n1/n2 - 1.0);
+  if(equalBlockiness) { //MathExtraLiggghtsNonspherical::pow_abs(xy_term, n1/n2 - 1.0);
     *f = koef * (xan2 + ybn2 + zcn1 - 1.0);
     grad[0] = koef * a * n1 * MathExtraLiggghtsNonspherical::sign(xa) * xan21;
     grad[1] = koef * b * n1 * MathExtraLiggghtsNonspherical::sign(yb) * ybn21;
@@ -686,8 +687,19 @@ void Superquadric::set_blockiness(double n1, double n2)
   blockiness[0] = n1;
   blockiness[1] = n2;
   calc_koef();
+  calc_blockiness_flags();
+}
+
+void Superquadric::calc_koef() {
+  koef = MathExtraLiggghtsNonspherical::pow_abs(0.5, std::max(blockiness[0], blockiness[1])-2.0);
+}
+
+//classify blockiness once, so the shape function evaluations do not have to
+void Superquadric::calc_blockiness_flags()
+{
   isEllipsoid = MathExtraLiggghts::compDouble(blockiness[0], 2.0, 1e-2) and MathExtraLiggghts::compDouble(blockiness[1], 2.0, 1e-2);
   isCylinder = !MathExtraLiggghts::compDouble(blockiness[0], 2.0, 1e-2) and MathExtraLiggghts::compDouble(blockiness[1], 2.0, 1e-2);
+
   if(isEllipsoid)
     useIntBlockiness = true;
   else {
@@ -696,10 +708,9 @@ void Superquadric::set_blockiness(double n1, double n2)
     else
       useIntBlockiness = false;
   }
-}
-
-void Superquadric::calc_koef() {
-  koef = MathExtraLiggghtsNonspherical::pow_abs(0.5, std::max(blockiness[0], blockiness[1])-2.0);
+  equalBlockiness = MathExtraLiggghts::compDouble(blockiness[0], blockiness[1], 1e-2);
+  n1_int = floor(blockiness[0] + 1e-2);
+  n2_int = floor(blockiness[1] + 1e-2);
 }
 
 //calculates the intersection point between a line and particle surface with the Newton's method
@@ -772,10 +783,13 @@ double Superquadric::surface_line_intersection(const int max_num_iters, bool use
       return alpha;
     }
 
+    bool grad_valid = false; //gradient at point known from the last accepted step
     for(int i = 0; i < max_num_iters; i++) {
        if(fabs(f0) < eps*koef)
          break;
-       shape_function_gradient_local(point, grad_local);
+       if(!grad_valid)
+         shape_function_gradient_local(point, grad_local);
+       grad_valid = false;
        f_der = LAMMPS_NS::vectorDot3D(grad_local, direction_vector_local);
 
        if(fabs(f_der)<1e-10) {
@@ -796,13 +810,15 @@ double Superquadric::surface_line_intersection(const int max_num_iters, bool use
        }
        else {
          while(fabs(delta) > eps) {
-           double point_[3];
+           double point_[3], grad_local_[3], f_;
            MathExtraLiggghtsNonspherical::yabx3D(point, delta, direction_vector_local, point_);
-           double f_ = shape_function_local(point_);
+           shape_function_props_local(point_, &f_, grad_local_, NULL); //value and gradient share the powers
            if(fabs(f_) < fabs(f0) or fabs(f_) < eps*koef) {
              f0 = f_;
              alpha += delta;
              LAMMPS_NS::vectorCopy3D(point_, point);
+             LAMMPS_NS::vectorCopy3D(grad_local_, grad_local);
+             grad_valid = true;
              break;
            } else
              delta *= 0.5;
@@ -59,6 +59,9 @@ struct Superquadric
   bool isEllipsoid;
   bool isCylinder;
   bool useIntBlockiness;
+  bool equalBlockiness; //n1 == n2 (within tolerance)
+  int n1_int; //integer blockiness, only valid if useIntBlockiness
+  int n2_int;
 
   void local2global(const double *input_coord, double *result);
   void global2local(const double *input_coord, double *result);
@@ -87,6 +90,7 @@ struct Superquadric
   void set_shape(double a, double b, double c);  //sets particle shape parameters
   void set_blockiness(double n1, double n2);  //sets particle blockiness parameters
   void calc_koef();
+  void calc_blockiness_flags();
 
   double surface_line_intersection(bool use_alhpa, const double *start_point, const double *normal_vector, double alpha1, double *result);  //calculates the intersection point between a line and particle surface with the Newton's method
   double surface_line_intersection(const int max_num_iters, bool use_alhpa, const double *start_point, const double *direction_vector, double alpha1, double *result);
@@ -105,6 +109,8 @@ struct Superquadric
     isEllipsoid = false;
     isCylinder = false;
     useIntBlockiness = false;
+    equalBlockiness = false;
+    n1_int = n2_int = 0;
     koef = 1.0;
   }
   Superquadric(double *center_, double *quat_, double *shape_, double *blockiness_);
@@ -51,6 +51,7 @@ SURFACE_MODEL(SURFACE_SUPERQUADRIC,superquadric,5)
 #include "contact_models.h"
 #include <cmath>
 #include <algorithm>
+#include <vector>
 #include "atom.h"
 #include "force.h"
 #include "update.h"
@@ -70,10 +71,14 @@ namespace ContactModels
     int reff_offset;
     Superquadric particle_i;
     Superquadric particle_j;
+    std::vector<Superquadric> particles_; // per-atom rotation matrix, inverse half axes etc, set up once per pass
+    std::vector<int> particles_pass_;     // pass in which an entry of particles_ was set up
+    int pass_;
     enum {SURFACES_FAR, SURFACES_CLOSE, SURFACES_INTERSECT};
   public:
     SurfaceModel(LAMMPS * lmp, IContactHistorySetup* hsetup,class ContactModelBase *cmb) :
-        SurfaceModelBase(lmp, hsetup, cmb)
+        SurfaceModelBase(lmp, hsetup, cmb),
+        pass_(0)
     {
       if(!atom->superquadric_flag)
         error->one(FLERR,"Applying surface model superquadric to a non-superquadric particle!");
@@ -126,8 +131,8 @@ namespace ContactModels
       if(std::isnan(vectorMag4D(atom->quaternion[jPart])))
         error->one(FLERR,"atom->quaternion[jPart] is NaN!");
 #endif
-      particle_i.set(atom->x[iPart], atom->quaternion[iPart], atom->shape[iPart], atom->blockiness[iPart]);
-      particle_j.set(atom->x[jPart], atom->quaternion[jPart], atom->shape[jPart], atom->blockiness[jPart]);
+      Superquadric * const sq_i = particle(iPart);
+      Superquadric * const sq_j = particle(jPart);
 
       unsigned int int_inequality_start = MathExtraLiggghtsNonspherical::round_int(*inequality_start);
 
@@ -135,18 +140,18 @@ namespace ContactModels
       if(*particles_were_in_contact == SURFACES_INTERSECT)
         obb_intersect = true; //particles had overlap on the previous time step, skipping OBB intersection check
       else
-        obb_intersect = MathExtraLiggghtsNonspherical::obb_intersect(&particle_i, &particle_j, int_inequality_start);
+        obb_intersect = MathExtraLiggghtsNonspherical::obb_intersect(sq_i, sq_j, int_inequality_start);
       if(obb_intersect) {//OBB intersect particles in possible contact
 
         double fi, fj;
-        const double ri = cbrt(particle_i.shape[0]*particle_i.shape[1]*particle_i.shape[2]);
-        const double rj = cbrt(particle_j.shape[0]*particle_j.shape[1]*particle_j.shape[2]);
+        const double ri = cbrt(sq_i->shape[0]*sq_i->shape[1]*sq_i->shape[2]);
+        const double rj = cbrt(sq_j->shape[0]*sq_j->shape[1]*sq_j->shape[2]);
         double ratio = ri / (ri + rj);
 
         if(*particles_were_in_contact == SURFACES_FAR)
-          calc_contact_point_if_no_previous_point_avaialable(sidata, &particle_i, &particle_j, sidata.contact_point, fi, fj, this->error);
+          calc_contact_point_if_no_previous_point_avaialable(sidata, sq_i, sq_j, sidata.contact_point, fi, fj, this->error);
         else
-          calc_contact_point_using_prev_step(sidata, &particle_i, &particle_j, ratio, update->dt, prev_step_point, sidata.contact_point, fi, fj, this->error);
+          calc_contact_point_using_prev_step(sidata, sq_i, sq_j, ratio, update->dt, prev_step_point, sidata.contact_point, fi, fj, this->error);
         vectorCopy3D(sidata.contact_point, prev_step_point); //store contact point in contact history for the next DEM time step
 
 #ifdef LIGGGHTS_DEBUG
@@ -157,20 +162,20 @@ namespace ContactModels
 
         if(particles_in_contact) {
           double contact_point_i[3], contact_point_j[3];
-          vectorSubtract3D(particle_j.gradient, particle_i.gradient, sidata.en);
+          vectorSubtract3D(sq_j->gradient, sq_i->gradient, sidata.en);
           vectorNormalize3D(sidata.en); //normalize
 
           double *const alpha_i = &sidata.contact_history[alpha1_offset];
           double *const alpha_j = &sidata.contact_history[alpha2_offset];
 
-          sidata.deltan = extended_overlap_algorithm(&particle_i, &particle_j, sidata.en, alpha_i, alpha_j,
+          sidata.deltan = extended_overlap_algorithm(sq_i, sq_j, sidata.en, alpha_i, alpha_j,
                 sidata.contact_point, contact_point_i, contact_point_j, sidata.delta);
 
           sidata.reff = sidata.radi*sidata.radj / (sidata.radi + sidata.radj);
           if(curvatureLimitFactor > 0.0) {
               int curvature_radius_method = meanCurvature ? 0 : 1;
-              double koefi = particle_i.calc_curvature_coefficient(curvature_radius_method, contact_point_i); //mean curvature coefficient
-              double koefj = particle_j.calc_curvature_coefficient(curvature_radius_method, contact_point_j); //mean curvature coefficient
+              double koefi = sq_i->calc_curvature_coefficient(curvature_radius_method, contact_point_i); //mean curvature coefficient
+              double koefj = sq_j->calc_curvature_coefficient(curvature_radius_method, contact_point_j); //mean curvature coefficient
 #ifdef LIGGGHTS_DEBUG
               if(std::isnan(koefi))
                 error->one(FLERR,"sidata.koefi is NaN!");
@@ -221,12 +226,30 @@ namespace ContactModels
 
     inline void endSurfacesIntersect(SurfacesIntersectData&,TriMesh *, double * const) {}
     inline void surfacesClose(SurfacesCloseData&, ForceData&, ForceData&){}
-    void beginPass(SurfacesIntersectData&, ForceData&, ForceData&){}
+    void beginPass(SurfacesIntersectData&, ForceData&, ForceData&)
+    {
+      // per-atom data is set up lazily, at most once per atom and pass
+      const size_t nall = atom->nlocal + atom->nghost;
+      if(particles_.size() < nall) {
+        particles_.resize(atom->nmax);
+        particles_pass_.resize(atom->nmax, -1);
+      }
+      pass_++;
+    }
     void endPass(SurfacesIntersectData&, ForceData&, ForceData&){}
     inline void tally_pp(double,int,int,int) {}
     inline void tally_pw(double,int,int,int) {}
 
   protected:
+    inline Superquadric * particle(int i)
+    {
+      if(particles_pass_[i] != pass_) {
+        particles_[i].set(atom->x[i], atom->quaternion[i], atom->shape[i], atom->blockiness[i]);
+        particles_pass_[i] = pass_;
+      }
+      return &particles_[i];
+    }
+
      double curvatureLimitFactor;
      bool meanCurvature;
      bool gaussianCurvature;
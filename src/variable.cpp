@@ -99,7 +99,8 @@ enum{DONE,ADD,SUBTRACT,MULTIPLY,DIVIDE,CARAT,MODULO,UNARY,
      SQRT,EXP,LN,LOG,ABS,SIN,COS,TAN,ASIN,ACOS,ATAN,ATAN2,
      RANDOM,NORMAL,CEIL,FLOOR,ROUND,RAMP,STAGGER,LOGFREQ,STRIDE,
      VDISPLACE,SWIGGLE,CWIGGLE,GMASK,RMASK,GRMASK,
-     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY};
+     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,
+     CSCALAR,CVECTOR,CARRAY,FSCALAR,FVECTOR,FARRAY,EQUALVAR};
 
 // customize by adding a special function
 
@@ -123,6 +124,18 @@ Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
   data = NULL;
 
   eval_in_progress = NULL;
+  eqcache = NULL;
+  eqcache_stamp = NULL;
+  generation = 0;
+  eval_dynamic = 0;
+  eqtree = NULL;
+  eqtree_stamp = NULL;
+  eval_notree = 0;
+  eval_compile = 0;
+
+  vlist = NULL;
+  vbuf = NULL;
+  maxvlist = nvbuf = 0;
 
   randomequal = NULL;
   randomatom = NULL;
@@ -147,6 +160,7 @@ Variable::~Variable()
   for (int i = 0; i < nvar; i++) {
     delete [] names[i];
     delete reader[i];
+    if (eqtree[i]) free_tree(eqtree[i]);
     if (style[i] == LOOP || style[i] == ULOOP) delete [] data[i][0];
     else for (int j = 0; j < num[i]; j++) delete [] data[i][j];
     delete [] data[i];
@@ -160,6 +174,13 @@ Variable::~Variable()
   memory->sfree(data);
 
   memory->destroy(eval_in_progress);
+  memory->destroy(eqcache);
+  memory->destroy(eqcache_stamp);
+  memory->sfree(eqtree);
+  memory->destroy(eqtree_stamp);
+
+  memory->destroy(vlist);
+  memory->destroy(vbuf);
 
   delete randomequal;
   delete randomatom;
@@ -173,6 +194,10 @@ void Variable::set(int narg, char **arg)
 {
   if (narg < 2) error->all(FLERR,"Illegal variable command");
 
+  // any change to a variable invalidates cached equal-style values
+
+  generation++;
+
   // DELETE
   // doesn't matter if variable no longer exists
 
@@ -480,6 +505,9 @@ int Variable::next(int narg, char **arg)
 
   // increment all variables in list
   // if any variable is exhausted, set flag = 1 and remove var to allow re-use
+  // new values invalidate cached equal-style values
+
+  generation++;
 
   int flag = 0;
 
@@ -599,7 +627,7 @@ char *Variable::retrieve(char *name)
     str = data[ivar][0];
   } else if (style[ivar] == EQUAL) {
     char result[64];
-    double answer = evaluate(data[ivar][0],NULL);
+    double answer = compute_equal(ivar);
     sprintf(result,"%.15g",answer);
     int n = strlen(result) + 1;
     if (data[ivar][1]) delete [] data[ivar][1];
@@ -628,9 +656,60 @@ double Variable::compute_equal(int ivar)
   // eval_in_progress used to detect circle dependencies
   // could extend this later to check v_a = c_b + v_a constructs?
 
+  // formulas that only depend on numbers, constants, time-independent
+  // math functions and other static variables are evaluated once,
+  // the cached value is valid until any variable is (re)defined or advanced
+  // eval_dynamic is set by evaluate() for anything else and is passed on
+  // to an enclosing evaluation, so it is not cached either
+
+  if (eqcache_stamp[ivar] == generation) return eqcache[ivar];
+
+  // dynamic formulas whose time-dependent items are all global compute
+  // or fix values or equal-style variables are parsed into a tree on
+  // their second evaluation, later evaluations only walk the tree
+  // eval_notree is set by evaluate() for all other time-dependent items
+
+  if (eqtree[ivar] && eqtree_stamp[ivar] == generation) {
+    eval_in_progress[ivar] = 1;
+    double value = eval_tree(eqtree[ivar],0);
+    eval_in_progress[ivar] = 0;
+    eval_dynamic = 1;
+    return value;
+  }
+
+  int dynamic_outer = eval_dynamic;
+  int notree_outer = eval_notree;
+  int compile_outer = eval_compile;
+  eval_dynamic = eval_notree = eval_compile = 0;
+
+  double value;
   eval_in_progress[ivar] = 1;
-  double value = evaluate(data[ivar][0],NULL);
+
+  if (eqtree_stamp[ivar] == generation) {
+    Tree *tree;
+    eval_compile = 1;
+    evaluate(data[ivar][0],&tree);
+    eval_compile = 0;
+    collapse_tree(tree);
+    eqtree[ivar] = tree;
+    value = eval_tree(tree,0);
+    eval_dynamic = 1;
+  } else {
+    value = evaluate(data[ivar][0],NULL);
+    if (eqtree[ivar]) free_tree(eqtree[ivar]);
+    eqtree[ivar] = NULL;
+    eqtree_stamp[ivar] = (eval_dynamic && !eval_notree) ? generation : -1;
+  }
+
   eval_in_progress[ivar] = 0;
+
+  if (!eval_dynamic) {
+    eqcache[ivar] = value;
+    eqcache_stamp[ivar] = generation;
+  }
+  eval_dynamic |= dynamic_outer;
+  eval_notree = notree_outer;
+  eval_compile = compile_outer;
   return value;
 }
 
@@ -667,18 +746,44 @@ void Variable::compute_atom(int ivar, int igroup,
   int nlocal = atom->nlocal;
 
   if (style[ivar] == ATOM) {
+
+    // evaluate tree for all atoms in group at once into vbuf[0]
+    // vbuf[1..depth] hold operands of the tree nodes
+    // trees with random numbers are evaluated atom by atom in order
+
+    int depth = tree_depth(tree);
+    if (nlocal > maxvlist || depth+1 > nvbuf) {
+      maxvlist = MAX(maxvlist,MAX(nlocal,1));
+      nvbuf = MAX(nvbuf,depth+1);
+      memory->destroy(vlist);
+      memory->destroy(vbuf);
+      memory->create(vlist,maxvlist,"var:vlist");
+      memory->create(vbuf,nvbuf,maxvlist,"var:vbuf");
+    }
+
+    int n = 0;
+    for (int i = 0; i < nlocal; i++)
+      if (mask[i] & groupbit) vlist[n++] = i;
+
+    double *values = vbuf[0];
+    if (tree_has_random(tree))
+      for (int k = 0; k < n; k++) values[k] = eval_tree(tree,vlist[k]);
+    else eval_tree_vector(tree,n,vlist,values,1);
+
     if (sumflag == 0) {
       int m = 0;
+      int k = 0;
       for (int i = 0; i < nlocal; i++) {
-        if (mask[i] & groupbit) result[m] = eval_tree(tree,i);
+        if (mask[i] & groupbit) result[m] = values[k++];
         else result[m] = 0.0;
         m += stride;
       }
 
     } else {
       int m = 0;
+      int k = 0;
       for (int i = 0; i < nlocal; i++) {
-        if (mask[i] & groupbit) result[m] += eval_tree(tree,i);
+        if (mask[i] & groupbit) result[m] += values[k++];
         m += stride;
       }
     }
@@ -748,6 +853,7 @@ void Variable::remove(int n)
   else for (int i = 0; i < num[n]; i++) delete [] data[n][i];
   delete [] data[n];
   delete reader[n];
+  if (eqtree[n]) free_tree(eqtree[n]);
 
   for (int i = n+1; i < nvar; i++) {
     names[i-1] = names[i];
@@ -757,8 +863,13 @@ void Variable::remove(int n)
     pad[i-1] = pad[i];
     reader[i-1] = reader[i];
     data[i-1] = data[i];
+    eqcache[i-1] = eqcache[i];
+    eqcache_stamp[i-1] = eqcache_stamp[i];
+    eqtree[i-1] = eqtree[i];
+    eqtree_stamp[i-1] = eqtree_stamp[i];
   }
   nvar--;
+  generation++;
 }
 
 /* ----------------------------------------------------------------------
@@ -783,6 +894,17 @@ void Variable::grow()
 
   memory->grow(eval_in_progress,maxvar,"var:eval_in_progress");
   for (int i = 0; i < maxvar; i++) eval_in_progress[i] = 0;
+
+  memory->grow(eqcache,maxvar,"var:eqcache");
+  memory->grow(eqcache_stamp,maxvar,"var:eqcache_stamp");
+  for (int i = old; i < maxvar; i++) eqcache_stamp[i] = -1;
+
+  eqtree = (Tree **) memory->srealloc(eqtree,maxvar*sizeof(Tree *),"var:eqtree");
+  memory->grow(eqtree_stamp,maxvar,"var:eqtree_stamp");
+  for (int i = old; i < maxvar; i++) {
+    eqtree[i] = NULL;
+    eqtree_stamp[i] = -1;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -932,6 +1054,7 @@ double Variable::evaluate(char *str, Tree **tree)
         if (domain->box_exist == 0)
           error->all(FLERR,
                      "Variable evaluation before simulation box is defined");
+        eval_dynamic = 1;
 
         n = strlen(word) - 2 + 1;
         char *id = new char[n];
@@ -964,80 +1087,28 @@ double Variable::evaluate(char *str, Tree **tree)
         }
 
         // c_ID = scalar from global scalar
-
-        if (nbracket == 0 && compute->scalar_flag) {
-
-          if (update->whichflag == 0) {
-            if (compute->invoked_scalar != update->ntimestep)
-              error->all(FLERR,"Compute used in variable between runs "
-                         "is not current. Use the update_on_run_end option for computes to avoid this.");
-          } else if (!(compute->invoked_flag & INVOKED_SCALAR)) {
-            compute->compute_scalar();
-            compute->invoked_flag |= INVOKED_SCALAR;
-          }
-
-          value1 = compute->scalar;
-          if (tree) {
-            Tree *newtree = new Tree();
-            newtree->type = VALUE;
-            newtree->value = value1;
-            newtree->left = newtree->middle = newtree->right = NULL;
-            treestack[ntreestack++] = newtree;
-          } else argstack[nargstack++] = value1;
-
         // c_ID[i] = scalar from global vector
-
-        } else if (nbracket == 1 && compute->vector_flag) {
-
-          if (index1 > compute->size_vector)
-            error->all(FLERR,"Variable formula compute vector "
-                       "is accessed out-of-range");
-          if (update->whichflag == 0) {
-            if (compute->invoked_vector != update->ntimestep)
-              error->all(FLERR,"Compute used in variable between runs "
-                         "is not current. Use the update_on_run_end option for computes to avoid this.");
-          } else if (!(compute->invoked_flag & INVOKED_VECTOR)) {
-            compute->compute_vector();
-            compute->invoked_flag |= INVOKED_VECTOR;
-          }
-
-          value1 = compute->vector[index1-1];
-          if (tree) {
-            Tree *newtree = new Tree();
-            newtree->type = VALUE;
-            newtree->value = value1;
-            newtree->left = newtree->middle = newtree->right = NULL;
-            treestack[ntreestack++] = newtree;
-          } else argstack[nargstack++] = value1;
-
         // c_ID[i][j] = scalar from global array
 
-        } else if (nbracket == 2 && compute->array_flag) {
-
-          if (index1 > compute->size_array_rows)
-            error->all(FLERR,"Variable formula compute array "
-                       "is accessed out-of-range");
-          if (index2 > compute->size_array_cols)
-            error->all(FLERR,"Variable formula compute array "
-                       "is accessed out-of-range");
-          if (update->whichflag == 0) {
-            if (compute->invoked_array != update->ntimestep)
-              error->all(FLERR,"Compute used in variable between runs "
-                         "is not current. Use the update_on_run_end option for computes to avoid this.");
-          } else if (!(compute->invoked_flag & INVOKED_ARRAY)) {
-            compute->compute_array();
-            compute->invoked_flag |= INVOKED_ARRAY;
+        if ((nbracket == 0 && compute->scalar_flag) ||
+            (nbracket == 1 && compute->vector_flag) ||
+            (nbracket == 2 && compute->array_flag)) {
+
+          if (tree && eval_compile)
+            tree_leaf(CSCALAR+nbracket,compute->id,icompute,
+                      nbracket > 0 ? index1 : 0,nbracket > 1 ? index2 : 0,
+                      treestack,ntreestack);
+          else {
+            value1 = compute_global(compute,nbracket,index1,index2);
+            if (tree) {
+              Tree *newtree = new Tree();
+              newtree->type = VALUE;
+              newtree->value = value1;
+              newtree->left = newtree->middle = newtree->right = NULL;
+              treestack[ntreestack++] = newtree;
+            } else argstack[nargstack++] = value1;
           }
 
-          value1 = compute->array[index1-1][index2-1];
-          if (tree) {
-            Tree *newtree = new Tree();
-            newtree->type = VALUE;
-            newtree->value = value1;
-            newtree->left = newtree->middle = newtree->right = NULL;
-            treestack[ntreestack++] = newtree;
-          } else argstack[nargstack++] = value1;
-
         // c_ID[i] = scalar from per-atom vector
 
         } else if (nbracket == 1 && compute->peratom_flag &&
@@ -1147,6 +1218,7 @@ double Variable::evaluate(char *str, Tree **tree)
         if (domain->box_exist == 0)
           error->all(FLERR,
                      "Variable evaluation before simulation box is defined");
+        eval_dynamic = 1;
 
         n = strlen(word) - 2 + 1;
         char *id = new char[n];
@@ -1178,61 +1250,27 @@ double Variable::evaluate(char *str, Tree **tree)
         }
 
         // f_ID = scalar from global scalar
-
-        if (nbracket == 0 && fix->scalar_flag) {
-
-          if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
-            error->all(FLERR,"Fix in variable not computed at compatible time");
-
-          value1 = fix->compute_scalar();
-          if (tree) {
-            Tree *newtree = new Tree();
-            newtree->type = VALUE;
-            newtree->value = value1;
-            newtree->left = newtree->middle = newtree->right = NULL;
-            treestack[ntreestack++] = newtree;
-          } else argstack[nargstack++] = value1;
-
         // f_ID[i] = scalar from global vector
-
-        } else if (nbracket == 1 && fix->vector_flag) {
-
-          if (index1 > fix->size_vector)
-            error->all(FLERR,
-                       "Variable formula fix vector is accessed out-of-range");
-          if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
-            error->all(FLERR,"Fix in variable not computed at compatible time");
-
-          value1 = fix->compute_vector(index1-1);
-          if (tree) {
-            Tree *newtree = new Tree();
-            newtree->type = VALUE;
-            newtree->value = value1;
-            newtree->left = newtree->middle = newtree->right = NULL;
-            treestack[ntreestack++] = newtree;
-          } else argstack[nargstack++] = value1;
-
         // f_ID[i][j] = scalar from global array
 
-        } else if (nbracket == 2 && fix->array_flag) {
-
-          if (index1 > fix->size_array_rows)
-            error->all(FLERR,
-                       "Variable formula fix array is accessed out-of-range");
-          if (index2 > fix->size_array_cols)
-            error->all(FLERR,
-                       "Variable formula fix array is accessed out-of-range");
-          if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
-            error->all(FLERR,"Fix in variable not computed at compatible time");
-
-          value1 = fix->compute_array(index1-1,index2-1);
-          if (tree) {
-            Tree *newtree = new Tree();
-            newtree->type = VALUE;
-            newtree->value = value1;
-            newtree->left = newtree->middle = newtree->right = NULL;
-            treestack[ntreestack++] = newtree;
-          } else argstack[nargstack++] = value1;
+        if ((nbracket == 0 && fix->scalar_flag) ||
+            (nbracket == 1 && fix->vector_flag) ||
+            (nbracket == 2 && fix->array_flag)) {
+
+          if (tree && eval_compile)
+            tree_leaf(FSCALAR+nbracket,fix->id,ifix,
+                      nbracket > 0 ? index1 : 0,nbracket > 1 ? index2 : 0,
+                      treestack,ntreestack);
+          else {
+            value1 = fix_global(fix,nbracket,index1,index2);
+            if (tree) {
+              Tree *newtree = new Tree();
+              newtree->type = VALUE;
+              newtree->value = value1;
+              newtree->left = newtree->middle = newtree->right = NULL;
+              treestack[ntreestack++] = newtree;
+            } else argstack[nargstack++] = value1;
+          }
 
         // f_ID[i] = scalar from per-atom vector
 
@@ -1345,8 +1383,13 @@ double Variable::evaluate(char *str, Tree **tree)
 
         // v_name = scalar from non atom/atomfile variable
 
-        if (nbracket == 0 && style[ivar] != ATOM && style[ivar] != ATOMFILE) {
+        if (nbracket == 0 && style[ivar] == EQUAL && tree && eval_compile) {
+
+          tree_leaf(EQUALVAR,NULL,ivar,0,0,treestack,ntreestack);
+
+        } else if (nbracket == 0 && style[ivar] != ATOM && style[ivar] != ATOMFILE) {
 
+          if (style[ivar] == GETENV) eval_dynamic = eval_notree = 1;
           char *var = retrieve(id);
           if (var == NULL)
             error->all(FLERR,"Invalid variable evaluation in variable formula");
@@ -1363,6 +1406,7 @@ double Variable::evaluate(char *str, Tree **tree)
 
         } else if (nbracket == 0 && style[ivar] == ATOM) {
 
+          eval_dynamic = eval_notree = 1;
           if (tree == NULL)
             error->all(FLERR,
                        "Atom-style variable in equal-style variable formula");
@@ -1391,6 +1435,7 @@ double Variable::evaluate(char *str, Tree **tree)
 
         } else if (nbracket && style[ivar] == ATOM) {
 
+          eval_dynamic = eval_notree = 1;
           double *result;
           memory->create(result,atom->nlocal,"variable:result");
           compute_atom(ivar,0,result,1,0);
@@ -1402,6 +1447,7 @@ double Variable::evaluate(char *str, Tree **tree)
 
         } else if (nbracket && style[ivar] == ATOMFILE) {
 
+          eval_dynamic = eval_notree = 1;
           peratom2global(1,NULL,reader[ivar]->fix->vstore,1,index,
                          tree,treestack,ntreestack,argstack,nargstack);
 
@@ -1425,6 +1471,7 @@ double Variable::evaluate(char *str, Tree **tree)
           i = find_matching_paren(str,i,contents);
           i++;
 
+          if (!static_math_function(word)) eval_dynamic = eval_notree = 1;
           if (math_function(word,contents,tree,
                             treestack,ntreestack,argstack,nargstack));
           else if (group_function(word,contents,tree,
@@ -1448,6 +1495,7 @@ double Variable::evaluate(char *str, Tree **tree)
           int id = int_between_brackets(ptr);
           i = ptr-str+1;
 
+          eval_dynamic = eval_notree = 1;
           peratom2global(0,word,NULL,0,id,
                          tree,treestack,ntreestack,argstack,nargstack);
 
@@ -1460,6 +1508,7 @@ double Variable::evaluate(char *str, Tree **tree)
             error->all(FLERR,
                        "Variable evaluation before simulation box is defined");
 
+          eval_dynamic = eval_notree = 1;
           atom_vector(word,tree,treestack,ntreestack);
 
         // ----------------
@@ -1485,6 +1534,7 @@ double Variable::evaluate(char *str, Tree **tree)
             error->all(FLERR,
                        "Variable evaluation before simulation box is defined");
 
+          eval_dynamic = eval_notree = 1;
           int flag = output->thermo->evaluate_keyword(word,&value1);
           if (flag) {
             fprintf(screen, "word = %s\n", word);
@@ -2135,6 +2185,7 @@ double Variable::eval_tree(Tree *tree, int i)
   if (tree->type == ATOMARRAY) return tree->array[i*tree->nstride];
   if (tree->type == TYPEARRAY) return tree->array[atom->type[i]];
   if (tree->type == INTARRAY) return (double) tree->iarray[i*tree->nstride];
+  if (tree->type >= CSCALAR) return eval_leaf(tree);
 
   if (tree->type == ADD)
     return eval_tree(tree->left,i) + eval_tree(tree->right,i);
@@ -2391,6 +2442,422 @@ double Variable::eval_tree(Tree *tree, int i)
   return 0.0;
 }
 
+/* ----------------------------------------------------------------------
+   evaluate an atom-style variable parse tree for N atoms in ilist at once
+   result[k] = value for atom ilist[k]
+   each node is one loop over all atoms instead of one recursive call
+     per atom and node, operands are held in vbuf[level]
+   nodes that depend on the timestep or need short-circuit evaluation of
+     a subtree that can fail are evaluated per atom via eval_tree()
+   caller ensures tree has no random() or normal() and that vbuf
+     has at least depth(tree)+1 rows of length N
+------------------------------------------------------------------------- */
+
+void Variable::eval_tree_vector(Tree *tree, int n, int *ilist,
+                                double *result, int level)
+{
+  int k;
+  double arg1;
+  double *right = vbuf[level];
+  int type = tree->type;
+
+  if (type == VALUE) {
+    for (k = 0; k < n; k++) result[k] = tree->value;
+    return;
+  }
+  if (type == ATOMARRAY) {
+    double *array = tree->array;
+    int nstride = tree->nstride;
+    for (k = 0; k < n; k++) result[k] = array[ilist[k]*nstride];
+    return;
+  }
+  if (type == TYPEARRAY) {
+    double *array = tree->array;
+    int *atype = atom->type;
+    for (k = 0; k < n; k++) result[k] = array[atype[ilist[k]]];
+    return;
+  }
+  if (type == INTARRAY) {
+    int *iarray = tree->iarray;
+    int nstride = tree->nstride;
+    for (k = 0; k < n; k++) result[k] = (double) iarray[ilist[k]*nstride];
+    return;
+  }
+
+  if (type == GMASK || type == RMASK || type == GRMASK) {
+    int *mask = atom->mask;
+    double **x = atom->x;
+    int i;
+    for (k = 0; k < n; k++) {
+      i = ilist[k];
+      if (type == GMASK) result[k] = (mask[i] & tree->ivalue1) ? 1.0 : 0.0;
+      else if (type == RMASK)
+        result[k] = domain->regions[tree->ivalue1]->
+          match(x[i][0],x[i][1],x[i][2]) ? 1.0 : 0.0;
+      else
+        result[k] = ((mask[i] & tree->ivalue1) &&
+                     domain->regions[tree->ivalue2]->
+                     match(x[i][0],x[i][1],x[i][2])) ? 1.0 : 0.0;
+    }
+    return;
+  }
+
+  // binary operators and atan2()
+
+  if (type == ADD || type == SUBTRACT || type == MULTIPLY ||
+      type == DIVIDE || type == MODULO || type == CARAT ||
+      type == EQ || type == NE || type == LT || type == LE ||
+      type == GT || type == GE || type == ATAN2 ||
+      ((type == AND || type == OR) && !tree_can_fail(tree->right))) {
+    eval_tree_vector(tree->left,n,ilist,result,level);
+    eval_tree_vector(tree->right,n,ilist,right,level+1);
+
+    switch (type) {
+    case ADD:
+      for (k = 0; k < n; k++) result[k] += right[k];
+      break;
+    case SUBTRACT:
+      for (k = 0; k < n; k++) result[k] -= right[k];
+      break;
+    case MULTIPLY:
+      for (k = 0; k < n; k++) result[k] *= right[k];
+      break;
+    case DIVIDE:
+      for (k = 0; k < n; k++) {
+        if (right[k] == 0.0)
+          error->one(FLERR,"Divide by 0 in variable formula");
+        result[k] /= right[k];
+      }
+      break;
+    case MODULO:
+      for (k = 0; k < n; k++) {
+        if (right[k] == 0.0)
+          error->one(FLERR,"Modulo 0 in variable formula");
+        result[k] = fmod(result[k],right[k]);
+      }
+      break;
+    case CARAT:
+      for (k = 0; k < n; k++) {
+        if (right[k] == 0.0)
+          error->one(FLERR,"Power by 0 in variable formula");
+        result[k] = pow(result[k],right[k]);
+      }
+      break;
+    case EQ:
+      for (k = 0; k < n; k++) result[k] = (result[k] == right[k]) ? 1.0 : 0.0;
+      break;
+    case NE:
+      for (k = 0; k < n; k++) result[k] = (result[k] != right[k]) ? 1.0 : 0.0;
+      break;
+    case LT:
+      for (k = 0; k < n; k++) result[k] = (result[k] < right[k]) ? 1.0 : 0.0;
+      break;
+    case LE:
+      for (k = 0; k < n; k++) result[k] = (result[k] <= right[k]) ? 1.0 : 0.0;
+      break;
+    case GT:
+      for (k = 0; k < n; k++) result[k] = (result[k] > right[k]) ? 1.0 : 0.0;
+      break;
+    case GE:
+      for (k = 0; k < n; k++) result[k] = (result[k] >= right[k]) ? 1.0 : 0.0;
+      break;
+    case AND:
+      for (k = 0; k < n; k++)
+        result[k] = (result[k] != 0.0 && right[k] != 0.0) ? 1.0 : 0.0;
+      break;
+    case OR:
+      for (k = 0; k < n; k++)
+        result[k] = (result[k] != 0.0 || right[k] != 0.0) ? 1.0 : 0.0;
+      break;
+    case ATAN2:
+      for (k = 0; k < n; k++) result[k] = atan2(result[k],right[k]);
+      break;
+    }
+    return;
+  }
+
+  // unary operators and single-argument math functions
+
+  if (type == UNARY || type == NOT || type == SQRT || type == EXP ||
+      type == LN || type == LOG || type == ABS || type == SIN ||
+      type == COS || type == TAN || type == ASIN || type == ACOS ||
+      type == ATAN || type == CEIL || type == FLOOR || type == ROUND) {
+    eval_tree_vector(tree->left,n,ilist,result,level);
+
+    switch (type) {
+    case UNARY:
+      for (k = 0; k < n; k++) result[k] = -result[k];
+      break;
+    case NOT:
+      for (k = 0; k < n; k++) result[k] = (result[k] == 0.0) ? 1.0 : 0.0;
+      break;
+    case SQRT:
+      for (k = 0; k < n; k++) {
+        if (result[k] < 0.0)
+          error->one(FLERR,"Sqrt of negative value in variable formula");
+        result[k] = sqrt(result[k]);
+      }
+      break;
+    case EXP:
+      for (k = 0; k < n; k++) result[k] = exp(result[k]);
+      break;
+    case LN:
+      for (k = 0; k < n; k++) {
+        if (result[k] <= 0.0)
+          error->one(FLERR,"Log of zero/negative value in variable formula");
+        result[k] = log(result[k]);
+      }
+      break;
+    case LOG:
+      for (k = 0; k < n; k++) {
+        if (result[k] <= 0.0)
+          error->one(FLERR,"Log of zero/negative value in variable formula");
+        result[k] = log10(result[k]);
+      }
+      break;
+    case ABS:
+      for (k = 0; k < n; k++) result[k] = fabs(result[k]);
+      break;
+    case SIN:
+      for (k = 0; k < n; k++) result[k] = sin(result[k]);
+      break;
+    case COS:
+      for (k = 0; k < n; k++) result[k] = cos(result[k]);
+      break;
+    case TAN:
+      for (k = 0; k < n; k++) result[k] = tan(result[k]);
+      break;
+    case ASIN:
+      for (k = 0; k < n; k++) {
+        if (result[k] < -1.0 || result[k] > 1.0)
+          error->one(FLERR,"Arcsin of invalid value in variable formula");
+        result[k] = asin(result[k]);
+      }
+      break;
+    case ACOS:
+      for (k = 0; k < n; k++) {
+        if (result[k] < -1.0 || result[k] > 1.0)
+          error->one(FLERR,"Arccos of invalid value in variable formula");
+        result[k] = acos(result[k]);
+      }
+      break;
+    case ATAN:
+      for (k = 0; k < n; k++) result[k] = atan(result[k]);
+      break;
+    case CEIL:
+      for (k = 0; k < n; k++) result[k] = ceil(result[k]);
+      break;
+    case FLOOR:
+      for (k = 0; k < n; k++) result[k] = floor(result[k]);
+      break;
+    case ROUND:
+      for (k = 0; k < n; k++) {
+        arg1 = result[k];
+        result[k] = MYROUND(arg1);
+      }
+      break;
+    }
+    return;
+  }
+
+  // everything else per atom
+
+  for (k = 0; k < n; k++) result[k] = eval_tree(tree,ilist[k]);
+}
+
+/* ----------------------------------------------------------------------
+   push a leaf for a time-dependent value onto the tree stack
+   only used when parsing an equal-style formula to a tree
+   type = CSCALAR,CVECTOR,CARRAY,FSCALAR,FVECTOR,FARRAY with compute or
+     fix id and its index, index1,index2 = vector/array indices
+   type = EQUALVAR with index of the equal-style variable
+------------------------------------------------------------------------- */
+
+void Variable::tree_leaf(int type, char *id, int index, int index1, int index2,
+                         Tree **treestack, int &ntreestack)
+{
+  Tree *newtree = new Tree();
+  newtree->type = type;
+  if (id) {
+    newtree->id = new char[strlen(id)+1];
+    strcpy(newtree->id,id);
+  }
+  newtree->index = index;
+  newtree->ivalue1 = index1;
+  newtree->ivalue2 = index2;
+  newtree->left = newtree->middle = newtree->right = NULL;
+  treestack[ntreestack++] = newtree;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate a leaf created by tree_leaf()
+   the compute or fix is looked up by ID again only if its cached index
+   is stale, i.e. computes or fixes were added or deleted since parsing
+------------------------------------------------------------------------- */
+
+double Variable::eval_leaf(Tree *tree)
+{
+  if (tree->type == EQUALVAR) {
+    if (eval_in_progress[tree->index])
+      error->all(FLERR,"Variable has circular dependency");
+
+    // same precision as a reference via retrieve()
+
+    char result[64];
+    sprintf(result,"%.15g",compute_equal(tree->index));
+    return atof(result);
+  }
+
+  if (tree->type <= CARRAY) {
+    if (tree->index >= modify->ncompute ||
+        strcmp(modify->compute[tree->index]->id,tree->id) != 0) {
+      tree->index = modify->find_compute(tree->id);
+      if (tree->index < 0)
+        error->all(FLERR,"Invalid compute ID in variable formula");
+    }
+    return compute_global(modify->compute[tree->index],tree->type-CSCALAR,
+                          tree->ivalue1,tree->ivalue2);
+  }
+
+  if (tree->index >= modify->nfix ||
+      strcmp(modify->fix[tree->index]->id,tree->id) != 0) {
+    tree->index = modify->find_fix(tree->id);
+    if (tree->index < 0) error->all(FLERR,"Invalid fix ID in variable formula");
+  }
+  return fix_global(modify->fix[tree->index],tree->type-FSCALAR,
+                    tree->ivalue1,tree->ivalue2);
+}
+
+/* ----------------------------------------------------------------------
+   global scalar (nbracket = 0), vector element (1) or array element (2)
+   of a compute, invoke the compute if needed
+------------------------------------------------------------------------- */
+
+double Variable::compute_global(Compute *compute, int nbracket,
+                                int index1, int index2)
+{
+  if (nbracket == 0) {
+    if (!compute->scalar_flag)
+      error->all(FLERR,"Mismatched compute in variable formula");
+    if (update->whichflag == 0) {
+      if (compute->invoked_scalar != update->ntimestep)
+        error->all(FLERR,"Compute used in variable between runs "
+                   "is not current. Use the update_on_run_end option for computes to avoid this.");
+    } else if (!(compute->invoked_flag & INVOKED_SCALAR)) {
+      compute->compute_scalar();
+      compute->invoked_flag |= INVOKED_SCALAR;
+    }
+    return compute->scalar;
+  }
+
+  if (nbracket == 1) {
+    if (!compute->vector_flag)
+      error->all(FLERR,"Mismatched compute in variable formula");
+    if (index1 > compute->size_vector)
+      error->all(FLERR,"Variable formula compute vector "
+                 "is accessed out-of-range");
+    if (update->whichflag == 0) {
+      if (compute->invoked_vector != update->ntimestep)
+        error->all(FLERR,"Compute used in variable between runs "
+                   "is not current. Use the update_on_run_end option for computes to avoid this.");
+    } else if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+      compute->compute_vector();
+      compute->invoked_flag |= INVOKED_VECTOR;
+    }
+    return compute->vector[index1-1];
+  }
+
+  if (!compute->array_flag)
+    error->all(FLERR,"Mismatched compute in variable formula");
+  if (index1 > compute->size_array_rows)
+    error->all(FLERR,"Variable formula compute array "
+               "is accessed out-of-range");
+  if (index2 > compute->size_array_cols)
+    error->all(FLERR,"Variable formula compute array "
+               "is accessed out-of-range");
+  if (update->whichflag == 0) {
+    if (compute->invoked_array != update->ntimestep)
+      error->all(FLERR,"Compute used in variable between runs "
+                 "is not current. Use the update_on_run_end option for computes to avoid this.");
+  } else if (!(compute->invoked_flag & INVOKED_ARRAY)) {
+    compute->compute_array();
+    compute->invoked_flag |= INVOKED_ARRAY;
+  }
+  return compute->array[index1-1][index2-1];
+}
+
+/* ----------------------------------------------------------------------
+   global scalar (nbracket = 0), vector element (1) or array element (2)
+   of a fix
+------------------------------------------------------------------------- */
+
+double Variable::fix_global(Fix *fix, int nbracket, int index1, int index2)
+{
+  if ((nbracket == 0 && !fix->scalar_flag) ||
+      (nbracket == 1 && !fix->vector_flag) ||
+      (nbracket == 2 && !fix->array_flag))
+    error->all(FLERR,"Mismatched fix in variable formula");
+  if (nbracket == 1 && index1 > fix->size_vector)
+    error->all(FLERR,
+               "Variable formula fix vector is accessed out-of-range");
+  if (nbracket == 2 && (index1 > fix->size_array_rows ||
+                        index2 > fix->size_array_cols))
+    error->all(FLERR,
+               "Variable formula fix array is accessed out-of-range");
+  if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+    error->all(FLERR,"Fix in variable not computed at compatible time");
+
+  if (nbracket == 0) return fix->compute_scalar();
+  if (nbracket == 1) return fix->compute_vector(index1-1);
+  return fix->compute_array(index1-1,index2-1);
+}
+
+/* ----------------------------------------------------------------------
+   return # of levels of tree
+------------------------------------------------------------------------- */
+
+int Variable::tree_depth(Tree *tree)
+{
+  int depth = 0;
+  if (tree->left) depth = MAX(depth,tree_depth(tree->left));
+  if (tree->middle) depth = MAX(depth,tree_depth(tree->middle));
+  if (tree->right) depth = MAX(depth,tree_depth(tree->right));
+  return depth+1;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if tree contains a random number generator
+   these must be evaluated atom by atom to keep the sequence of draws
+------------------------------------------------------------------------- */
+
+int Variable::tree_has_random(Tree *tree)
+{
+  if (tree->type == RANDOM || tree->type == NORMAL) return 1;
+  if (tree->left && tree_has_random(tree->left)) return 1;
+  if (tree->middle && tree_has_random(tree->middle)) return 1;
+  if (tree->right && tree_has_random(tree->right)) return 1;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if evaluation of tree can raise an error for some atom
+   used to keep short-circuit evaluation of && and ||
+------------------------------------------------------------------------- */
+
+int Variable::tree_can_fail(Tree *tree)
+{
+  int type = tree->type;
+  if (type == DIVIDE || type == MODULO || type == CARAT ||
+      type == SQRT || type == LN || type == LOG ||
+      type == ASIN || type == ACOS || type == RANDOM || type == NORMAL ||
+      type == STAGGER || type == LOGFREQ || type == STRIDE ||
+      type == SWIGGLE || type == CWIGGLE) return 1;
+  if (tree->left && tree_can_fail(tree->left)) return 1;
+  if (tree->middle && tree_can_fail(tree->middle)) return 1;
+  if (tree->right && tree_can_fail(tree->right)) return 1;
+  return 0;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Variable::free_tree(Tree *tree)
@@ -2401,6 +2868,7 @@ void Variable::free_tree(Tree *tree)
 
   if (tree->type == ATOMARRAY && tree->selfalloc)
     memory->destroy(tree->array);
+  delete [] tree->id;
 
   delete tree;
 }
@@ -2465,6 +2933,24 @@ int Variable::int_between_brackets(char *&ptr)
   return index;
 }
 
+/* ----------------------------------------------------------------------
+   return 1 if word is a math function whose value only depends on
+   its arguments, 0 for the timestep-dependent and random functions
+------------------------------------------------------------------------- */
+
+int Variable::static_math_function(char *word)
+{
+  if (strcmp(word,"sqrt") == 0 || strcmp(word,"exp") == 0 ||
+      strcmp(word,"ln") == 0 || strcmp(word,"log") == 0 ||
+      strcmp(word,"abs") == 0 ||
+      strcmp(word,"sin") == 0 || strcmp(word,"cos") == 0 ||
+      strcmp(word,"tan") == 0 || strcmp(word,"asin") == 0 ||
+      strcmp(word,"acos") == 0 || strcmp(word,"atan") == 0 ||
+      strcmp(word,"atan2") == 0 || strcmp(word,"ceil") == 0 ||
+      strcmp(word,"floor") == 0 || strcmp(word,"round") == 0) return 1;
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    process a math function in formula
    push result onto tree or arg stack
@@ -3428,6 +3914,10 @@ void Variable::peratom2global(int flag, char *word,
                               Tree **tree, Tree **treestack, int &ntreestack,
                               double *argstack, int &nargstack)
 {
+  // the value is reduced over procs at parse time, it can not be a tree leaf
+
+  eval_notree = 1;
+
   if (atom->map_style == 0)
     error->all(FLERR,
                "Indexed per-atom vector in variable formula without atom map");
@@ -87,6 +87,15 @@ class Variable : protected Pointers {
 
   int *eval_in_progress;   // flag if evaluation of variable is in progress
 
+  double *eqcache;         // cached value of static equal-style variables
+  int *eqcache_stamp;      // generation eqcache was computed at, -1 if none
+  int generation;          // incremented when any variable changes
+  int eval_dynamic;        // 1 if evaluation used time-dependent items
+
+  int *vlist;              // local atoms an atom-style variable is evaluated on
+  double **vbuf;           // per tree level buffers for eval_tree_vector()
+  int maxvlist,nvbuf;      // allocated length and # of levels of vbuf
+
   class RanMars *randomequal;   // random number generator for equal-style vars
   class RanMars *randomatom;    // random number generator for atom-style vars
 
@@ -102,17 +111,33 @@ class Variable : protected Pointers {
     int nstride;           // stride between atoms if array is a 2d array
     int selfalloc;         // 1 if array is allocated here, else 0
     int ivalue1,ivalue2;   // extra values for needed for gmask,rmask,grmask
+    char *id;              // compute or fix ID of a global value
+    int index;             // cached index of that compute or fix
     Tree *left,*middle,*right;    // ptrs further down tree
   };
 
+  Tree **eqtree;           // parse tree of dynamic equal-style variables
+  int *eqtree_stamp;       // generation eqtree is valid for, -1 if none
+  int eval_notree;         // 1 if evaluation used items a tree can not hold
+  int eval_compile;        // 1 while parsing an equal-style formula to a tree
+
   void remove(int);
   void grow();
   void copy(int, char **, char **);
   double evaluate(char *, Tree **);
   double collapse_tree(Tree *);
   double eval_tree(Tree *, int);
+  double eval_leaf(Tree *);
+  void tree_leaf(int, char *, int, int, int, Tree **, int &);
+  double compute_global(class Compute *, int, int, int);
+  double fix_global(class Fix *, int, int, int);
+  void eval_tree_vector(Tree *, int, int *, double *, int);
+  int tree_depth(Tree *);
+  int tree_has_random(Tree *);
+  int tree_can_fail(Tree *);
   void free_tree(Tree *);
   int find_matching_paren(char *, int, char *&);
+  int static_math_function(char *);
   int math_function(char *, char *, Tree **, Tree **, int &, double *, int &);
   int group_function(char *, char *, Tree **, Tree **, int &, double *, int &);
   int region_function(char *);
@@ -52,6 +52,7 @@
 #include "lmptype.h"
 #include <mpi.h>
 #include <string.h>
+#include <stdlib.h>
 #include "write_restart.h"
 #include "atom.h"
 #include "atom_vec.h"
@@ -75,7 +76,8 @@
 #include "thermo.h"
 #include "memory.h"
 #include "error.h"
-#if !defined(WINDOWS) && !defined(__MINGW32__)
+#include "restart_mpiio.h"
+#if !defined(_WINDOWS) && !defined(__MINGW32__)
 #include <sys/stat.h>
 #endif
 
@@ -109,6 +111,42 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Pointers(lmp)
   MPI_Comm_size(world,&nprocs);
 
   region = NULL; 
+
+  asyncflag = 0;
+  async_maxbytes = 0;
+  npending = 0;
+  async_failed = -1;
+#ifdef LMP_ASYNC_RESTART
+  thread_active = 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+WriteRestart::~WriteRestart()
+{
+  // must not abort during teardown, a failed write is only a warning here
+  // it was already reported as error if the run ended regularly
+
+  char str[512];
+  if (join(str)) error->warning(FLERR,str);
+}
+
+/* ----------------------------------------------------------------------
+   enable/disable writing restart files in background
+   maxmb = max MB of per-atom data a proc may hold, larger files are
+   written synchronously
+------------------------------------------------------------------------- */
+
+void WriteRestart::set_async(int flag, double maxmb)
+{
+#ifndef LMP_ASYNC_RESTART
+  if (flag)
+    error->all(FLERR,"Asynchronous restart files are not supported on this platform");
+#endif
+  wait();
+  asyncflag = flag;
+  async_maxbytes = static_cast<bigint> (maxmb*1024.0*1024.0);
 }
 
 /* ----------------------------------------------------------------------
@@ -198,6 +236,10 @@ void WriteRestart::command(int narg, char **arg)
 
 void WriteRestart::write(char *file)
 {
+  // previous background write must be complete before next one starts
+
+  wait();
+
   // special case where reneighboring is not done in integrator
   //   on timestep restart file is written (due to build_once being set)
   // if box is changing, must be reset, else restart file will have
@@ -230,6 +272,26 @@ void WriteRestart::write(char *file)
   if (strchr(file,'%')) multiproc = 1;
   else multiproc = 0;
 
+  // single file ending in ".mpiio" is written in parallel via MPI-IO
+
+  int mpiio = 0;
+  if (!multiproc && RestartMPIIO::is_mpiio(file)) mpiio = 1;
+
+  // async = 1 if this proc assembles its file(s) in memory
+  // not for MPI-IO files, since collective write must be done by all procs
+  // single file is assembled on proc 0, so it must hold all atoms
+
+  int async = 0;
+  if (asyncflag && !mpiio) {
+    bigint nbytes = atom->avec->size_restart() * sizeof(double);
+    if (!multiproc) {
+      bigint nbytes_all;
+      MPI_Allreduce(&nbytes,&nbytes_all,1,MPI_LMP_BIGINT,MPI_SUM,world);
+      nbytes = nbytes_all;
+    }
+    if (nbytes <= async_maxbytes) async = 1;
+  }
+
   // open single restart file or base file for multiproc case
 
   if (me == 0) {
@@ -241,7 +303,7 @@ void WriteRestart::write(char *file)
       sprintf(hfile,"%s%s%s",file,"base",ptr+1);
       *ptr = '%';
     } else hfile = file;
-    fp = fopen(hfile,"wb");
+    fp = open_file(hfile,async);
     if (fp == NULL) {
       char str[512];
       sprintf(str,"Cannot open restart file %s",hfile);
@@ -343,14 +405,20 @@ void WriteRestart::write(char *file)
     }
   }
 
-  // if single file:
+  // if MPI-IO file:
+  //   proc 0 writes index of chunk sizes and bounding boxes
+  //   all procs write their chunk collectively at their own offset
+  // else if single file:
   //   write one chunk of atoms per proc to file
   //   proc 0 pings each proc, receives its chunk, writes to file
   //   all other procs wait for ping, send their chunk to proc 0
   // else if one file per proc:
   //   each proc opens its own file and writes its chunk directly
 
-  if (multiproc == 0) {
+  if (mpiio) {
+    RestartMPIIO(lmp).write(fp,file,buf,send_size);
+
+  } else if (multiproc == 0) {
     int tmp,recv_size;
     MPI_Status status;
     MPI_Request request;
@@ -383,7 +451,7 @@ void WriteRestart::write(char *file)
     *ptr = '\0';
     sprintf(perproc,"%s%d%s",file,me,ptr+1);
     *ptr = '%';
-    fp = fopen(perproc,"wb");
+    fp = open_file(perproc,async);
     if (fp == NULL) {
       char str[512];
       sprintf(str,"Cannot open restart file %s",perproc);
@@ -397,6 +465,16 @@ void WriteRestart::write(char *file)
 
   memory->destroy(buf);
 
+  // hand files assembled in memory to background thread
+
+#ifdef LMP_ASYNC_RESTART
+  if (npending) {
+    if (pthread_create(&thread,NULL,&WriteRestart::write_pending,this) != 0)
+      error->one(FLERR,"Cannot start thread for asynchronous restart");
+    thread_active = 1;
+  }
+#endif
+
   // invoke any fixes that write their own restart file
 
   for (int ifix = 0; ifix < modify->nfix; ifix++)
@@ -404,6 +482,94 @@ void WriteRestart::write(char *file)
       modify->fix[ifix]->write_restart_file(file);
 }
 
+/* ----------------------------------------------------------------------
+   open file for writing
+   if async, file is a memory stream that is written to disk later
+------------------------------------------------------------------------- */
+
+FILE *WriteRestart::open_file(const char *name, int async)
+{
+#ifdef LMP_ASYNC_RESTART
+  if (async) {
+    AsyncFile &f = pending[npending++];
+    f.name = new char[strlen(name)+1];
+    strcpy(f.name,name);
+    f.bytes = NULL;
+    f.nbytes = 0;
+    return open_memstream(&f.bytes,&f.nbytes);
+  }
+#endif
+  return fopen(name,"wb");
+}
+
+/* ----------------------------------------------------------------------
+   wait for background thread, error if it failed to write a file
+   called at the next restart and at the end of a run/minimize
+------------------------------------------------------------------------- */
+
+void WriteRestart::wait()
+{
+  char str[512];
+  if (join(str)) error->one(FLERR,str);
+}
+
+/* ----------------------------------------------------------------------
+   join background thread, free memory of files it has written
+   return 1 and message in str if a file could not be written
+------------------------------------------------------------------------- */
+
+int WriteRestart::join(char *str)
+{
+  str[0] = '\0';
+
+#ifdef LMP_ASYNC_RESTART
+  if (thread_active) {
+    pthread_join(thread,NULL);
+    thread_active = 0;
+  }
+
+  if (async_failed >= 0)
+    snprintf(str,512,"Cannot write restart file %s",
+             pending[async_failed].name);
+
+  for (int i = 0; i < npending; i++) {
+    delete [] pending[i].name;
+    free(pending[i].bytes);
+  }
+  npending = 0;
+  async_failed = -1;
+#endif
+
+  return str[0] ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------------
+   executed by background thread, must not call MPI or error
+------------------------------------------------------------------------- */
+
+#ifdef LMP_ASYNC_RESTART
+void *WriteRestart::write_pending(void *ptr)
+{
+  WriteRestart *wr = static_cast<WriteRestart *>(ptr);
+
+  for (int i = 0; i < wr->npending; i++) {
+    AsyncFile &f = wr->pending[i];
+    FILE *out = fopen(f.name,"wb");
+    if (out == NULL || fwrite(f.bytes,1,f.nbytes,out) != f.nbytes) {
+      wr->async_failed = i;
+      if (out) fclose(out);
+      break;
+    }
+    if (fclose(out) != 0) {
+      wr->async_failed = i;
+      break;
+    }
+  }
+
+  return NULL;
+}
+#endif
+
 /* ----------------------------------------------------------------------
    proc 0 writes out problem description
 ------------------------------------------------------------------------- */
@@ -61,14 +61,23 @@ CommandStyle(write_restart,WriteRestart)
 #include <stdio.h>
 #include "pointers.h"
 
+#if !defined(_WINDOWS) && !defined(__MINGW32__)
+#define LMP_ASYNC_RESTART
+#include <pthread.h>
+#endif
+
 namespace LAMMPS_NS {
 
 class WriteRestart : protected Pointers {
  public:
   WriteRestart(class LAMMPS *);
+  ~WriteRestart();
   void command(int, char **);
   void write(char *);
 
+  void set_async(int, double);
+  void wait();           // block until background write is complete
+
  private:
   int me,nprocs;
   FILE *fp;
@@ -76,6 +85,29 @@ class WriteRestart : protected Pointers {
 
   class Region *region;
 
+  // asynchronous write: files are assembled in memory at the
+  // time of the write and flushed to disk by a background thread
+
+  struct AsyncFile {
+    char *name;
+    char *bytes;
+    size_t nbytes;
+  };
+
+  int asyncflag;         // 1 if files may be written in background
+  bigint async_maxbytes; // max per-atom bytes a proc may hold in memory
+  int npending;          // # of files held in memory, at most 2 per proc
+  AsyncFile pending[2];
+  int async_failed;      // index of file that could not be written, or -1
+#ifdef LMP_ASYNC_RESTART
+  int thread_active;
+  pthread_t thread;
+  static void *write_pending(void *);
+#endif
+
+  FILE *open_file(const char *, int);
+  int join(char *);      // finish background write, 1 if it failed
+
   void header();
   void type_arrays();
   void force_fields();
@@ -113,4 +145,22 @@ E: Cannot open restart file %s
 
 Self-explanatory.
 
+E: Cannot write restart file %s
+
+The background thread of an asynchronous restart could not write
+the file, e.g. because the disk is full.
+
+W: Cannot write restart file %s
+
+As the error above, but detected only while LIGGGHTS(R)-PUBLIC shuts
+down, e.g. after an error elsewhere, so it is reported as a warning.
+
+E: Cannot start thread for asynchronous restart
+
+The operating system refused to create the I/O thread.
+
+E: Asynchronous restart files are not supported on this platform
+
+The async option of the restart command requires POSIX threads.
+
 */